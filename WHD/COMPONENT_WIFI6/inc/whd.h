@@ -46,6 +46,13 @@ typedef struct whd_bt_dev *whd_bt_dev_t;
  */
 typedef struct whd_interface *whd_interface_t;
 
+/**
+ * Delivers the response of an IOCTL/IOVAR sent without waiting for it, called from the WHD thread.
+ * data is only valid during the call and is NULL unless result is WHD_SUCCESS.
+ */
+typedef void (*whd_ioctl_async_callback_t)(whd_interface_t ifp, whd_result_t result, const uint8_t *data,
+                                           uint32_t data_length, void *user_data);
+
 /**
  * Abstract type that acts as a handle to an instance of a buffer function
  */
@@ -80,6 +87,13 @@ typedef struct whd_init_config
     uint32_t thread_stack_size; /**< Size of the WHD thread stack  */
     uint32_t thread_priority;   /**< Priority to be set to WHD Thread */
     whd_country_code_t country; /**< Variable to strore country code information */
+    uint8_t tx_glom_max_frames; /**< Maximum number of frames aggregated into one SDPCM TX superframe (SDIO only).
+                                     0 or 1 keeps TX glomming disabled */
+    whd_tx_sched_mode_t tx_sched_mode; /**< Scheduling policy across the WMM AC TX queues (SDPCM only) */
+    uint16_t tx_sched_weight[WHD_TX_SCHED_NUM_AC]; /**< DRR quantum in bytes per round for BK, BE, VI and VO.
+                                                        0 uses WHD_LINK_MTU */
+    uint16_t rx_poll_budget;    /**< Upper bound of the adaptive number of packets read per RX poll round with bus
+                                     interrupts masked (SDPCM only). 0 keeps interrupt driven RX with a fixed bound */
 } whd_init_config_t;
 
 #ifdef __cplusplus
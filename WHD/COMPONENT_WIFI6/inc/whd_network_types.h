@@ -159,6 +159,19 @@ struct whd_buffer_funcs
      *  @return                   WHD_SUCCESS or error code
      */
     whd_result_t (*whd_buffer_add_remove_at_front)(whd_buffer_t *buffer, int32_t add_remove_amount);
+
+    /** Retrieves the alignment guaranteed for packet buffers
+     *
+     *  Optional, may be NULL. By returning a power of two N the port layer guarantees that the
+     *  current pointer of every buffer allocated by whd_host_buffer_get() is N byte aligned, and that
+     *  the memory of the buffer is padded to a multiple of N bytes so no other data shares its last
+     *  N byte block. WHD then lays received frames out so that bus reads land on an N byte boundary.
+     *  On cores with a data cache, an N that is a multiple of the cache line size lets SDIO reads DMA
+     *  straight into packet buffers instead of through a bounce buffer.
+     *
+     *  @return        The alignment in bytes, 0 if none is guaranteed
+     */
+    uint32_t (*whd_buffer_get_alignment)(void);
 };
 /*  @} */
 
@@ -200,8 +213,29 @@ struct whd_netif_funcs
      *
      */
     void (*whd_network_process_ethernet_data)(whd_interface_t ifp, whd_buffer_t buffer);
+
+    /** Called by WHD when the network stack may resume sending
+     *
+     *  Optional, may be NULL. Called in the context of the WHD thread, for every interface, once
+     *  the TX queues which went over their byte limit have drained below it, see
+     *  @ref whd_network_tx_flow_controlled. It must not block nor send packets itself.
+     *
+     *  @param interface  The interface on which sending may resume.
+     */
+    void (*whd_network_tx_resume)(whd_interface_t ifp);
 };
 
+/** To check whether the network stack should hold off sending (called by the Network Stack)
+ *
+ *  A TX queue which reaches its byte limit still accepts packets, but the stack should stop sending
+ *  until the whd_network_tx_resume callback of @ref whd_netif_funcs is called.
+ *
+ *  @param ifp           Pointer to handle instance of whd interface
+ *
+ *  @return WHD_TRUE while a TX queue is at or over its byte limit, WHD_FALSE otherwise
+ */
+extern whd_bool_t whd_network_tx_flow_controlled(whd_interface_t ifp);
+
 /** To send an ethernet frame to WHD (called by the Network Stack)
  *
  *  This function takes ethernet data from the network stack and queues it for transmission over the wireless network.
@@ -220,6 +254,23 @@ struct whd_netif_funcs
  *
  */
 extern whd_result_t whd_network_send_ethernet_data(whd_interface_t ifp, whd_buffer_t buffer);
+
+/** To send a burst of ethernet frames to WHD (called by the Network Stack)
+ *
+ *  Same as @ref whd_network_send_ethernet_data for every buffer, but the header setup, queueing
+ *  and wake up of the WHD thread are done once for the whole burst instead of once per packet.
+ *  The frames are sent in array order within each priority.
+ *
+ *  @param ifp           Pointer to handle instance of whd interface
+ *  @param buffers       Handles of the packet buffers to be sent, all are handed over to WHD.
+ *  @param count         Number of buffers.
+ *
+ *  @return WHD_SUCCESS or the first Error code met. Buffers that failed are released by WHD
+ *          as with @ref whd_network_send_ethernet_data.
+ *
+ */
+extern whd_result_t whd_network_send_ethernet_data_batch(whd_interface_t ifp, const whd_buffer_t *buffers,
+                                                         uint32_t count);
 /*  @} */
 
 
@@ -140,6 +140,23 @@ struct whd_resource_source
      */
     uint32_t (*whd_resource_read)(whd_driver_t whd_drv, whd_resource_type_t type,
                                   uint32_t offset, uint32_t size, uint32_t *size_out, void *buffer);
+
+    /** Gets the whole resource when it is mapped in memory, optional
+     *
+     *  The driver then writes the firmware to the WLAN chip straight from this memory, without copying it
+     *  into packet buffers. Leave NULL, or return an error, to have the firmware read block by block.
+     *  Only called for WHD_RESOURCE_WLAN_FIRMWARE.
+     *
+     *  @param whd_drv     Pointer to handle instance of the driver
+     *  @param type        Type of resource - WHD_RESOURCE_WLAN_FIRMWARE
+     *  @param data        Pointer to the resource, must stay valid and unchanged while the driver is attached
+     *  @param size_out    Size of the resource
+     *
+     *  @return            WHD_SUCCESS or error code
+     *
+     */
+    uint32_t (*whd_get_resource_direct)(whd_driver_t whd_drv, whd_resource_type_t type, const uint8_t **data,
+                                        uint32_t *size_out);
 };
 
 /** @} */
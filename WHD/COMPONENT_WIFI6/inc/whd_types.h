@@ -285,6 +285,21 @@ typedef enum
 } whd_bool_t;
 #endif
 
+/**
+ * Scheduling policy used to pick the next WMM AC queue for transmission.
+ * The control queue (IOCTL/IOVAR) is always served first.
+ */
+typedef enum
+{
+    WHD_TX_SCHED_STRICT_PRIORITY = 0, /**< Serve the highest priority non-empty AC (VO, VI, BE, BK) */
+    WHD_TX_SCHED_DRR             = 1  /**< Deficit round robin by bytes across ACs, weighted per AC */
+} whd_tx_sched_mode_t;
+
+/**
+ * Number of WMM Access Categories
+ */
+#define WHD_TX_SCHED_NUM_AC (4)
+
 /**
  * Transfer direction for the WHD platform bus interface
  */
@@ -1378,6 +1393,10 @@ typedef struct whd_sdio_config
     whd_bool_t sdio_1bit_mode;        /**< Default is false, means SDIO operates under 4 bit mode */
     whd_bool_t high_speed_sdio_clock; /**< Default is false, means SDIO operates in normal clock rate */
     whd_oob_config_t oob_config;      /**< Out-of-band interrupt configuration (required when bus can sleep) */
+    uint16_t sdio_block_size;         /**< Block size the SDIO host controller is configured for, a power of two
+                                           up to 512 bytes. Used for F1 and F2. 0 uses 64 bytes */
+    uint16_t sdio_max_block_count;    /**< Largest block count of one CMD53 the SDIO host controller allows,
+                                           0 uses 511 (the CMD53 maximum) */
 } whd_sdio_config_t;
 
 /**
@@ -1577,6 +1577,58 @@ extern whd_result_t whd_wifi_get_ioctl_buffer(whd_interface_t ifp, uint32_t ioct
 extern whd_result_t whd_wifi_get_iovar_buffer_with_param(whd_interface_t ifp, const char *iovar_name, void *param,
                                                      uint32_t paramlen, uint8_t *out_buffer, uint32_t out_length);
 
+/** Sends an IOVAR command - SET, without waiting for the response
+ *
+ *  Unless an error is returned, callback runs exactly once from the WHD thread, with WHD_TIMEOUT if no
+ *  response arrived in time, unless the request is cancelled first. It may run before this function returns.
+ *  The callback must not call functions which wait for the WLAN firmware.
+ *
+ *  @param  ifp               Pointer to handle instance of whd interface
+ *  @param  iovar_name        IOVAR name
+ *  @param  in_buffer         Data to set
+ *  @param  in_buffer_length  Length of in_buffer
+ *  @param  timeout_ms        Time to wait for the response, 0 for the driver default
+ *  @param  callback          Receives the result
+ *  @param  user_data         Passed to callback
+ *  @param  request           Receives the handle for @ref whd_wifi_cancel_iovar_async, may be NULL
+ *
+ *  @return WHD_SUCCESS once sent, WHD_WLAN_BUSY if no more IOVARs can be outstanding, or Error code
+ */
+extern whd_result_t whd_wifi_set_iovar_buffer_async(whd_interface_t ifp, const char *iovar_name, const void *in_buffer,
+                                                    uint16_t in_buffer_length, uint32_t timeout_ms,
+                                                    whd_ioctl_async_callback_t callback, void *user_data,
+                                                    uint16_t *request);
+
+/** Sends an IOVAR command - GET, without waiting for the response
+ *
+ *  The response data goes to callback, see @ref whd_wifi_set_iovar_buffer_async.
+ *
+ *  @param  ifp               Pointer to handle instance of whd interface
+ *  @param  iovar_name        IOVAR name
+ *  @param  param             Paramater to be passed for the IOVAR, may be NULL
+ *  @param  paramlen          Paramter length
+ *  @param  out_length        Length of the response data expected
+ *  @param  timeout_ms        Time to wait for the response, 0 for the driver default
+ *  @param  callback          Receives the result and response data
+ *  @param  user_data         Passed to callback
+ *  @param  request           Receives the handle for @ref whd_wifi_cancel_iovar_async, may be NULL
+ *
+ *  @return WHD_SUCCESS once sent, WHD_WLAN_BUSY if no more IOVARs can be outstanding, or Error code
+ */
+extern whd_result_t whd_wifi_get_iovar_buffer_async(whd_interface_t ifp, const char *iovar_name, const void *param,
+                                                    uint16_t paramlen, uint16_t out_length, uint32_t timeout_ms,
+                                                    whd_ioctl_async_callback_t callback, void *user_data,
+                                                    uint16_t *request);
+
+/** Cancels an IOVAR sent with @ref whd_wifi_set_iovar_buffer_async or @ref whd_wifi_get_iovar_buffer_async
+ *
+ *  @param  ifp               Pointer to handle instance of whd interface
+ *  @param  request           Handle of the request
+ *
+ *  @return WHD_SUCCESS if its callback will not run, WHD_DOES_NOT_EXIST if it already ran or is running
+ */
+extern whd_result_t whd_wifi_cancel_iovar_async(whd_interface_t ifp, uint16_t request);
+
 /** Fetches ulp statistics and fills the buffer with that data and executes deepsleep
  *  indication callback if application registers for it
  *
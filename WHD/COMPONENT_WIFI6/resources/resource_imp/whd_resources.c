@@ -70,6 +70,8 @@ resource_result_t resource_read(const resource_hnd_t *resource, uint32_t offset,
                                 void *buffer);
 whd_result_t host_resource_read(whd_driver_t whd_drv, whd_resource_type_t type,
                             uint32_t offset, uint32_t size, uint32_t *size_out, void *buffer);
+whd_result_t host_get_resource_direct(whd_driver_t whd_drv, whd_resource_type_t type, const uint8_t **data,
+                                      uint32_t *size_out);
 /******************************************************
 *               Variable Definitions
 ******************************************************/
@@ -380,11 +382,33 @@ whd_result_t host_resource_read(whd_driver_t whd_drv, whd_resource_type_t type,
     return WHD_SUCCESS;
 }
 
+whd_result_t host_get_resource_direct(whd_driver_t whd_drv, whd_resource_type_t type, const uint8_t **data,
+                                      uint32_t *size_out)
+{
+#if defined(NO_WIFI_FIRMWARE) || defined(WIFI_FIRMWARE_IN_MULTI_APP)
+    return WHD_UNSUPPORTED;
+#else
+    const resource_hnd_t *resource = &wifi_firmware_image;
+
+    /* Only the firmware is downloaded to the chip memory, CLM is sent with IOVARs */
+    if ( (type != WHD_RESOURCE_WLAN_FIRMWARE) || (resource->location != RESOURCE_IN_MEMORY) )
+    {
+        return WHD_UNSUPPORTED;
+    }
+
+    *data = (const uint8_t *)resource->val.mem.data;
+    *size_out = resource->size;
+
+    return WHD_SUCCESS;
+#endif
+}
+
 whd_resource_source_t resource_ops =
 {
     .whd_resource_size = host_platform_resource_size,
     .whd_get_resource_block_size = host_get_resource_block_size,
     .whd_get_resource_no_of_blocks = host_get_resource_no_of_blocks,
     .whd_get_resource_block = host_get_resource_block,
-    .whd_resource_read = host_resource_read
+    .whd_resource_read = host_resource_read,
+    .whd_get_resource_direct = host_get_resource_direct
 };
@@ -240,7 +240,7 @@ static whd_result_t whd_bus_oci_init(whd_driver_t whd_driver)
     cyhal_system_delay_ms(500);
 
     Chip_ID = whd_hw_readGciChipIdRegisterApi();
-    whd_chip_set_chip_id(whd_driver, Chip_ID);
+    CHECK_RETURN(whd_chip_set_chip_id(whd_driver, Chip_ID) );
 #endif
 
     /* Download wlan firmware */
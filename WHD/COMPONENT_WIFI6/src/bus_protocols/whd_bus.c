@@ -163,6 +163,119 @@ whd_result_t whd_bus_transfer_bytes(whd_driver_t whd_driver, whd_bus_transfer_di
     return whd_driver->bus_if->whd_bus_transfer_bytes_fptr(whd_driver, direction, function, address, size, data);
 }
 
+whd_result_t whd_bus_transfer_async(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
+                                    whd_bus_function_t function, uint32_t address, uint16_t size,
+                                    whd_transfer_bytes_packet_t *data,
+                                    whd_bus_transfer_complete_t complete, void *arg)
+{
+    whd_result_t result;
+
+    if (whd_driver->bus_if->whd_bus_transfer_async_fptr != NULL)
+    {
+        return whd_driver->bus_if->whd_bus_transfer_async_fptr(whd_driver, direction, function, address, size, data,
+                                                               complete, arg);
+    }
+
+    result = whd_driver->bus_if->whd_bus_transfer_bytes_fptr(whd_driver, direction, function, address, size, data);
+    complete(whd_driver, arg, result);
+
+    return WHD_SUCCESS;
+}
+
+static whd_result_t whd_bus_reg_batch_add(whd_bus_reg_batch_t *batch, whd_bus_reg_op_type_t type, uint32_t address,
+                                          uint8_t length, uint32_t value)
+{
+    whd_bus_reg_op_t *op;
+
+    if (batch->count >= WHD_BUS_REG_BATCH_MAX_OPS)
+    {
+        WPRINT_WHD_ERROR( ("%s: register batch is full\n", __FUNCTION__) );
+        return WHD_BADARG;
+    }
+
+    op = &batch->ops[batch->count++];
+    op->type = type;
+    op->address = address;
+    op->length = length;
+    op->value = value;
+
+    return WHD_SUCCESS;
+}
+
+void whd_bus_reg_batch_init(whd_bus_reg_batch_t *batch)
+{
+    batch->count = 0;
+}
+
+whd_result_t whd_bus_reg_batch_write(whd_bus_reg_batch_t *batch, uint32_t address, uint8_t length, uint32_t value)
+{
+    return whd_bus_reg_batch_add(batch, WHD_BUS_REG_OP_WRITE, address, length, value);
+}
+
+whd_result_t whd_bus_reg_batch_clear(whd_bus_reg_batch_t *batch, uint32_t address, uint8_t length, uint32_t bits)
+{
+    uint8_t i;
+
+    if (bits == 0)
+    {
+        return WHD_SUCCESS;
+    }
+
+    /* Clearing more bits costs nothing, the register only has to be written once */
+    for (i = batch->count; i > 0; i--)
+    {
+        if (batch->ops[i - 1].address == address)
+        {
+            if ( (batch->ops[i - 1].type == WHD_BUS_REG_OP_CLEAR) && (batch->ops[i - 1].length == length) )
+            {
+                batch->ops[i - 1].value |= bits;
+                return WHD_SUCCESS;
+            }
+            break;
+        }
+    }
+
+    return whd_bus_reg_batch_add(batch, WHD_BUS_REG_OP_CLEAR, address, length, bits);
+}
+
+whd_result_t whd_bus_reg_batch_execute(whd_driver_t whd_driver, whd_bus_reg_batch_t *batch)
+{
+    whd_result_t result = WHD_SUCCESS;
+    whd_bus_reg_op_t *op;
+    uint8_t i;
+
+    if (batch->count == 0)
+    {
+        return WHD_SUCCESS;
+    }
+
+    if (whd_driver->bus_if->whd_bus_reg_batch_execute_fptr != NULL)
+    {
+        result = whd_driver->bus_if->whd_bus_reg_batch_execute_fptr(whd_driver, batch);
+        batch->count = 0;
+        return result;
+    }
+
+    for (i = 0; (i < batch->count) && (result == WHD_SUCCESS); i++)
+    {
+        op = &batch->ops[i];
+        result = whd_bus_write_backplane_value(whd_driver, op->address, op->length, op->value);
+    }
+    batch->count = 0;
+
+    return result;
+}
+
+whd_result_t whd_bus_transfer_wait(whd_driver_t whd_driver)
+{
+    if (whd_driver->bus_if->whd_bus_transfer_wait_fptr == NULL)
+    {
+        return WHD_SUCCESS;
+    }
+
+    return whd_driver->bus_if->whd_bus_transfer_wait_fptr(whd_driver);
+}
+
 whd_result_t whd_bus_poke_wlan(whd_driver_t whd_driver)
 {
     return whd_driver->bus_if->whd_bus_poke_wlan_fptr(whd_driver);
@@ -198,6 +311,16 @@ uint32_t whd_bus_get_max_transfer_size(whd_driver_t whd_driver)
     return whd_driver->bus_if->whd_bus_get_max_transfer_size_fptr(whd_driver);
 }
 
+uint16_t whd_bus_get_block_size(whd_driver_t whd_driver)
+{
+    if (whd_driver->bus_if->whd_bus_get_block_size_fptr == NULL)
+    {
+        return 1;
+    }
+
+    return whd_driver->bus_if->whd_bus_get_block_size_fptr(whd_driver);
+}
+
 void whd_bus_init_stats(whd_driver_t whd_driver)
 {
     whd_driver->bus_if->whd_bus_init_stats_fptr(whd_driver);
@@ -53,6 +53,12 @@ typedef whd_result_t (*whd_bus_read_register_value_t)(whd_driver_t whd_driver, w
 typedef whd_result_t (*whd_bus_transfer_bytes_t)(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
                                                  whd_bus_function_t function, uint32_t address, uint16_t size,
                                                  whd_transfer_bytes_packet_t *data);
+typedef whd_result_t (*whd_bus_transfer_async_t)(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
+                                                 whd_bus_function_t function, uint32_t address, uint16_t size,
+                                                 whd_transfer_bytes_packet_t *data,
+                                                 whd_bus_transfer_complete_t complete, void *arg);
+typedef whd_result_t (*whd_bus_transfer_wait_t)(whd_driver_t whd_driver);
+typedef whd_result_t (*whd_bus_reg_batch_execute_t)(whd_driver_t whd_driver, whd_bus_reg_batch_t *batch);
 
 typedef whd_result_t (*whd_bus_poke_wlan_t)(whd_driver_t whd_driver);
 
@@ -64,6 +70,7 @@ typedef whd_result_t (*whd_bus_wait_for_wlan_event_t)(whd_driver_t whd_driver,
                                                       cy_semaphore_t *transceive_semaphore);
 typedef whd_bool_t (*whd_bus_use_status_report_scheme_t)(whd_driver_t whd_driver);
 typedef uint32_t (*whd_bus_get_max_transfer_size_t)(whd_driver_t whd_driver);
+typedef uint16_t (*whd_bus_get_block_size_t)(whd_driver_t whd_driver);
 
 typedef void (*whd_bus_init_stats_t)(whd_driver_t whd_driver);
 typedef whd_result_t (*whd_bus_print_stats_t)(whd_driver_t whd_driver, whd_bool_t reset_after_print);
@@ -94,8 +101,13 @@ typedef struct whd_bus_info
 
     whd_bus_write_register_value_t whd_bus_write_register_value_fptr;
     whd_bus_read_register_value_t whd_bus_read_register_value_fptr;
+    /* Optional, NULL to do one backplane access per queued operation */
+    whd_bus_reg_batch_execute_t whd_bus_reg_batch_execute_fptr;
 
     whd_bus_transfer_bytes_t whd_bus_transfer_bytes_fptr;
+    /* Optional, NULL when the bus has no asynchronous transfers */
+    whd_bus_transfer_async_t whd_bus_transfer_async_fptr;
+    whd_bus_transfer_wait_t whd_bus_transfer_wait_fptr;
 
     whd_bus_poke_wlan_t whd_bus_poke_wlan_fptr;
 
@@ -108,6 +120,8 @@ typedef struct whd_bus_info
     whd_bus_use_status_report_scheme_t whd_bus_use_status_report_scheme_fptr;
 
     whd_bus_get_max_transfer_size_t whd_bus_get_max_transfer_size_fptr;
+    /* Optional, NULL when the bus does not transfer in blocks */
+    whd_bus_get_block_size_t whd_bus_get_block_size_fptr;
 
     whd_bus_init_stats_t whd_bus_init_stats_fptr;
     whd_bus_print_stats_t whd_bus_print_stats_fptr;
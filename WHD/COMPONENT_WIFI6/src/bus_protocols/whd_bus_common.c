@@ -18,6 +18,7 @@
 /** @file
  *
  */
+#include <string.h>
 #include "cyabs_rtos.h"
 #include "whd_utils.h"
 
@@ -54,6 +55,16 @@
 
 #define WHD_BUS_WLAN_ALLOW_SLEEP_INVALID_MS  ( (uint32_t)-1 )
 
+/* Receive buffers kept by the driver so that the read path does not have to allocate */
+#ifndef WHD_BUS_RX_RING_SIZE
+#define WHD_BUS_RX_RING_SIZE                    (8)
+#endif
+#define WHD_BUS_RX_RING_LOW_WATERMARK           (WHD_BUS_RX_RING_SIZE / 4)
+#define WHD_BUS_RX_RING_BUFFER_SIZE             (WHD_LINK_MTU)
+
+/* Differs from every window base in all three window registers, so the next access writes them all */
+#define WHD_BUS_BACKPLANE_WINDOW_INVALID        (0xFFFFFFFF)
+
 /******************************************************
 *             Structures
 ******************************************************/
@@ -70,6 +81,12 @@ struct whd_bus_common_info
     uint32_t backplane_window_current_base_address;
     whd_bool_t bus_flow_control;
     volatile whd_bool_t resource_download_abort;
+
+    /* RX buffer ring, only used from the WHD thread */
+    whd_buffer_t rx_ring[WHD_BUS_RX_RING_SIZE];
+    uint8_t rx_ring_head;
+    uint8_t rx_ring_count;
+    whd_bool_t rx_ring_low;
 };
 
 /******************************************************
@@ -113,10 +130,26 @@ whd_bool_t whd_bus_is_flow_controlled(whd_driver_t whd_driver)
     return whd_driver->bus_common_info->bus_flow_control;
 }
 #ifndef PROTO_MSGBUF
-whd_result_t whd_bus_set_backplane_window(whd_driver_t whd_driver, uint32_t addr)
+/* The window is left where the last access put it, the bus only writes the window registers that differ */
+static whd_result_t whd_bus_move_backplane_window(whd_driver_t whd_driver, uint32_t addr, whd_bool_t memory)
 {
     uint32_t *curbase = &whd_driver->bus_common_info->backplane_window_current_base_address;
-    return whd_driver->bus_if->whd_bus_set_backplane_window_fptr(whd_driver, addr, curbase);
+    uint32_t oldbase = *curbase;
+    whd_result_t result;
+
+    result = whd_driver->bus_if->whd_bus_set_backplane_window_fptr(whd_driver, addr, curbase);
+    if (*curbase != oldbase)
+    {
+        WHD_STATS_CONDITIONAL_INCREMENT_VARIABLE(whd_driver, (memory == WHD_TRUE), bp_window_mem_switch);
+        WHD_STATS_CONDITIONAL_INCREMENT_VARIABLE(whd_driver, (memory == WHD_FALSE), bp_window_reg_switch);
+    }
+
+    return result;
+}
+
+whd_result_t whd_bus_set_backplane_window(whd_driver_t whd_driver, uint32_t addr)
+{
+    return whd_bus_move_backplane_window(whd_driver, addr, WHD_FALSE);
 }
 #endif
 void whd_bus_common_info_init(whd_driver_t whd_driver)
@@ -131,12 +164,17 @@ void whd_bus_common_info_init(whd_driver_t whd_driver)
         bus_common->delayed_bus_release_scheduled = WHD_FALSE;
         bus_common->delayed_bus_release_timeout_ms = PLATFORM_WLAN_ALLOW_BUS_TO_SLEEP_DELAY_MS;
         bus_common->delayed_bus_release_timeout_ms_request = WHD_BUS_WLAN_ALLOW_SLEEP_INVALID_MS;
-        bus_common->backplane_window_current_base_address = 0;
+        bus_common->backplane_window_current_base_address = WHD_BUS_BACKPLANE_WINDOW_INVALID;
 
         bus_common->bus_is_up = WHD_FALSE;
         bus_common->bus_flow_control = WHD_FALSE;
 
         bus_common->resource_download_abort = WHD_FALSE;
+
+        whd_mem_memset(bus_common->rx_ring, 0, sizeof(bus_common->rx_ring) );
+        bus_common->rx_ring_head = 0;
+        bus_common->rx_ring_count = 0;
+        bus_common->rx_ring_low = WHD_FALSE;
     }
     else
     {
@@ -148,11 +186,149 @@ void whd_bus_common_info_deinit(whd_driver_t whd_driver)
 {
     if (whd_driver->bus_common_info != NULL)
     {
+        whd_bus_rx_ring_flush(whd_driver);
         whd_mem_free(whd_driver->bus_common_info);
         whd_driver->bus_common_info = NULL;
     }
 }
 
+/** Returns how far the front of an RX buffer has to move for the bus data behind the
+ *  buffer header to start on the alignment the buffer interface guarantees
+ */
+static uint16_t whd_bus_rx_buffer_align_shift(whd_driver_t whd_driver, uint16_t size)
+{
+    uint32_t alignment = whd_buffer_get_alignment(whd_driver);
+    uint32_t shift;
+
+    if ( (alignment < 2) || ( (alignment & (alignment - 1) ) != 0 ) )
+    {
+        return 0;
+    }
+    shift = (alignment - (sizeof(whd_buffer_header_t) % alignment) ) % alignment;
+
+    /* Keep to the sizes the buffer interface is asked for anyway */
+    return ( (uint32_t)size + shift <= WHD_BUS_RX_RING_BUFFER_SIZE ) ? (uint16_t)shift : 0;
+}
+
+/** Gets a buffer to receive a frame into
+ *
+ *  Frames that fit are taken from the RX buffer ring without allocating, others, or all
+ *  of them once the ring has run dry, are allocated from the buffer interface. If the
+ *  buffer interface guarantees an alignment, the front of the buffer is moved so that
+ *  the bus data following the buffer header is aligned.
+ *
+ *  @param buffer     : Receives the buffer
+ *  @param size       : The number of bytes needed, including the buffer header
+ *  @param timeout_ms : Maximum period to block for a buffer when the ring cannot be used
+ *
+ *  @return WHD result code
+ */
+whd_result_t whd_bus_rx_buffer_get(whd_driver_t whd_driver, whd_buffer_t *buffer, uint16_t size,
+                                   uint32_t timeout_ms)
+{
+    struct whd_bus_common_info *bus_common = whd_driver->bus_common_info;
+    uint16_t shift = whd_bus_rx_buffer_align_shift(whd_driver, size);
+    whd_result_t result;
+
+    if ( (size + shift <= WHD_BUS_RX_RING_BUFFER_SIZE) && (bus_common->rx_ring_count > 0) )
+    {
+        *buffer = bus_common->rx_ring[bus_common->rx_ring_head];
+        bus_common->rx_ring[bus_common->rx_ring_head] = NULL;
+        bus_common->rx_ring_head = (uint8_t)( (bus_common->rx_ring_head + 1) % WHD_BUS_RX_RING_SIZE );
+        bus_common->rx_ring_count--;
+
+        if ( (bus_common->rx_ring_count <= WHD_BUS_RX_RING_LOW_WATERMARK) && (bus_common->rx_ring_low == WHD_FALSE) )
+        {
+            bus_common->rx_ring_low = WHD_TRUE;
+            WHD_STATS_INCREMENT_VARIABLE(whd_driver, rx_ring_low_watermark);
+            WPRINT_WHD_DEBUG( ("RX buffer ring down to %u buffers\n", bus_common->rx_ring_count) );
+        }
+
+        if (shift != 0)
+        {
+            result = whd_buffer_add_remove_at_front(whd_driver, buffer, (int32_t)shift);
+        }
+        else
+        {
+            result = WHD_SUCCESS;
+        }
+        if (result == WHD_SUCCESS)
+        {
+            result = whd_buffer_set_size(whd_driver, *buffer, size);
+        }
+        if (result == WHD_SUCCESS)
+        {
+            WHD_STATS_INCREMENT_VARIABLE(whd_driver, rx_ring_hit);
+            return WHD_SUCCESS;
+        }
+        CHECK_RETURN(whd_buffer_release(whd_driver, *buffer, WHD_NETWORK_RX) );
+    }
+
+    WHD_STATS_INCREMENT_VARIABLE(whd_driver, rx_ring_miss);
+    result = whd_host_buffer_get(whd_driver, buffer, WHD_NETWORK_RX, (uint16_t)(size + shift), timeout_ms);
+    if (result != WHD_SUCCESS)
+    {
+        WHD_STATS_INCREMENT_VARIABLE(whd_driver, rx_no_mem);
+        return result;
+    }
+    if (shift != 0)
+    {
+        result = whd_buffer_add_remove_at_front(whd_driver, buffer, (int32_t)shift);
+        if (result != WHD_SUCCESS)
+        {
+            CHECK_RETURN(whd_buffer_release(whd_driver, *buffer, WHD_NETWORK_RX) );
+        }
+    }
+    return result;
+}
+
+/** Tops up the RX buffer ring from the buffer interface without blocking
+ *
+ *  Called by the WHD thread between bus transfers.
+ */
+void whd_bus_rx_ring_refill(whd_driver_t whd_driver)
+{
+    struct whd_bus_common_info *bus_common = whd_driver->bus_common_info;
+    whd_buffer_t buffer;
+    uint8_t tail;
+
+    while (bus_common->rx_ring_count < WHD_BUS_RX_RING_SIZE)
+    {
+        if (whd_host_buffer_get(whd_driver, &buffer, WHD_NETWORK_RX, WHD_BUS_RX_RING_BUFFER_SIZE, 0) != WHD_SUCCESS)
+        {
+            break;
+        }
+        tail = (uint8_t)( (bus_common->rx_ring_head + bus_common->rx_ring_count) % WHD_BUS_RX_RING_SIZE );
+        bus_common->rx_ring[tail] = buffer;
+        bus_common->rx_ring_count++;
+    }
+
+    if (bus_common->rx_ring_count > WHD_BUS_RX_RING_LOW_WATERMARK)
+    {
+        bus_common->rx_ring_low = WHD_FALSE;
+    }
+}
+
+/** Returns all buffers of the RX buffer ring to the buffer interface */
+void whd_bus_rx_ring_flush(whd_driver_t whd_driver)
+{
+    struct whd_bus_common_info *bus_common = whd_driver->bus_common_info;
+
+    while (bus_common->rx_ring_count > 0)
+    {
+        if (whd_buffer_release(whd_driver, bus_common->rx_ring[bus_common->rx_ring_head], WHD_NETWORK_RX) !=
+            WHD_SUCCESS)
+        {
+            WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
+        }
+        bus_common->rx_ring[bus_common->rx_ring_head] = NULL;
+        bus_common->rx_ring_head = (uint8_t)( (bus_common->rx_ring_head + 1) % WHD_BUS_RX_RING_SIZE );
+        bus_common->rx_ring_count--;
+    }
+    bus_common->rx_ring_head = 0;
+    bus_common->rx_ring_low = WHD_FALSE;
+}
+
 void whd_delayed_bus_release_schedule_update(whd_driver_t whd_driver, whd_bool_t is_scheduled)
 {
     whd_driver->bus_common_info->delayed_bus_release_scheduled = is_scheduled;
@@ -231,7 +407,7 @@ whd_bool_t whd_bus_platform_mcu_power_save_deep_sleep_enabled(whd_driver_t whd_d
 
 void whd_bus_init_backplane_window(whd_driver_t whd_driver)
 {
-    whd_driver->bus_common_info->backplane_window_current_base_address = 0;
+    whd_driver->bus_common_info->backplane_window_current_base_address = WHD_BUS_BACKPLANE_WINDOW_INVALID;
 }
 
 whd_result_t whd_bus_write_wifi_firmware_image(whd_driver_t whd_driver)
@@ -297,6 +473,8 @@ whd_result_t whd_bus_write_wifi_firmware_image(whd_driver_t whd_driver)
     if (result != WHD_SUCCESS)
         WPRINT_WHD_ERROR( ("Bus common resource download failed, %s failed at %d \n", __func__, __LINE__) );
 
+    whd_resource_release(whd_driver, WHD_RESOURCE_WLAN_FIRMWARE);
+
 #ifdef BLHS_SUPPORT
     CHECK_RETURN(whd_bus_common_blhs(whd_driver, POST_FW_DOWNLOAD) );
     CHECK_RETURN(whd_bus_common_blhs(whd_driver, CHK_FW_VALIDATION) );
@@ -366,7 +544,7 @@ whd_result_t whd_bus_transfer_backplane_bytes(whd_driver_t whd_driver, whd_bus_t
             transfer_size = BACKPLANE_WINDOW_SIZE - window_offset_address;
         }
 #ifndef PROTO_MSGBUF
-        result = whd_bus_set_backplane_window(whd_driver, address);
+        result = whd_bus_move_backplane_window(whd_driver, address, WHD_TRUE);
 #endif
         if (result == WHD_UNSUPPORTED)
         {
@@ -414,9 +592,6 @@ whd_result_t whd_bus_transfer_backplane_bytes(whd_driver_t whd_driver, whd_bus_t
     }
 
 done:
-#ifndef PROTO_MSGBUF
-    whd_bus_set_backplane_window(whd_driver, CHIPCOMMON_BASE_ADDRESS);
-#endif
     if (pkt_buffer != NULL)
     {
         CHECK_RETURN(whd_buffer_release(whd_driver, pkt_buffer,
@@ -426,3 +601,345 @@ done:
 
     return WHD_SUCCESS;
 }
+
+static uint32_t whd_bus_download_elapsed(cy_time_t start)
+{
+    cy_time_t now;
+
+    (void)cy_rtos_get_time(&now);
+    return (uint32_t)(now - start);
+}
+
+/* Called when a download buffer has been written, from the transfer or the wait for it */
+static void whd_bus_download_write_done(whd_driver_t whd_driver, void *arg, whd_result_t result)
+{
+    whd_bus_download_slot_t *slot = (whd_bus_download_slot_t *)arg;
+
+    UNUSED_PARAMETER(whd_driver);
+    slot->result = result;
+    slot->busy = WHD_FALSE;
+}
+
+/* Only one transfer is in flight, waiting for it frees the buffer it was written from */
+static whd_result_t whd_bus_download_wait(whd_driver_t whd_driver, whd_bus_download_t *download,
+                                          whd_bus_download_slot_t *slot)
+{
+    cy_time_t start;
+
+    if (slot->busy == WHD_TRUE)
+    {
+        (void)cy_rtos_get_time(&start);
+        (void)whd_bus_transfer_wait(whd_driver);
+        download->bus_wait_time += whd_bus_download_elapsed(start);
+        slot->busy = WHD_FALSE;
+    }
+
+    return slot->result;
+}
+
+whd_result_t whd_bus_download_start(whd_driver_t whd_driver, whd_bus_download_t *download)
+{
+    uint16_t buffer_size = (uint16_t)(whd_bus_get_max_transfer_size(whd_driver) + MAX_BUS_HEADER_SIZE);
+    whd_result_t result;
+    uint8_t i;
+
+    whd_mem_memset(download, 0, sizeof(*download) );
+    (void)cy_rtos_get_time(&download->start_time);
+
+    for (i = 0; i < WHD_BUS_DOWNLOAD_BUFFERS; i++)
+    {
+        /* The first buffer may wait for the pool, the others are only worth taking if they are free */
+        result = whd_host_buffer_get(whd_driver, &download->slot[i].buffer, WHD_NETWORK_TX, buffer_size,
+                                     (i == 0) ? WHD_BACKPLAIN_BUF_TIMEOUT : 0);
+        if (result != WHD_SUCCESS)
+        {
+            download->slot[i].buffer = NULL;
+            break;
+        }
+        download->num_slots++;
+    }
+
+    if (download->num_slots == 0)
+    {
+        WPRINT_WHD_ERROR( ("Packet buffer allocation failed in %s at %d \n", __func__, __LINE__) );
+        return WHD_BUFFER_ALLOC_FAIL;
+    }
+
+    return WHD_SUCCESS;
+}
+
+whd_result_t whd_bus_download_get_block(whd_driver_t whd_driver, whd_bus_download_t *download,
+                                        whd_resource_type_t type, uint32_t blockno, const uint8_t **data,
+                                        uint32_t *size_out)
+{
+    cy_time_t start;
+    whd_result_t result;
+
+    (void)cy_rtos_get_time(&start);
+    result = whd_get_resource_block(whd_driver, type, blockno, data, size_out);
+    download->read_time += whd_bus_download_elapsed(start);
+
+    return result;
+}
+
+whd_result_t whd_bus_download_write(whd_driver_t whd_driver, whd_bus_download_t *download, uint32_t address,
+                                    const uint8_t *data, uint32_t size)
+{
+    whd_bus_download_slot_t *slot;
+    whd_transfer_bytes_packet_t *packet;
+    uint32_t transfer_size;
+    uint32_t remaining_buf_size;
+    uint32_t window_offset_address;
+    uint32_t trans_addr;
+    cy_time_t start;
+    whd_result_t result = WHD_SUCCESS;
+
+    whd_bus_download_record(download, address, data, size);
+
+    for (remaining_buf_size = size; remaining_buf_size != 0;
+         remaining_buf_size -= transfer_size, address += transfer_size, data += transfer_size)
+    {
+        transfer_size = MIN_OF(remaining_buf_size, whd_bus_get_max_transfer_size(whd_driver) );
+
+        /* Check if the transfer crosses the backplane window boundary */
+        window_offset_address = address & BACKPLANE_ADDRESS_MASK;
+        if ( (window_offset_address + transfer_size) > BACKPLANE_ADDRESS_MASK )
+        {
+            /* Adjust the transfer size to within current window */
+            transfer_size = BACKPLANE_WINDOW_SIZE - window_offset_address;
+        }
+
+        slot = &download->slot[download->next_slot];
+        download->next_slot = (uint8_t)( (download->next_slot + 1) % download->num_slots );
+        CHECK_RETURN(whd_bus_download_wait(whd_driver, download, slot) );
+
+        /* Filled while the previous buffer is on the bus */
+        packet = (whd_transfer_bytes_packet_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, slot->buffer);
+        CHECK_PACKET_NULL(packet, WHD_NO_REGISTER_FUNCTION_POINTER);
+        DISABLE_COMPILER_WARNING(diag_suppress = Pa039)
+        whd_mem_memcpy(packet->data, data, transfer_size);
+        ENABLE_COMPILER_WARNING(diag_suppress = Pa039)
+
+        /* Moving the window and starting the write both wait for the previous write */
+        (void)cy_rtos_get_time(&start);
+#ifndef PROTO_MSGBUF
+        result = whd_bus_move_backplane_window(whd_driver, address, WHD_TRUE);
+#endif
+        if (result == WHD_UNSUPPORTED)
+        {
+            /* No backplane support, write data to address directly */
+            trans_addr = address;
+        }
+        else if (result == WHD_SUCCESS)
+        {
+            trans_addr = address & BACKPLANE_ADDRESS_MASK;
+        }
+        else
+        {
+            return result;
+        }
+
+        slot->busy = WHD_TRUE;
+        result = whd_bus_transfer_async(whd_driver, BUS_WRITE, BACKPLANE_FUNCTION, trans_addr,
+                                        (uint16_t)transfer_size, packet, whd_bus_download_write_done, slot);
+        download->bus_wait_time += whd_bus_download_elapsed(start);
+        if (result != WHD_SUCCESS)
+        {
+            slot->busy = WHD_FALSE;
+            return result;
+        }
+        /* Written synchronously */
+        if (slot->busy == WHD_FALSE)
+        {
+            CHECK_RETURN(slot->result);
+        }
+        download->bytes += transfer_size;
+    }
+
+    return WHD_SUCCESS;
+}
+
+whd_result_t whd_bus_download_finish(whd_driver_t whd_driver, whd_bus_download_t *download)
+{
+    whd_result_t result = WHD_SUCCESS;
+    whd_result_t slot_result;
+    uint32_t total_time;
+    uint8_t i;
+
+    if (download->num_slots == 0)
+    {
+        return WHD_SUCCESS;
+    }
+
+    for (i = 0; i < download->num_slots; i++)
+    {
+        slot_result = whd_bus_download_wait(whd_driver, download, &download->slot[i]);
+        if (result == WHD_SUCCESS)
+        {
+            result = slot_result;
+        }
+        CHECK_RETURN(whd_buffer_release(whd_driver, download->slot[i].buffer, WHD_NETWORK_TX) );
+        download->slot[i].buffer = NULL;
+    }
+    download->num_slots = 0;
+
+    total_time = whd_bus_download_elapsed(download->start_time);
+    WHD_STATS_ADD_VARIABLE(whd_driver, dl_bytes, download->bytes);
+    WHD_STATS_ADD_VARIABLE(whd_driver, dl_read_time, download->read_time);
+    WHD_STATS_ADD_VARIABLE(whd_driver, dl_bus_wait_time, download->bus_wait_time);
+    WHD_STATS_ADD_VARIABLE(whd_driver, dl_total_time, total_time);
+    WPRINT_WHD_INFO( ("Downloaded %" PRIu32 " bytes in %" PRIu32 " ms (read %" PRIu32 " ms, bus wait %" PRIu32 " ms)\n",
+                      download->bytes, total_time, download->read_time, download->bus_wait_time) );
+
+    return result;
+}
+
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST)
+static void whd_bus_download_sample(whd_bus_download_sample_t *sample, uint32_t offset, uint32_t address,
+                                    const uint8_t *data, uint32_t size)
+{
+    sample->offset = offset;
+    sample->address = address;
+    sample->size = MIN_OF(size, WHD_RESOURCE_VERIFY_SAMPLE_SIZE);
+    whd_mem_memcpy(sample->data, data, sample->size);
+}
+
+#endif
+
+void whd_bus_download_record(whd_bus_download_t *download, uint32_t address, const uint8_t *data, uint32_t size)
+{
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST)
+    whd_bus_download_verify_t *verify = &download->verify;
+    trx_header_t trx;
+    uint32_t crc_start;
+    uint32_t crc_end;
+    uint8_t i;
+
+    if (size == 0)
+    {
+        return;
+    }
+
+    if (verify->offset == 0)
+    {
+        verify->crc = WHD_CRC32_INIT;
+        verify->stride = WHD_RESOURCE_VERIFY_STRIDE;
+        if (size >= sizeof(trx) )
+        {
+            whd_mem_memcpy(&trx, data, sizeof(trx) );
+            if ( (trx.magic == TRX_MAGIC) && (trx.len >= sizeof(trx) ) )
+            {
+                verify->trx_len = trx.len;
+                verify->trx_crc = trx.crc32;
+            }
+        }
+    }
+
+    /* The TRX CRC covers flag_version to the end of the image */
+    if (verify->trx_len != 0)
+    {
+        crc_start = MAX_OF(verify->offset, offsetof(trx_header_t, flag_version) );
+        crc_end = MIN_OF(verify->offset + size, verify->trx_len);
+        if (crc_start < crc_end)
+        {
+            verify->crc = whd_crc32(verify->crc, data + (crc_start - verify->offset), crc_end - crc_start);
+        }
+    }
+
+    if (verify->offset >= verify->next_sample)
+    {
+        if (verify->num_samples == WHD_RESOURCE_VERIFY_SAMPLES)
+        {
+            /* Keep every other sample and sample half as often */
+            for (i = 0; i < WHD_RESOURCE_VERIFY_SAMPLES / 2; i++)
+            {
+                verify->sample[i] = verify->sample[2 * i];
+            }
+            verify->num_samples = WHD_RESOURCE_VERIFY_SAMPLES / 2;
+            verify->stride *= 2;
+            verify->next_sample = verify->sample[verify->num_samples - 1].offset + verify->stride;
+        }
+        if (verify->offset >= verify->next_sample)
+        {
+            whd_bus_download_sample(&verify->sample[verify->num_samples++], verify->offset, address, data, size);
+            verify->next_sample = verify->offset + verify->stride;
+        }
+    }
+
+    if (size >= WHD_RESOURCE_VERIFY_SAMPLE_SIZE)
+    {
+        whd_bus_download_sample(&verify->tail, verify->offset + size - WHD_RESOURCE_VERIFY_SAMPLE_SIZE,
+                                address + size - WHD_RESOURCE_VERIFY_SAMPLE_SIZE,
+                                data + size - WHD_RESOURCE_VERIFY_SAMPLE_SIZE, WHD_RESOURCE_VERIFY_SAMPLE_SIZE);
+    }
+    else
+    {
+        whd_bus_download_sample(&verify->tail, verify->offset, address, data, size);
+    }
+
+    verify->offset += size;
+#else
+    UNUSED_PARAMETER(download);
+    UNUSED_PARAMETER(address);
+    UNUSED_PARAMETER(data);
+    UNUSED_PARAMETER(size);
+#endif
+}
+
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST)
+static whd_result_t whd_bus_download_check_sample(whd_driver_t whd_driver, const whd_bus_download_sample_t *sample)
+{
+    uint8_t readback[WHD_RESOURCE_VERIFY_SAMPLE_SIZE];
+
+    CHECK_RETURN(whd_bus_transfer_backplane_bytes(whd_driver, BUS_READ, sample->address, sample->size, readback) );
+    if (memcmp(readback, sample->data, sample->size) != 0)
+    {
+        WPRINT_WHD_ERROR( ("Downloaded image differs at offset %" PRIu32 ", address 0x%08" PRIx32 "\n",
+                           sample->offset, sample->address) );
+        return WHD_WLAN_SDIO_ERROR;
+    }
+
+    return WHD_SUCCESS;
+}
+
+whd_result_t whd_bus_download_verify(whd_driver_t whd_driver, whd_bus_download_t *download)
+{
+    whd_bus_download_verify_t *verify = &download->verify;
+    cy_time_t start;
+    uint8_t i;
+
+    (void)cy_rtos_get_time(&start);
+
+    if (verify->trx_len != 0)
+    {
+        if (verify->offset < verify->trx_len)
+        {
+            WPRINT_WHD_ERROR( ("Downloaded %" PRIu32 " of %" PRIu32 " image bytes\n", verify->offset,
+                               verify->trx_len) );
+            return WHD_BADARG;
+        }
+        if (verify->crc != verify->trx_crc)
+        {
+            WPRINT_WHD_ERROR( ("Image CRC32 is 0x%08" PRIx32 ", header says 0x%08" PRIx32 "\n", verify->crc,
+                               verify->trx_crc) );
+            return WHD_BADARG;
+        }
+    }
+
+    for (i = 0; i < verify->num_samples; i++)
+    {
+        CHECK_RETURN(whd_bus_download_check_sample(whd_driver, &verify->sample[i]) );
+    }
+    if (verify->offset != 0)
+    {
+        CHECK_RETURN(whd_bus_download_check_sample(whd_driver, &verify->tail) );
+    }
+
+    WPRINT_WHD_INFO( ("Verified %" PRIu32 " bytes%s and %d samples in %" PRIu32 " ms\n", verify->offset,
+                      (verify->trx_len != 0) ? " by CRC32" : "", verify->num_samples + 1,
+                      whd_bus_download_elapsed(start) ) );
+
+    return WHD_SUCCESS;
+}
+
+#endif /* (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST) */
@@ -14,7 +14,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "cyabs_rtos.h"
 #include "whd.h"
+#include "whd_resource_api.h"
 #include "whd_trxhdr.h"
 #include <stdint.h>
 
@@ -28,6 +30,63 @@ extern "C" {
 #define WHD_BACKPLAIN_BUF_TIMEOUT   (0xFFFFFFFF)
 #define WHD_RX_BUF_TIMEOUT          (10)
 
+/* Buffers of a pipelined resource download, one is filled while another one is on the bus */
+#ifndef WHD_BUS_DOWNLOAD_BUFFERS
+#define WHD_BUS_DOWNLOAD_BUFFERS    (2)
+#endif
+
+/* How a downloaded resource is checked:
+ *  WHD_RESOURCE_VERIFY_NONE    not at all
+ *  WHD_RESOURCE_VERIFY_FULL    the whole image is read back and compared, doubling the download time
+ *  WHD_RESOURCE_VERIFY_DIGEST  the CRC32 of the TRX header is checked against the bytes sent, and a few
+ *                              samples spread over the image plus its tail are read back and compared
+ * A resource that fails verification fails the download, and with it whd_wifi_on(). DIGEST is the
+ * default without WPRINT_ENABLE_WHD_DEBUG, define WHD_RESOURCE_VERIFY to WHD_RESOURCE_VERIFY_NONE
+ * to boot without checking.
+ */
+#define WHD_RESOURCE_VERIFY_NONE    (0)
+#define WHD_RESOURCE_VERIFY_FULL    (1)
+#define WHD_RESOURCE_VERIFY_DIGEST  (2)
+
+#ifndef WHD_RESOURCE_VERIFY
+#ifdef WPRINT_ENABLE_WHD_DEBUG
+#define WHD_RESOURCE_VERIFY         WHD_RESOURCE_VERIFY_FULL
+#else
+#define WHD_RESOURCE_VERIFY         WHD_RESOURCE_VERIFY_DIGEST
+#endif
+#endif
+
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST)
+/* Samples kept over the image, even. Sampling starts every WHD_RESOURCE_VERIFY_STRIDE bytes, and the
+ * stride doubles each time the samples run out, so they stay evenly spread whatever the image size. */
+#ifndef WHD_RESOURCE_VERIFY_SAMPLES
+#define WHD_RESOURCE_VERIFY_SAMPLES     (8)
+#endif
+#define WHD_RESOURCE_VERIFY_SAMPLE_SIZE (32)
+#define WHD_RESOURCE_VERIFY_STRIDE      (4096)
+
+typedef struct whd_bus_download_sample
+{
+    uint32_t offset;            /* Offset in the resource */
+    uint32_t address;
+    uint32_t size;
+    uint8_t data[WHD_RESOURCE_VERIFY_SAMPLE_SIZE];
+} whd_bus_download_sample_t;
+
+typedef struct whd_bus_download_verify
+{
+    uint32_t offset;            /* Resource bytes seen so far */
+    uint32_t crc;
+    uint32_t trx_len;           /* Length from the TRX header, 0 if the resource has none */
+    uint32_t trx_crc;
+    uint32_t stride;
+    uint32_t next_sample;
+    uint8_t num_samples;
+    whd_bus_download_sample_t sample[WHD_RESOURCE_VERIFY_SAMPLES];
+    whd_bus_download_sample_t tail;
+} whd_bus_download_verify_t;
+#endif /* (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST) */
+
 typedef enum
 {
     CHK_BL_INIT = 0,
@@ -43,6 +102,30 @@ typedef enum
 
 struct whd_bus_common_info;
 
+typedef struct whd_bus_download_slot
+{
+    whd_buffer_t buffer;
+    whd_bool_t busy;            /* Written asynchronously and not completed yet */
+    whd_result_t result;        /* Result of the last write from this buffer */
+} whd_bus_download_slot_t;
+
+/* Pipelined download of a resource to device memory. Each chunk is copied into a driver buffer and
+ * written asynchronously, so the next resource block is fetched while the previous one is on the bus.
+ * Stage times are in ms and summed over the calls, see whd_bus_download_finish(). */
+typedef struct whd_bus_download
+{
+    whd_bus_download_slot_t slot[WHD_BUS_DOWNLOAD_BUFFERS];
+    uint8_t num_slots;
+    uint8_t next_slot;
+    uint32_t bytes;             /* Bytes submitted to the bus */
+    cy_time_t start_time;
+    uint32_t read_time;         /* Time spent fetching resource blocks */
+    uint32_t bus_wait_time;     /* Time spent waiting for the bus */
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST)
+    whd_bus_download_verify_t verify;
+#endif
+} whd_bus_download_t;
+
 void whd_bus_common_info_init(whd_driver_t whd_driver);
 void whd_bus_common_info_deinit(whd_driver_t whd_driver);
 
@@ -59,6 +142,77 @@ extern void         whd_bus_set_resource_download_halt(whd_driver_t whd_driver,
 
 extern whd_result_t whd_bus_transfer_backplane_bytes(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
                                                      uint32_t address, uint32_t size, uint8_t *data);
+
+/** Allocates the buffers of a pipelined download, one buffer is enough to make progress
+ *
+ *  @param whd_driver    Pointer to handle instance of the driver
+ *  @param download      Download to start
+ *
+ *  @return WHD_SUCCESS or error code
+ */
+extern whd_result_t whd_bus_download_start(whd_driver_t whd_driver, whd_bus_download_t *download);
+
+/** Fetches a resource block, the time taken counts as the read stage
+ *
+ *  @param whd_driver    Pointer to handle instance of the driver
+ *  @param download      Started download
+ *  @param type          Type of resource
+ *  @param blockno       Block number
+ *  @param data          Receives a pointer to the block, valid until the next block is fetched
+ *  @param size_out      Receives the size of the block
+ *
+ *  @return WHD_SUCCESS or error code
+ */
+extern whd_result_t whd_bus_download_get_block(whd_driver_t whd_driver, whd_bus_download_t *download,
+                                               whd_resource_type_t type, uint32_t blockno, const uint8_t **data,
+                                               uint32_t *size_out);
+
+/** Queues data for writing to device memory, data may be reused as soon as the call returns
+ *
+ *  @param whd_driver    Pointer to handle instance of the driver
+ *  @param download      Started download
+ *  @param address       Backplane address to write to
+ *  @param data          Data to write
+ *  @param size          Number of bytes to write
+ *
+ *  @return WHD_SUCCESS or the error code of this or an earlier write
+ */
+extern whd_result_t whd_bus_download_write(whd_driver_t whd_driver, whd_bus_download_t *download, uint32_t address,
+                                           const uint8_t *data, uint32_t size);
+
+/** Waits for the outstanding writes, releases the buffers and accounts the stage times in the driver stats.
+ *  Safe to call more than once.
+ *
+ *  @param whd_driver    Pointer to handle instance of the driver
+ *  @param download      Download to finish
+ *
+ *  @return WHD_SUCCESS or the error code of an outstanding write
+ */
+extern whd_result_t whd_bus_download_finish(whd_driver_t whd_driver, whd_bus_download_t *download);
+
+/** Records data written to device memory for whd_bus_download_verify(). Data queued with
+ *  whd_bus_download_write() is recorded already, only data written around it needs this.
+ *
+ *  @param download      Started download
+ *  @param address       Backplane address the data goes to, following the previous data
+ *  @param data          Data written
+ *  @param size          Number of bytes written
+ */
+extern void whd_bus_download_record(whd_bus_download_t *download, uint32_t address, const uint8_t *data,
+                                    uint32_t size);
+
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST)
+/** Checks a finished download against the CRC32 of its TRX header and reads back the samples
+ *
+ *  @param whd_driver    Pointer to handle instance of the driver
+ *  @param download      Finished download
+ *
+ *  @return WHD_SUCCESS, WHD_BADARG if the resource does not match its CRC32, WHD_WLAN_SDIO_ERROR if
+ *          device memory does not match the resource, or the error code of a read
+ */
+extern whd_result_t whd_bus_download_verify(whd_driver_t whd_driver, whd_bus_download_t *download);
+#endif
+
 extern void whd_bus_init_backplane_window(whd_driver_t whd_driver);
 whd_result_t whd_bus_set_backplane_window(whd_driver_t whd_driver, uint32_t addr);
 
@@ -72,6 +226,11 @@ extern void whd_delayed_bus_release_schedule_update(whd_driver_t whd_driver, whd
 
 /* handle delayed sleep of bus */
 extern uint32_t     whd_bus_handle_delayed_release(whd_driver_t whd_driver);
+
+extern whd_result_t whd_bus_rx_buffer_get(whd_driver_t whd_driver, whd_buffer_t *buffer, uint16_t size,
+                                          uint32_t timeout_ms);
+extern void         whd_bus_rx_ring_refill(whd_driver_t whd_driver);
+extern void         whd_bus_rx_ring_flush(whd_driver_t whd_driver);
 whd_bool_t whd_bus_platform_mcu_power_save_deep_sleep_enabled(whd_driver_t whd_driver);
 #ifdef __cplusplus
 } /*extern "C" */
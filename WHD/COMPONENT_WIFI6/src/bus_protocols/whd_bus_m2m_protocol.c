@@ -42,6 +42,7 @@
 #include "whd_wlioctl.h"
 #include "whd_m2m.h"
 #include "whd_proto.h"
+#include "whd_sdpcm.h"
 
 /******************************************************
 *             Constants
@@ -220,7 +221,7 @@ static whd_result_t whd_bus_m2m_init(whd_driver_t whd_driver)
 
 #if !defined (__IAR_SYSTEMS_ICC__)
     /* Get chip id */
-    whd_chip_set_chip_id(whd_driver, (uint16_t)REGISTER_READ(uint32_t, CHIPCOMMON_BASE_ADDRESS) );
+    CHECK_RETURN(whd_chip_set_chip_id(whd_driver, (uint16_t)REGISTER_READ(uint32_t, CHIPCOMMON_BASE_ADDRESS) ) );
 #endif
 
     result = boot_wlan(whd_driver);
@@ -268,10 +269,13 @@ static whd_result_t whd_bus_m2m_send_buffer(whd_driver_t whd_driver, whd_buffer_
 {
     whd_result_t result = WHD_SUCCESS;
 
+    /* The DMA engine owns the buffer once queued. It is only reclaimed by this (the WHD) thread
+     * in whd_bus_m2m_read_frame(), so the buffer can still be looked at after queueing it. */
     if (cyhal_m2m_tx_send(whd_driver->bus_priv->m2m_obj, buffer) != CY_RSLT_SUCCESS)
     {
         result = WHD_WLAN_ERROR;
     }
+    whd_sdpcm_tx_buffer_done(whd_driver, buffer, result);
 
     return result;
 }
@@ -465,7 +469,8 @@ static whd_result_t whd_bus_m2m_wait_for_wlan_event(whd_driver_t whd_driver, cy_
     whd_result_t result = WHD_SUCCESS;
     uint32_t timeout_ms;
 
-    timeout_ms = CY_RTOS_NEVER_TIMEOUT;
+    /* Never, unless the thread must wake up to time out an asynchronous IOCTL */
+    timeout_ms = whd_driver->thread_info.max_sleep_ms;
     whd_bus_m2m_irq_enable(whd_driver, WHD_TRUE);
     result = cy_rtos_get_semaphore(transceive_semaphore, timeout_ms, WHD_FALSE);
 
@@ -70,6 +70,38 @@ typedef struct
 
 typedef void (*whd_bus_irq_callback_t)(void *handler_arg, uint32_t event);
 
+/* Most register operations queued in one whd_bus_reg_batch_t */
+#define WHD_BUS_REG_BATCH_MAX_OPS    (8)
+
+typedef enum
+{
+    WHD_BUS_REG_OP_WRITE,       /* Write the value to the register */
+    WHD_BUS_REG_OP_CLEAR        /* Write-one-to-clear, merged with an earlier clear of the same register */
+} whd_bus_reg_op_type_t;
+
+typedef struct
+{
+    whd_bus_reg_op_type_t type;
+    uint32_t address;           /* Backplane address */
+    uint8_t length;             /* Register width in bytes: 1, 2 or 4 */
+    uint32_t value;             /* Value written, bits cleared */
+} whd_bus_reg_op_t;
+
+/* Backplane register writes queued to be done with as few bus transfers as possible */
+typedef struct
+{
+    whd_bus_reg_op_t ops[WHD_BUS_REG_BATCH_MAX_OPS];
+    uint8_t count;
+} whd_bus_reg_batch_t;
+
+/** Called once a transfer started by whd_bus_transfer_async() has finished
+ *
+ *  @param whd_driver    Instance of whd driver
+ *  @param arg           Argument given to whd_bus_transfer_async()
+ *  @param result        Result of the transfer
+ */
+typedef void (*whd_bus_transfer_complete_t)(whd_driver_t whd_driver, void *arg, whd_result_t result);
+
 /******************************************************
 *             Function declarations
 ******************************************************/
@@ -107,6 +139,23 @@ extern whd_result_t whd_bus_send_buffer(whd_driver_t whd_driver, whd_buffer_t bu
 extern whd_result_t whd_bus_transfer_bytes(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
                                            whd_bus_function_t function, uint32_t address, uint16_t size,
                                            whd_transfer_bytes_packet_t *data);
+/* Starts a transfer that may still be in progress on return, complete is called once it has finished,
+ * also when it failed. Only one transfer is in flight: any other bus access first waits for it. Buses
+ * without asynchronous support transfer synchronously and call complete before returning. */
+extern whd_result_t whd_bus_transfer_async(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
+                                           whd_bus_function_t function, uint32_t address, uint16_t size,
+                                           whd_transfer_bytes_packet_t *data,
+                                           whd_bus_transfer_complete_t complete, void *arg);
+/* Waits for the transfer in flight, if any, and calls its completion callback */
+extern whd_result_t whd_bus_transfer_wait(whd_driver_t whd_driver);
+
+/* Register write batching: operations are queued and done in order by whd_bus_reg_batch_execute() */
+extern void         whd_bus_reg_batch_init(whd_bus_reg_batch_t *batch);
+extern whd_result_t whd_bus_reg_batch_write(whd_bus_reg_batch_t *batch, uint32_t address, uint8_t length,
+                                            uint32_t value);
+extern whd_result_t whd_bus_reg_batch_clear(whd_bus_reg_batch_t *batch, uint32_t address, uint8_t length,
+                                            uint32_t bits);
+extern whd_result_t whd_bus_reg_batch_execute(whd_driver_t whd_driver, whd_bus_reg_batch_t *batch);
 
 /* Frame transfer function */
 extern whd_result_t whd_bus_read_frame(whd_driver_t whd_driver, whd_buffer_t *buffer);
@@ -127,6 +176,8 @@ extern whd_result_t whd_bus_sleep(whd_driver_t whd_driver);
 extern uint8_t whd_bus_backplane_read_padd_size(whd_driver_t whd_driver);
 extern whd_bool_t whd_bus_use_status_report_scheme(whd_driver_t whd_driver);
 extern uint32_t whd_bus_get_max_transfer_size(whd_driver_t whd_driver);
+/* Block size agreed with the device for F2 transfers, 1 for buses that do not transfer in blocks */
+extern uint16_t whd_bus_get_block_size(whd_driver_t whd_driver);
 
 extern void         whd_bus_init_stats(whd_driver_t whd_driver);
 extern whd_result_t whd_bus_print_stats(whd_driver_t whd_driver, whd_bool_t reset_after_print);
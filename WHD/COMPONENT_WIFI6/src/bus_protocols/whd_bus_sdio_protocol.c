@@ -78,6 +78,22 @@
 
 #define INITIAL_READ   4
 
+/* SDPCM header fields looked at by the RX glom path */
+#define SDPCM_FRAMETAG_LEN          (4)
+#define SDPCM_SWHEADER_LEN          (8)
+#define SDPCM_CHANNEL_OFFSET        (SDPCM_FRAMETAG_LEN + 1)
+#define SDPCM_NEXTLEN_OFFSET        (SDPCM_FRAMETAG_LEN + 2)
+#define SDPCM_DOFFSET_OFFSET        (SDPCM_FRAMETAG_LEN + 3)
+#define SDPCM_CHANNEL_MASK          (0x0f)
+#define SDPCM_GLOMDESC_FLAG         (0x80)
+#define SDPCM_GLOM_CHANNEL          (3)
+
+#define SDIO_RX_GLOM_MAX_FRAMES     (32)
+#define SDIO_RX_GLOM_MAX_SIZE       (0xFFFF)         /* A superframe is read with a single transfer */
+
+#define SDIO_RX_NEXTLEN_SHIFT       (4)              /* next_length is announced in 16 byte units */
+#define SDIO_RX_NEXTLEN_MAX         (WHD_LINK_MTU)   /* Larger hints are read in two steps */
+
 #define WHD_THREAD_POLL_TIMEOUT      (CY_RTOS_NEVER_TIMEOUT)
 
 #define WHD_THREAD_POKE_TIMEOUT      (100)
@@ -86,6 +102,11 @@
 
 #if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
 #define DCACHE_BYTE_ALIGNEMNT       (__SCB_DCACHE_LINE_SIZE)
+
+/* Size of the persistent bounce buffer used by cmd53 for buffers that are not cache aligned */
+#ifndef WHD_BUS_SDIO_BOUNCE_SIZE
+#define WHD_BUS_SDIO_BOUNCE_SIZE    (MAX_OF(WHD_LINK_MTU, WHD_BUS_SDIO_MAX_BACKPLANE_TRANSFER_SIZE) )
+#endif
 #endif
 
 /******************************************************
@@ -97,6 +118,35 @@ struct whd_bus_priv
     whd_bus_stats_t whd_bus_stats;
     whd_sdio_t *sdio_obj;
 
+    /* RX glom variables */
+    uint8_t *rx_glom_buffer;          /* Superframe read buffer, grown on demand */
+    uint16_t rx_glom_buffer_size;
+    whd_buffer_t rx_glom_head;        /* Subframes split out of the last superframe, not yet handed up */
+    whd_buffer_t rx_glom_tail;
+
+    uint16_t rx_next_len;             /* Length of the next frame announced by the last header, 0 if unknown */
+
+    whd_bool_t oob_intr_ready;        /* The OOB interrupt is registered, it is masked along with the card one */
+
+    uint16_t block_size;              /* F1/F2 block size agreed with the device */
+    uint16_t max_block_count;         /* Largest block count per CMD53 */
+
+#if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    uint8_t *bounce_mem;              /* Allocation holding the bounce buffer */
+    uint8_t *bounce_buffer;           /* Cache aligned bounce buffer of WHD_BUS_SDIO_BOUNCE_SIZE bytes */
+    cy_semaphore_t bounce_semaphore;  /* Taken while a cmd53 uses the bounce buffer */
+    whd_bool_t rx_buffer_dma;         /* The current read goes to a packet buffer that owns its cache lines */
+#endif
+
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+    cy_semaphore_t async_semaphore;   /* Given by the transfer complete interrupt */
+    cy_semaphore_t async_mutex;       /* Protects the async_ state below, waiters may be on any thread */
+    whd_bool_t async_ready;           /* async_semaphore and async_mutex have been initialised */
+    volatile whd_bool_t async_pending; /* A transfer started by whd_bus_sdio_transfer_async() is in flight */
+    whd_bus_transfer_direction_t async_direction;
+    whd_bus_transfer_complete_t async_complete;
+    void *async_arg;
+#endif
 };
 
 
@@ -120,7 +170,18 @@ whd_result_t whd_bus_sdio_cmd53(whd_driver_t whd_driver, whd_bus_transfer_direct
                                        sdio_response_needed_t response_expected,
                                        uint32_t *response);
 static whd_result_t whd_bus_sdio_abort_read(whd_driver_t whd_driver, whd_bool_t retry);
+static whd_result_t whd_bus_sdio_set_block_size(whd_driver_t whd_driver);
+static whd_result_t whd_bus_sdio_read_packet(whd_driver_t whd_driver, uint16_t data_size, uint8_t *data);
+static whd_result_t whd_bus_sdio_read_glom(whd_driver_t whd_driver, whd_buffer_t desc_buffer);
+static whd_buffer_t whd_bus_sdio_rx_glom_dequeue(whd_driver_t whd_driver);
+static void         whd_bus_sdio_rx_glom_flush(whd_driver_t whd_driver);
+static whd_result_t whd_bus_sdio_read_frame_lookahead(whd_driver_t whd_driver, uint16_t read_len,
+                                                      whd_buffer_t *buffer);
+static whd_result_t whd_bus_sdio_read_frame_done(whd_driver_t whd_driver, whd_buffer_t *buffer);
+static void         whd_bus_sdio_set_rx_next_len(whd_driver_t whd_driver, const uint8_t *header);
 static whd_result_t whd_bus_sdio_download_firmware(whd_driver_t whd_driver);
+static whd_result_t whd_bus_sdio_reg_batch_execute(whd_driver_t whd_driver, whd_bus_reg_batch_t *batch);
+static void         whd_bus_sdio_send_buffer_done(whd_driver_t whd_driver, void *arg, whd_result_t result);
 
 static whd_result_t whd_bus_sdio_set_oob_interrupt(whd_driver_t whd_driver, uint8_t gpio_pin_number);
 
@@ -136,8 +197,19 @@ whd_result_t whd_bus_sdio_unregister_oob_intr(whd_driver_t whd_driver);
 
 static whd_result_t whd_bus_sdio_init_oob_intr(whd_driver_t whd_driver);
 static whd_result_t whd_bus_sdio_deinit_oob_intr(whd_driver_t whd_driver);
+static uint32_t     whd_bus_sdio_cmd53_argument(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
+                                                whd_bus_function_t function, sdio_transfer_mode_t mode,
+                                                uint32_t address, uint16_t data_size);
 #endif /* WHD_USE_CUSTOM_HAL_IMPL */
 
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+static whd_result_t whd_bus_sdio_transfer_async(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
+                                                whd_bus_function_t function, uint32_t address, uint16_t size,
+                                                whd_transfer_bytes_packet_t *data,
+                                                whd_bus_transfer_complete_t complete, void *arg);
+static whd_result_t whd_bus_sdio_transfer_wait(whd_driver_t whd_driver);
+#endif /* WHD_HAL_SDIO_ASYNC_TRANSFER */
+
 #ifdef BLHS_SUPPORT
 static whd_result_t whd_bus_sdio_blhs(whd_driver_t whd_driver, whd_bus_blhs_stage_t stage);
 #endif
@@ -181,6 +253,44 @@ whd_result_t whd_bus_sdio_attach(whd_driver_t whd_driver, whd_sdio_config_t *whd
 
     whd_driver->bus_priv->sdio_obj = sdio_obj;
     whd_driver->bus_priv->sdio_config = *whd_sdio_config;
+    /* Until the device block sizes are programmed in whd_bus_sdio_init() */
+    whd_driver->bus_priv->block_size = (uint16_t)SDIO_64B_BLOCK;
+    whd_driver->bus_priv->max_block_count = SDIO_CMD53_MAX_BLOCK_COUNT;
+
+#if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    /* Without it cmd53 falls back to allocating a bounce buffer per transfer */
+    whd_driver->bus_priv->bounce_mem = (uint8_t *)whd_mem_malloc(WHD_BUS_SDIO_BOUNCE_SIZE + DCACHE_BYTE_ALIGNEMNT);
+    if (whd_driver->bus_priv->bounce_mem != NULL)
+    {
+        if ( (cy_rtos_init_semaphore(&whd_driver->bus_priv->bounce_semaphore, 1, 0) == WHD_SUCCESS) &&
+             (cy_rtos_set_semaphore(&whd_driver->bus_priv->bounce_semaphore, WHD_FALSE) == WHD_SUCCESS) )
+        {
+            whd_driver->bus_priv->bounce_buffer =
+                (uint8_t *)ROUND_UP( (size_t)whd_driver->bus_priv->bounce_mem, DCACHE_BYTE_ALIGNEMNT );
+        }
+        else
+        {
+            whd_mem_free(whd_driver->bus_priv->bounce_mem);
+            whd_driver->bus_priv->bounce_mem = NULL;
+        }
+    }
+#endif
+
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+    /* Without them every transfer is synchronous */
+    if (cy_rtos_init_semaphore(&whd_driver->bus_priv->async_semaphore, 1, 0) == WHD_SUCCESS)
+    {
+        if ( (cy_rtos_init_semaphore(&whd_driver->bus_priv->async_mutex, 1, 0) == WHD_SUCCESS) &&
+             (cy_rtos_set_semaphore(&whd_driver->bus_priv->async_mutex, WHD_FALSE) == WHD_SUCCESS) )
+        {
+            whd_driver->bus_priv->async_ready = WHD_TRUE;
+        }
+        else
+        {
+            (void)cy_rtos_deinit_semaphore(&whd_driver->bus_priv->async_semaphore);
+        }
+    }
+#endif
 
     whd_driver->proto_type = WHD_PROTO_BCDC;
 
@@ -191,9 +301,14 @@ whd_result_t whd_bus_sdio_attach(whd_driver_t whd_driver, whd_sdio_config_t *whd
     whd_bus_info->whd_bus_read_backplane_value_fptr = whd_bus_sdio_read_backplane_value;
     whd_bus_info->whd_bus_write_register_value_fptr = whd_bus_sdio_write_register_value;
     whd_bus_info->whd_bus_read_register_value_fptr = whd_bus_sdio_read_register_value;
+    whd_bus_info->whd_bus_reg_batch_execute_fptr = whd_bus_sdio_reg_batch_execute;
 
     whd_bus_info->whd_bus_send_buffer_fptr = whd_bus_sdio_send_buffer;
     whd_bus_info->whd_bus_transfer_bytes_fptr = whd_bus_sdio_transfer_bytes;
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+    whd_bus_info->whd_bus_transfer_async_fptr = whd_bus_sdio_transfer_async;
+    whd_bus_info->whd_bus_transfer_wait_fptr = whd_bus_sdio_transfer_wait;
+#endif
 
     whd_bus_info->whd_bus_read_frame_fptr = whd_bus_sdio_read_frame;
 
@@ -211,6 +326,7 @@ whd_result_t whd_bus_sdio_attach(whd_driver_t whd_driver, whd_sdio_config_t *whd
     whd_bus_info->whd_bus_use_status_report_scheme_fptr = whd_bus_sdio_use_status_report_scheme;
 
     whd_bus_info->whd_bus_get_max_transfer_size_fptr = whd_bus_sdio_get_max_transfer_size;
+    whd_bus_info->whd_bus_get_block_size_fptr = whd_bus_sdio_get_block_size;
 
     whd_bus_info->whd_bus_init_stats_fptr = whd_bus_sdio_init_stats;
     whd_bus_info->whd_bus_print_stats_fptr = whd_bus_sdio_print_stats;
@@ -235,6 +351,20 @@ void whd_bus_sdio_detach(whd_driver_t whd_driver)
     }
     if (whd_driver->bus_priv != NULL)
     {
+#if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        if (whd_driver->bus_priv->bounce_mem != NULL)
+        {
+            (void)cy_rtos_deinit_semaphore(&whd_driver->bus_priv->bounce_semaphore);
+            whd_mem_free(whd_driver->bus_priv->bounce_mem);
+        }
+#endif
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+        if (whd_driver->bus_priv->async_ready == WHD_TRUE)
+        {
+            (void)cy_rtos_deinit_semaphore(&whd_driver->bus_priv->async_semaphore);
+            (void)cy_rtos_deinit_semaphore(&whd_driver->bus_priv->async_mutex);
+        }
+#endif
         whd_mem_free(whd_driver->bus_priv);
         whd_driver->bus_priv = NULL;
     }
@@ -269,6 +399,9 @@ whd_result_t whd_bus_sdio_wait_for_wlan_event(whd_driver_t whd_driver, cy_semaph
         }
     }
 
+    /* The WHD thread may have to wake up on its own, e.g. to time out an asynchronous IOCTL */
+    timeout_ms = MIN_OF(timeout_ms, whd_driver->thread_info.max_sleep_ms);
+
     /* Check if we have run out of bus credits */
     if ( (whd_sdpcm_has_tx_packet(whd_driver) == WHD_TRUE) && (whd_sdpcm_get_available_credits(whd_driver) == 0) )
     {
@@ -290,24 +423,35 @@ whd_result_t whd_bus_sdio_wait_for_wlan_event(whd_driver_t whd_driver, cy_semaph
 }
 
 /* Device data transfer functions */
+/* The buffer stays on the bus until whd_bus_sdio_send_buffer_done() is called, so the
+ * caller can prepare the next frame while this one is transferred */
 whd_result_t whd_bus_sdio_send_buffer(whd_driver_t whd_driver, whd_buffer_t buffer)
+{
+    return whd_bus_transfer_async(whd_driver, BUS_WRITE, WLAN_FUNCTION, 0,
+                                  (uint16_t)(whd_buffer_get_current_piece_size(whd_driver,
+                                                                               buffer) - sizeof(whd_buffer_t) ),
+                                  (whd_transfer_bytes_packet_t *)(whd_buffer_get_current_piece_data_pointer(whd_driver,
+                                                                                                            buffer) +
+                                                                  sizeof(whd_buffer_t) ),
+                                  whd_bus_sdio_send_buffer_done, buffer);
+}
+
+/* Runs in whichever thread waits for the transfer, the WHD thread picks up the rest in whd_sdpcm_tx_complete() */
+static void whd_bus_sdio_send_buffer_done(whd_driver_t whd_driver, void *arg, whd_result_t result)
 {
     whd_result_t retval;
-    retval =
-        whd_bus_transfer_bytes(whd_driver, BUS_WRITE, WLAN_FUNCTION, 0,
-                               (uint16_t)(whd_buffer_get_current_piece_size(whd_driver,
-                                                                            buffer) - sizeof(whd_buffer_t) ),
-                               (whd_transfer_bytes_packet_t *)(whd_buffer_get_current_piece_data_pointer(whd_driver,
-                                                                                                         buffer) +
-                                                               sizeof(whd_buffer_t) ) );
-    CHECK_RETURN(whd_buffer_release(whd_driver, buffer, WHD_NETWORK_TX) );
-    if (retval == WHD_SUCCESS)
+
+    if (result != WHD_SUCCESS)
     {
-        DELAYED_BUS_RELEASE_SCHEDULE(whd_driver, WHD_TRUE);
+        WPRINT_WHD_ERROR( ("TX transfer failed with %" PRIu32 "\n", result) );
     }
-    CHECK_RETURN (retval);
 
-    return WHD_SUCCESS;
+    whd_sdpcm_tx_buffer_done(whd_driver, (whd_buffer_t)arg, result);
+    retval = whd_buffer_release(whd_driver, (whd_buffer_t)arg, WHD_NETWORK_TX);
+    if (retval != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("Could not release TX buffer, %s failed at %d \n", __func__, __LINE__) );
+    }
 }
 
 #ifdef BUS_ENC
@@ -392,14 +536,7 @@ whd_result_t whd_bus_sdio_init(whd_driver_t whd_driver)
 
     CHECK_RETURN(result);
 
-    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_BLKSIZE_0,   (uint8_t)1,
-                                              (uint32_t)SDIO_64B_BLOCK) );
-    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F1BLKSIZE_0, (uint8_t)1,
-                                              (uint32_t)SDIO_64B_BLOCK) );
-    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F2BLKSIZE_0, (uint8_t)1,
-                                              (uint32_t)SDIO_64B_BLOCK) );
-    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F2BLKSIZE_1, (uint8_t)1,
-                                              (uint32_t)0) );                                                                                  /* Function 2 = 64 */
+    CHECK_RETURN(whd_bus_sdio_set_block_size(whd_driver) );
 
     /* Register interrupt handler*/
     whd_bus_sdio_irq_register(whd_driver);
@@ -518,7 +655,7 @@ whd_result_t whd_bus_sdio_init(whd_driver_t whd_driver)
         CHECK_RETURN(whd_bus_read_backplane_value(whd_driver, reg_addr, 4, (uint8_t *)&chip_data) );
         chip_id = chip_data & 0x0000ffff;
         chip_rev = (chip_data & 0x000f0000) >> 16;
-        whd_chip_set_chip_id(whd_driver, (uint16_t)chip_id);
+        CHECK_RETURN(whd_chip_set_chip_id(whd_driver, (uint16_t)chip_id) );
         whd_chip_set_chiprev_id(whd_driver, (uint8_t)chip_rev);
         WPRINT_MACRO( ("chip ID: %d, chip rev: %d, Support ChipId Read from SDIO Core \n", (uint16_t) chip_id, (uint8_t)chip_rev) );
     }
@@ -526,7 +663,7 @@ whd_result_t whd_bus_sdio_init(whd_driver_t whd_driver)
     {
         /* Read the chip id */
         CHECK_RETURN(whd_bus_read_backplane_value(whd_driver, CHIPCOMMON_BASE_ADDRESS, 2, (uint8_t *)&chip_id) );
-        whd_chip_set_chip_id(whd_driver, (uint16_t)chip_id);
+        CHECK_RETURN(whd_chip_set_chip_id(whd_driver, (uint16_t)chip_id) );
         whd_chip_set_chiprev_id(whd_driver, (uint8_t)chip_rev);
         WPRINT_WHD_INFO( ("chip ID: %d \n", (uint16_t)chip_id) );
     }
@@ -545,7 +682,7 @@ whd_result_t whd_bus_sdio_init(whd_driver_t whd_driver)
 
     /* Read the chip id */
     CHECK_RETURN(whd_bus_read_backplane_value(whd_driver, CHIPCOMMON_BASE_ADDRESS, 2, (uint8_t *)&chip_id) );
-    whd_chip_set_chip_id(whd_driver, chip_id);
+    CHECK_RETURN(whd_chip_set_chip_id(whd_driver, chip_id) );
     WPRINT_WHD_INFO( ("chip ID: %d \n", chip_id) );
 
 #endif
@@ -636,6 +773,11 @@ whd_result_t whd_bus_sdio_deinit(whd_driver_t whd_driver)
         whd_driver->aligned_addr = NULL;
     }
 
+    whd_bus_sdio_rx_glom_flush(whd_driver);
+    whd_driver->bus_priv->rx_next_len = 0;
+
+    (void)whd_bus_transfer_wait(whd_driver);
+
     CHECK_RETURN(whd_bus_sdio_deinit_oob_intr(whd_driver) );
 
     whd_bus_sdio_irq_enable(whd_driver, WHD_FALSE);
@@ -691,6 +833,7 @@ uint32_t whd_bus_sdio_packet_available_to_read(whd_driver_t whd_driver)
     uint32_t hmb_data = 0;
     uint8_t error_type = 0;
     whd_bt_dev_t btdev = whd_driver->bt_dev;
+    whd_bus_reg_batch_t batch;
 #ifdef CYCFG_ULP_SUPPORT_ENABLED
     uint16_t wlan_chip_id;
     wlan_chip_id = whd_chip_get_chip_id(whd_driver);
@@ -708,9 +851,12 @@ uint32_t whd_bus_sdio_packet_available_to_read(whd_driver_t whd_driver)
         return WHD_BUS_FAIL;
     }
 
+    /* The interrupt clears are written together once the status is handled */
+    whd_bus_reg_batch_init(&batch);
+
     if ( (I_HMB_HOST_INT & int_status) != 0 )
     {
-        /* Read mailbox data and ack that we did so */
+        /* Read mailbox data and ack that we did so, before anything reacts to it */
         if ((whd_bus_read_backplane_value(whd_driver,  SDIO_TO_HOST_MAILBOX_DATA(whd_driver), 4,
                                          (uint8_t *)&hmb_data) == WHD_SUCCESS) && (hmb_data > 0))
             if (whd_bus_write_backplane_value(whd_driver, SDIO_TO_SB_MAILBOX(whd_driver), (uint8_t)4,
@@ -749,25 +895,15 @@ uint32_t whd_bus_sdio_packet_available_to_read(whd_driver_t whd_driver)
             }
         }
 
-        if (whd_bus_write_backplane_value(whd_driver, (uint32_t)SDIO_INT_STATUS(whd_driver), (uint8_t)4,
-                            (int_status & I_HMB_HOST_INT)) != WHD_SUCCESS)
-        {
-            WPRINT_WHD_ERROR( ("%s: Error clearing interrupts\n", __FUNCTION__) );
-            int_status = 0;
-            goto exit;
-        }
+        (void)whd_bus_reg_batch_clear(&batch, (uint32_t)SDIO_INT_STATUS(whd_driver), (uint8_t)4,
+                                      (int_status & I_HMB_HOST_INT) );
         int_status &= ~I_HMB_HOST_INT;
 
         if ((int_status & I_HMB_FC_STATE) != 0 )
         {
             WPRINT_WHD_DEBUG(("Dongle reports I_HMB_FC_STATE\n"));
-            if (whd_bus_write_backplane_value(whd_driver, (uint32_t)SDIO_INT_STATUS(whd_driver), (uint8_t)4,
-                          (int_status & I_HMB_FC_STATE)) != WHD_SUCCESS)
-            {
-                WPRINT_WHD_ERROR( ("%s: Error clearing interrupts\n", __FUNCTION__) );
-                int_status = 0;
-                goto exit;
-            }
+            (void)whd_bus_reg_batch_clear(&batch, (uint32_t)SDIO_INT_STATUS(whd_driver), (uint8_t)4,
+                                          (int_status & I_HMB_FC_STATE) );
             int_status &= ~I_HMB_FC_STATE;
        }
 #endif	/* CYCFG_ULP_SUPPORT_ENABLED */
@@ -786,15 +922,16 @@ uint32_t whd_bus_sdio_packet_available_to_read(whd_driver_t whd_driver)
     if ( (HOSTINTMASK & int_status) != 0 )
     {
         /* Clear any interrupts */
-        if (whd_bus_write_backplane_value(whd_driver, (uint32_t)SDIO_INT_STATUS(whd_driver), (uint8_t)4,
-                                          int_status & HOSTINTMASK) != WHD_SUCCESS)
-        {
-            WPRINT_WHD_ERROR( ("%s: Error clearing interrupts\n", __FUNCTION__) );
-            int_status = 0;
-            goto exit;
-        }
+        (void)whd_bus_reg_batch_clear(&batch, (uint32_t)SDIO_INT_STATUS(whd_driver), (uint8_t)4,
+                                      int_status & HOSTINTMASK);
     }
-exit:
+
+    if (whd_bus_reg_batch_execute(whd_driver, &batch) != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("%s: Error clearing interrupts\n", __FUNCTION__) );
+        int_status = 0;
+    }
+
     return ( (int_status) & (FRAME_AVAILABLE_MASK) );
 }
 
@@ -809,14 +946,38 @@ whd_result_t whd_bus_sdio_read_frame(whd_driver_t whd_driver, whd_buffer_t *buff
 {
     uint16_t hwtag[8];
     uint16_t extra_space_required;
+    uint16_t next_len;
     whd_result_t result;
     uint8_t *data = NULL;
 
     *buffer = NULL;
 
+    /* Hand out the subframes of the last superframe before reading anything new */
+    if (whd_driver->bus_priv->rx_glom_head != NULL)
+    {
+        *buffer = whd_bus_sdio_rx_glom_dequeue(whd_driver);
+        return WHD_SUCCESS;
+    }
+
     /* Ensure the wlan backplane bus is up */
     CHECK_RETURN(whd_ensure_wlan_bus_is_up(whd_driver) );
 
+    /* Read header and payload in one go when the previous header announced the length */
+    next_len = whd_driver->bus_priv->rx_next_len;
+    whd_driver->bus_priv->rx_next_len = 0;
+    if (next_len != 0)
+    {
+        result = whd_bus_sdio_read_frame_lookahead(whd_driver, next_len, buffer);
+        if (result != WHD_PENDING)
+        {
+            if ( (result != WHD_SUCCESS) || (*buffer == NULL) )
+            {
+                return result;
+            }
+            return whd_bus_sdio_read_frame_done(whd_driver, buffer);
+        }
+    }
+
     /* Read the frame header and verify validity */
     whd_mem_memset(hwtag, 0, sizeof(hwtag) );
 
@@ -848,6 +1009,7 @@ whd_result_t whd_bus_sdio_read_frame(whd_driver_t whd_driver, whd_buffer_t *buff
             return WHD_SDIO_RX_FAIL;
         }
         whd_sdpcm_update_credit(whd_driver, (uint8_t *)hwtag);
+        whd_bus_sdio_set_rx_next_len(whd_driver, (uint8_t *)hwtag);
         return WHD_SUCCESS;
     }
 
@@ -862,9 +1024,9 @@ whd_result_t whd_bus_sdio_read_frame(whd_driver_t whd_driver, whd_buffer_t *buff
     }
 
     /* Allocate a suitable buffer */
-    result = whd_host_buffer_get(whd_driver, buffer, WHD_NETWORK_RX,
-                                 (uint16_t)(INITIAL_READ + extra_space_required + sizeof(whd_buffer_header_t) ),
-                                 (whd_sdpcm_has_tx_packet(whd_driver) ? 0 : WHD_RX_BUF_TIMEOUT) );
+    result = whd_bus_rx_buffer_get(whd_driver, buffer,
+                                   (uint16_t)(INITIAL_READ + extra_space_required + sizeof(whd_buffer_header_t) ),
+                                   (whd_sdpcm_has_tx_packet(whd_driver) ? 0 : WHD_RX_BUF_TIMEOUT) );
     if (result != WHD_SUCCESS)
     {
         /* Read out the first 12 bytes to get the bus credit information, 4 bytes are already read in hwtag */
@@ -897,9 +1059,8 @@ whd_result_t whd_bus_sdio_read_frame(whd_driver_t whd_driver, whd_buffer_t *buff
     {
         data = whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer);
         CHECK_PACKET_NULL(data, WHD_NO_REGISTER_FUNCTION_POINTER);
-        result = whd_bus_sdio_transfer(whd_driver, BUS_READ, WLAN_FUNCTION, 0, extra_space_required,
-                                       data + sizeof(whd_buffer_header_t) +
-                                       INITIAL_READ, RESPONSE_NEEDED);
+        result = whd_bus_sdio_read_packet(whd_driver, extra_space_required,
+                                          data + sizeof(whd_buffer_header_t) + INITIAL_READ);
 
         if (result != WHD_SUCCESS)
         {
@@ -909,10 +1070,376 @@ whd_result_t whd_bus_sdio_read_frame(whd_driver_t whd_driver, whd_buffer_t *buff
             return WHD_SDIO_RX_FAIL;
         }
     }
+
+
+    return whd_bus_sdio_read_frame_done(whd_driver, buffer);
+}
+
+/** Reads a whole frame whose length was announced by the previous SDPCM header
+ *
+ *  One transfer of read_len bytes fetches frametag, header and payload. If the announced
+ *  length turns out to be too short, the rest of the frame is read into a right-sized buffer.
+ *
+ * @param read_len : The announced length of the frame
+ * @param buffer   : Receives the frame, NULL if it was only a credit update
+ *
+ * @return WHD_PENDING if the two step read has to be used instead, otherwise WHD result code
+ */
+static whd_result_t whd_bus_sdio_read_frame_lookahead(whd_driver_t whd_driver, uint16_t read_len,
+                                                      whd_buffer_t *buffer)
+{
+    whd_buffer_t frame_buffer;
+    uint16_t hwtag[2];
+    uint8_t *data;
+    uint8_t *frame_data;
+    whd_result_t result;
+
+    result = whd_bus_rx_buffer_get(whd_driver, buffer,
+                                   (uint16_t)(read_len + sizeof(whd_buffer_header_t) ),
+                                   (whd_sdpcm_has_tx_packet(whd_driver) ? 0 : WHD_RX_BUF_TIMEOUT) );
+    if (result != WHD_SUCCESS)
+    {
+        *buffer = NULL;
+        return WHD_PENDING;
+    }
+    data = whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer);
+    CHECK_PACKET_NULL(data, WHD_NO_REGISTER_FUNCTION_POINTER);
+
+    result = whd_bus_sdio_read_packet(whd_driver, read_len, data + sizeof(whd_buffer_header_t) );
+    if (result != WHD_SUCCESS)
+    {
+        (void)whd_bus_sdio_abort_read(whd_driver, WHD_FALSE);     /* ignore return - not much can be done if this fails */
+        CHECK_RETURN(whd_buffer_release(whd_driver, *buffer, WHD_NETWORK_RX) );
+        *buffer = NULL;
+        WPRINT_WHD_ERROR( ("Error during SDIO receive, %s failed at %d \n", __func__, __LINE__) );
+        return WHD_SDIO_RX_FAIL;
+    }
+
+    whd_mem_memcpy(hwtag, data + sizeof(whd_buffer_header_t), sizeof(hwtag) );
+    hwtag[0] = dtoh16(hwtag[0]);
+    hwtag[1] = dtoh16(hwtag[1]);
+    if ( ( (hwtag[0] | hwtag[1]) == 0 ) ||
+         ( (hwtag[0] ^ hwtag[1]) != (uint16_t)0xFFFF ) || (hwtag[0] < SDPCM_FRAMETAG_LEN + SDPCM_SWHEADER_LEN) )
+    {
+        WHD_BUS_STATS_INCREMENT_VARIABLE(whd_driver->bus_priv, rx_nextlen_miss);
+        if ( (hwtag[0] | hwtag[1]) != 0 )
+        {
+            (void)whd_bus_sdio_abort_read(whd_driver, WHD_FALSE);    /* ignore return - not much can be done if this fails */
+        }
+        CHECK_RETURN(whd_buffer_release(whd_driver, *buffer, WHD_NETWORK_RX) );
+        *buffer = NULL;
+        return WHD_HWTAG_MISMATCH;
+    }
+
+    if (hwtag[0] <= read_len)
+    {
+        WHD_BUS_STATS_INCREMENT_VARIABLE(whd_driver->bus_priv, rx_nextlen_hit);
+
+        if ( (hwtag[0] == (uint16_t)(SDPCM_FRAMETAG_LEN + SDPCM_SWHEADER_LEN) ) &&
+             (whd_driver->internal_info.whd_wlan_status.state == WLAN_UP) )
+        {
+            /* Credit update only */
+            whd_sdpcm_update_credit(whd_driver, data + sizeof(whd_buffer_header_t) );
+            whd_bus_sdio_set_rx_next_len(whd_driver, data + sizeof(whd_buffer_header_t) );
+            CHECK_RETURN(whd_buffer_release(whd_driver, *buffer, WHD_NETWORK_RX) );
+            *buffer = NULL;
+            return WHD_SUCCESS;
+        }
+
+        return whd_buffer_set_size(whd_driver, *buffer, (uint16_t)(hwtag[0] + sizeof(whd_buffer_header_t) ) );
+    }
+
+    /* The announced length was too short, move what was read into a buffer that fits the frame */
+    WHD_BUS_STATS_INCREMENT_VARIABLE(whd_driver->bus_priv, rx_nextlen_miss);
+    result = whd_bus_rx_buffer_get(whd_driver, &frame_buffer,
+                                   (uint16_t)(hwtag[0] + sizeof(whd_buffer_header_t) ),
+                                   (whd_sdpcm_has_tx_packet(whd_driver) ? 0 : WHD_RX_BUF_TIMEOUT) );
+    if (result != WHD_SUCCESS)
+    {
+        result = whd_bus_sdio_abort_read(whd_driver, WHD_FALSE);
+        whd_assert("Read-abort failed", result == WHD_SUCCESS);
+        REFERENCE_DEBUG_ONLY_VARIABLE(result);
+
+        whd_sdpcm_update_credit(whd_driver, data + sizeof(whd_buffer_header_t) );
+        CHECK_RETURN(whd_buffer_release(whd_driver, *buffer, WHD_NETWORK_RX) );
+        *buffer = NULL;
+        WPRINT_WHD_ERROR( ("Failed to allocate a buffer to receive into, %s failed at %d \n", __func__, __LINE__) );
+        return WHD_RX_BUFFER_ALLOC_FAIL;
+    }
+    frame_data = whd_buffer_get_current_piece_data_pointer(whd_driver, frame_buffer);
+    CHECK_PACKET_NULL(frame_data, WHD_NO_REGISTER_FUNCTION_POINTER);
+    whd_mem_memcpy(frame_data + sizeof(whd_buffer_header_t), data + sizeof(whd_buffer_header_t), read_len);
+    CHECK_RETURN(whd_buffer_release(whd_driver, *buffer, WHD_NETWORK_RX) );
+    *buffer = frame_buffer;
+
+    result = whd_bus_sdio_read_packet(whd_driver, (uint16_t)(hwtag[0] - read_len),
+                                      frame_data + sizeof(whd_buffer_header_t) + read_len);
+    if (result != WHD_SUCCESS)
+    {
+        (void)whd_bus_sdio_abort_read(whd_driver, WHD_FALSE);     /* ignore return - not much can be done if this fails */
+        CHECK_RETURN(whd_buffer_release(whd_driver, *buffer, WHD_NETWORK_RX) );
+        *buffer = NULL;
+        WPRINT_WHD_ERROR( ("Error during SDIO receive, %s failed at %d \n", __func__, __LINE__) );
+        return WHD_SDIO_RX_FAIL;
+    }
+
+    return WHD_SUCCESS;
+}
+
+/** Finishes a frame read by whd_bus_sdio_read_frame
+ *
+ *  Reads the superframe behind a glom descriptor and remembers the length of the next frame.
+ */
+static whd_result_t whd_bus_sdio_read_frame_done(whd_driver_t whd_driver, whd_buffer_t *buffer)
+{
+    uint8_t *data;
+    whd_result_t result;
+
+    data = whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer);
+    CHECK_PACKET_NULL(data, WHD_NO_REGISTER_FUNCTION_POINTER);
+    data += sizeof(whd_buffer_header_t);
+
+    if ( (uint16_t)(data[0] | (data[1] << 8) ) >= (uint16_t)(SDPCM_FRAMETAG_LEN + SDPCM_SWHEADER_LEN) )
+    {
+        /* A glom descriptor announces a superframe, which is read right behind it */
+        if ( (data[SDPCM_CHANNEL_OFFSET] & SDPCM_CHANNEL_MASK) == SDPCM_GLOM_CHANNEL )
+        {
+            result = whd_bus_sdio_read_glom(whd_driver, *buffer);
+            *buffer = whd_bus_sdio_rx_glom_dequeue(whd_driver);
+            CHECK_RETURN(result);
+        }
+        else
+        {
+            whd_bus_sdio_set_rx_next_len(whd_driver, data);
+        }
+    }
+
     DELAYED_BUS_RELEASE_SCHEDULE(whd_driver, WHD_TRUE);
     return WHD_SUCCESS;
 }
 
+/** Remembers the next frame length announced by an SDPCM header
+ *
+ * @param header : Points at the frametag of the received frame
+ */
+static void whd_bus_sdio_set_rx_next_len(whd_driver_t whd_driver, const uint8_t *header)
+{
+    uint16_t next_len = (uint16_t)(header[SDPCM_NEXTLEN_OFFSET] << SDIO_RX_NEXTLEN_SHIFT);
+
+    if ( (next_len < SDPCM_FRAMETAG_LEN + SDPCM_SWHEADER_LEN) || (next_len > SDIO_RX_NEXTLEN_MAX) )
+    {
+        next_len = 0;
+    }
+    whd_driver->bus_priv->rx_next_len = next_len;
+}
+
+/** Reads the superframe announced by a glom descriptor and splits it into subframes
+ *
+ *  The descriptor payload is a list of little endian 16-bit lengths, one per subframe.
+ *  The whole superframe is read with a single transfer. The first subframe is preceded
+ *  by the superframe header, whose frametag covers the whole superframe. Every subframe
+ *  is copied into its own buffer and queued for whd_bus_sdio_read_frame() to hand out.
+ *
+ * @param desc_buffer : The glom descriptor frame, released by this function
+ *
+ * @return WHD result code
+ */
+static whd_result_t whd_bus_sdio_read_glom(whd_driver_t whd_driver, whd_buffer_t desc_buffer)
+{
+    struct whd_bus_priv *bus_priv = whd_driver->bus_priv;
+    uint16_t glom_len[SDIO_RX_GLOM_MAX_FRAMES];
+    uint8_t *data;
+    uint8_t *subframe;
+    uint8_t *packet;
+    whd_buffer_t buffer;
+    uint16_t frame_len;
+    uint16_t sublen;
+    uint32_t total = 0;
+    uint16_t offset = 0;
+    uint16_t doffset;
+    uint8_t count;
+    uint8_t i;
+    whd_result_t result;
+
+    data = whd_buffer_get_current_piece_data_pointer(whd_driver, desc_buffer);
+    CHECK_PACKET_NULL(data, WHD_NO_REGISTER_FUNCTION_POINTER);
+    data += sizeof(whd_buffer_header_t);
+
+    /* Superframes are only sent behind a descriptor, anything else on the glom channel is garbage */
+    if ( (data[SDPCM_CHANNEL_OFFSET] & SDPCM_GLOMDESC_FLAG) == 0 )
+    {
+        WPRINT_WHD_ERROR( ("Glom channel frame without descriptor, %s failed at %d \n", __func__, __LINE__) );
+        WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, rx_glom_errors);
+        CHECK_RETURN(whd_buffer_release(whd_driver, desc_buffer, WHD_NETWORK_RX) );
+        return WHD_SDIO_RX_FAIL;
+    }
+
+    frame_len = (uint16_t)(data[0] | (data[1] << 8) );
+    doffset = data[SDPCM_DOFFSET_OFFSET];
+    count = 0;
+    if ( (doffset <= frame_len) && ( (frame_len - doffset) / sizeof(uint16_t) <= SDIO_RX_GLOM_MAX_FRAMES ) )
+    {
+        count = (uint8_t)( (frame_len - doffset) / sizeof(uint16_t) );
+    }
+    for (i = 0; i < count; i++)
+    {
+        glom_len[i] = (uint16_t)(data[doffset + 2 * i] | (data[doffset + 2 * i + 1] << 8) );
+        total += glom_len[i];
+        if ( (glom_len[i] < SDPCM_FRAMETAG_LEN + SDPCM_SWHEADER_LEN) || (total > SDIO_RX_GLOM_MAX_SIZE) )
+        {
+            count = 0;
+            break;
+        }
+    }
+    if (count == 0)
+    {
+        /* The superframe is still pending in the device, discard it along with the descriptor */
+        WPRINT_WHD_ERROR( ("Invalid glom descriptor, %s failed at %d \n", __func__, __LINE__) );
+        WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, rx_glom_errors);
+        whd_sdpcm_update_credit(whd_driver, data);
+        CHECK_RETURN(whd_buffer_release(whd_driver, desc_buffer, WHD_NETWORK_RX) );
+        (void)whd_bus_sdio_abort_read(whd_driver, WHD_FALSE);
+        return WHD_SDIO_RX_FAIL;
+    }
+
+    /* The descriptor carries credit and flow control like any other frame */
+    whd_sdpcm_update_credit(whd_driver, data);
+    CHECK_RETURN(whd_buffer_release(whd_driver, desc_buffer, WHD_NETWORK_RX) );
+
+    if (total > bus_priv->rx_glom_buffer_size)
+    {
+        if (bus_priv->rx_glom_buffer != NULL)
+        {
+            whd_mem_free(bus_priv->rx_glom_buffer);
+        }
+        bus_priv->rx_glom_buffer = (uint8_t *)whd_mem_malloc(total);
+        if (bus_priv->rx_glom_buffer == NULL)
+        {
+            bus_priv->rx_glom_buffer_size = 0;
+            (void)whd_bus_sdio_abort_read(whd_driver, WHD_FALSE);
+            WPRINT_WHD_ERROR( ("Could not allocate %lu bytes for RX superframe\n", (unsigned long)total) );
+            return WHD_RX_BUFFER_ALLOC_FAIL;
+        }
+        bus_priv->rx_glom_buffer_size = (uint16_t)total;
+    }
+    data = bus_priv->rx_glom_buffer;
+
+    result = whd_bus_sdio_transfer(whd_driver, BUS_READ, WLAN_FUNCTION, 0, (uint16_t)total, data,
+                                   RESPONSE_NEEDED);
+    if (result != WHD_SUCCESS)
+    {
+        (void)whd_bus_sdio_abort_read(whd_driver, WHD_FALSE);     /* ignore return - not much can be done if this fails */
+        WPRINT_WHD_ERROR( ("Error during SDIO receive, %s failed at %d \n", __func__, __LINE__) );
+        return WHD_SDIO_RX_FAIL;
+    }
+
+    /* Validate the superframe header */
+    frame_len = (uint16_t)(data[0] | (data[1] << 8) );
+    sublen = (uint16_t)(data[2] | (data[3] << 8) );
+    doffset = data[SDPCM_DOFFSET_OFFSET];
+    if ( ( (uint16_t)(frame_len ^ sublen) != (uint16_t)0xFFFF ) || (frame_len != total) ||
+         (doffset < SDPCM_FRAMETAG_LEN + SDPCM_SWHEADER_LEN) || (doffset >= glom_len[0]) )
+    {
+        WPRINT_WHD_ERROR( ("Invalid superframe header, %s failed at %d \n", __func__, __LINE__) );
+        WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, rx_glom_errors);
+        return WHD_HWTAG_MISMATCH;
+    }
+    whd_sdpcm_update_credit(whd_driver, data);
+    whd_bus_sdio_set_rx_next_len(whd_driver, data);
+    WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, rx_glom);
+
+    for (i = 0; i < count; offset = (uint16_t)(offset + glom_len[i]), i++)
+    {
+        subframe = data + offset;
+        frame_len = glom_len[i];
+        if (i == 0)
+        {
+            subframe += doffset;
+            frame_len = (uint16_t)(frame_len - doffset);
+        }
+
+        sublen = (uint16_t)(subframe[0] | (subframe[1] << 8) );
+        if ( ( (uint16_t)(sublen ^ (subframe[2] | (subframe[3] << 8) ) ) != (uint16_t)0xFFFF ) ||
+             (sublen > frame_len) || (sublen < SDPCM_FRAMETAG_LEN + SDPCM_SWHEADER_LEN) )
+        {
+            WPRINT_WHD_ERROR( ("Invalid subframe %u in superframe, dropping the rest\n", i) );
+            WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, rx_glom_errors);
+            break;
+        }
+
+        result = whd_bus_rx_buffer_get(whd_driver, &buffer,
+                                       (uint16_t)(sublen + sizeof(whd_buffer_header_t) ),
+                                       (whd_sdpcm_has_tx_packet(whd_driver) ? 0 : WHD_RX_BUF_TIMEOUT) );
+        if (result != WHD_SUCCESS)
+        {
+            WPRINT_WHD_ERROR( ("Failed to allocate a buffer for subframe %u, %s failed at %d \n", i, __func__,
+                               __LINE__) );
+            continue;
+        }
+        packet = whd_buffer_get_current_piece_data_pointer(whd_driver, buffer);
+        CHECK_PACKET_NULL(packet, WHD_NO_REGISTER_FUNCTION_POINTER);
+        whd_mem_memcpy(packet + sizeof(whd_buffer_header_t), subframe, sublen);
+
+        /* Queue the subframe, linked through the buffer header like the SDPCM send queue */
+        ( (whd_buffer_header_t *)packet )->queue_next = NULL;
+        if (bus_priv->rx_glom_tail != NULL)
+        {
+            packet = whd_buffer_get_current_piece_data_pointer(whd_driver, bus_priv->rx_glom_tail);
+            ( (whd_buffer_header_t *)packet )->queue_next = buffer;
+        }
+        else
+        {
+            bus_priv->rx_glom_head = buffer;
+        }
+        bus_priv->rx_glom_tail = buffer;
+        WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, rx_glom_frames);
+    }
+
+    return WHD_SUCCESS;
+}
+
+/** Pops the next subframe split out of a superframe
+ *
+ * @return The subframe buffer, or NULL if none is left
+ */
+static whd_buffer_t whd_bus_sdio_rx_glom_dequeue(whd_driver_t whd_driver)
+{
+    struct whd_bus_priv *bus_priv = whd_driver->bus_priv;
+    whd_buffer_t buffer = bus_priv->rx_glom_head;
+
+    if (buffer != NULL)
+    {
+        bus_priv->rx_glom_head =
+            ( (whd_buffer_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, buffer) )->queue_next;
+        if (bus_priv->rx_glom_head == NULL)
+        {
+            bus_priv->rx_glom_tail = NULL;
+        }
+    }
+
+    return buffer;
+}
+
+/** Drops any subframes not yet handed up and frees the superframe read buffer */
+static void whd_bus_sdio_rx_glom_flush(whd_driver_t whd_driver)
+{
+    struct whd_bus_priv *bus_priv = whd_driver->bus_priv;
+    whd_buffer_t buffer;
+
+    while ( (buffer = whd_bus_sdio_rx_glom_dequeue(whd_driver) ) != NULL )
+    {
+        if (whd_buffer_release(whd_driver, buffer, WHD_NETWORK_RX) != WHD_SUCCESS)
+            WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
+    }
+
+    if (bus_priv->rx_glom_buffer != NULL)
+    {
+        whd_mem_free(bus_priv->rx_glom_buffer);
+        bus_priv->rx_glom_buffer = NULL;
+        bus_priv->rx_glom_buffer_size = 0;
+    }
+}
+
 /******************************************************
 *     Function definitions for Protocol Common
 ******************************************************/
@@ -928,10 +1455,8 @@ whd_result_t whd_bus_sdio_write_backplane_value(whd_driver_t whd_driver, uint32_
     if (register_length == 4)
         address |= SBSDIO_SB_ACCESS_2_4B_FLAG;
 
-    CHECK_RETURN(whd_bus_sdio_transfer(whd_driver, BUS_WRITE, BACKPLANE_FUNCTION, address, register_length,
-                                       (uint8_t *)&value, RESPONSE_NEEDED) );
-
-    return whd_bus_set_backplane_window(whd_driver, CHIPCOMMON_BASE_ADDRESS);
+    return whd_bus_sdio_transfer(whd_driver, BUS_WRITE, BACKPLANE_FUNCTION, address, register_length,
+                                 (uint8_t *)&value, RESPONSE_NEEDED);
 }
 
 whd_result_t whd_bus_sdio_read_backplane_value(whd_driver_t whd_driver, uint32_t address, uint8_t register_length,
@@ -945,10 +1470,44 @@ whd_result_t whd_bus_sdio_read_backplane_value(whd_driver_t whd_driver, uint32_t
     if (register_length == 4)
         address |= SBSDIO_SB_ACCESS_2_4B_FLAG;
 
-    CHECK_RETURN(whd_bus_sdio_transfer(whd_driver, BUS_READ, BACKPLANE_FUNCTION, address, register_length, value,
-                                       RESPONSE_NEEDED) );
+    return whd_bus_sdio_transfer(whd_driver, BUS_READ, BACKPLANE_FUNCTION, address, register_length, value,
+                                 RESPONSE_NEEDED);
+}
+
+/** Executes a register batch
+ *
+ *  The window is only moved when an operation is outside the current one.
+ */
+static whd_result_t whd_bus_sdio_reg_batch_execute(whd_driver_t whd_driver, whd_bus_reg_batch_t *batch)
+{
+    whd_result_t result = WHD_SUCCESS;
+    whd_bus_reg_op_t *op;
+    uint32_t address;
+    uint32_t value;
+    uint8_t i;
+
+    for (i = 0; (i < batch->count) && (result == WHD_SUCCESS); i++)
+    {
+        op = &batch->ops[i];
+
+        result = whd_bus_set_backplane_window(whd_driver, op->address);
+        if (result != WHD_SUCCESS)
+        {
+            break;
+        }
+
+        address = op->address & SBSDIO_SB_OFT_ADDR_MASK;
+        if (op->length == 4)
+            address |= SBSDIO_SB_ACCESS_2_4B_FLAG;
 
-    return whd_bus_set_backplane_window(whd_driver, CHIPCOMMON_BASE_ADDRESS);
+        WHD_BUS_STATS_INCREMENT_VARIABLE(whd_driver->bus_priv, reg_batch_xfers);
+        value = op->value;
+        result = whd_bus_sdio_transfer(whd_driver, BUS_WRITE, BACKPLANE_FUNCTION, address, op->length,
+                                       (uint8_t *)&value, RESPONSE_NEEDED);
+    }
+    WHD_BUS_STATS_ADD_VARIABLE(whd_driver->bus_priv, reg_batch_ops, batch->count);
+
+    return result;
 }
 
 whd_result_t whd_bus_sdio_write_register_value(whd_driver_t whd_driver, whd_bus_function_t function, uint32_t address,
@@ -968,10 +1527,101 @@ whd_result_t whd_bus_sdio_transfer_bytes(whd_driver_t whd_driver, whd_bus_transf
     ENABLE_COMPILER_WARNING(diag_suppress = Pa039)
 }
 
-/******************************************************
-*             Static  Function definitions
-******************************************************/
-
+/******************************************************
+*             Static  Function definitions
+******************************************************/
+
+/** Reads frame data from F2 into a packet buffer from whd_bus_rx_buffer_get()
+ *
+ *  When the buffer interface guarantees cache line aligned and padded packet buffers, the
+ *  cache lines the data ends in belong to the buffer, so cmd53 can DMA into it directly.
+ */
+static whd_result_t whd_bus_sdio_read_packet(whd_driver_t whd_driver, uint16_t data_size, uint8_t *data)
+{
+    whd_result_t result;
+#if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    uint32_t alignment = whd_buffer_get_alignment(whd_driver);
+
+    whd_driver->bus_priv->rx_buffer_dma = ( (alignment != 0) && (alignment % DCACHE_BYTE_ALIGNEMNT == 0) ) ?
+                                          WHD_TRUE : WHD_FALSE;
+#endif
+
+    result = whd_bus_sdio_transfer(whd_driver, BUS_READ, WLAN_FUNCTION, 0, data_size, data, RESPONSE_NEEDED);
+
+#if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    whd_driver->bus_priv->rx_buffer_dma = WHD_FALSE;
+#endif
+    return result;
+}
+
+/** Programs the F1 and F2 block sizes to the size the host controller is configured for
+ *
+ *  Both functions are read back, if either did not take the requested size both fall back
+ *  to 64 byte blocks.
+ */
+static whd_result_t whd_bus_sdio_set_block_size(whd_driver_t whd_driver)
+{
+    struct whd_bus_priv *bus_priv = whd_driver->bus_priv;
+    uint16_t block_size = bus_priv->sdio_config.sdio_block_size;
+    uint16_t max_block_count = bus_priv->sdio_config.sdio_max_block_count;
+    uint8_t size_lo = 0;
+    uint8_t size_hi = 0;
+    uint16_t f1_size;
+    uint16_t f2_size;
+
+    if ( (block_size == 0) || (block_size > (uint16_t)SDIO_512B_BLOCK) || ( (block_size & (block_size - 1) ) != 0 ) )
+    {
+        if (block_size != 0)
+        {
+            WPRINT_WHD_ERROR( ("Unsupported SDIO block size %u, using %u\n", (unsigned int)block_size,
+                               (unsigned int)SDIO_64B_BLOCK) );
+        }
+        block_size = (uint16_t)SDIO_64B_BLOCK;
+    }
+
+    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_BLKSIZE_0,   (uint8_t)1,
+                                              (uint32_t)SDIO_64B_BLOCK) );
+    do
+    {
+        CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F1BLKSIZE_0, (uint8_t)1,
+                                                  (uint32_t)(block_size & 0xFF) ) );
+        CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F1BLKSIZE_1, (uint8_t)1,
+                                                  (uint32_t)(block_size >> 8) ) );
+        CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F2BLKSIZE_0, (uint8_t)1,
+                                                  (uint32_t)(block_size & 0xFF) ) );
+        CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F2BLKSIZE_1, (uint8_t)1,
+                                                  (uint32_t)(block_size >> 8) ) );
+
+        CHECK_RETURN(whd_bus_read_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F1BLKSIZE_0, (uint8_t)1,
+                                                 &size_lo) );
+        CHECK_RETURN(whd_bus_read_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F1BLKSIZE_1, (uint8_t)1,
+                                                 &size_hi) );
+        f1_size = (uint16_t)(size_lo | (size_hi << 8) );
+        CHECK_RETURN(whd_bus_read_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F2BLKSIZE_0, (uint8_t)1,
+                                                 &size_lo) );
+        CHECK_RETURN(whd_bus_read_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F2BLKSIZE_1, (uint8_t)1,
+                                                 &size_hi) );
+        f2_size = (uint16_t)(size_lo | (size_hi << 8) );
+        if ( ( (f1_size == block_size) && (f2_size == block_size) ) || (block_size == (uint16_t)SDIO_64B_BLOCK) )
+        {
+            break;
+        }
+        WPRINT_WHD_ERROR( ("Device rejected SDIO block size %u (F1 %u, F2 %u), using %u\n",
+                           (unsigned int)block_size, (unsigned int)f1_size, (unsigned int)f2_size,
+                           (unsigned int)SDIO_64B_BLOCK) );
+        block_size = (uint16_t)SDIO_64B_BLOCK;
+    } while (1);
+
+    if ( (max_block_count == 0) || (max_block_count > SDIO_CMD53_MAX_BLOCK_COUNT) )
+    {
+        max_block_count = SDIO_CMD53_MAX_BLOCK_COUNT;
+    }
+    bus_priv->block_size = block_size;
+    bus_priv->max_block_count = max_block_count;
+
+    return WHD_SUCCESS;
+}
+
 static whd_result_t whd_bus_sdio_transfer(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
                                           whd_bus_function_t function, uint32_t address, uint16_t data_size,
                                           uint8_t *data, sdio_response_needed_t response_expected)
@@ -981,8 +1631,11 @@ static whd_result_t whd_bus_sdio_transfer(whd_driver_t whd_driver, whd_bus_trans
      * and preserves the original behavior.
      */
     whd_result_t result = WHD_SUCCESS;
+    uint16_t block_size = whd_driver->bus_priv->block_size;
+    uint32_t max_blk_size = (uint32_t)block_size * whd_driver->bus_priv->max_block_count;
     uint16_t data_byte_size;
     uint16_t data_blk_size;
+    uint16_t chunk_size;
 
     if (data_size == 0)
     {
@@ -993,28 +1646,30 @@ static whd_result_t whd_bus_sdio_transfer(whd_driver_t whd_driver, whd_bus_trans
         return whd_bus_sdio_cmd52(whd_driver, direction, function, address, *data, response_expected, data);
     }
 #if !defined(COMPONENT_MTB_HAL)
-    else if (whd_driver->internal_info.whd_wlan_status.state == WLAN_UP)
+    else if ( (whd_driver->internal_info.whd_wlan_status.state == WLAN_UP) && (data_size <= max_blk_size) )
     {
         return whd_bus_sdio_cmd53(whd_driver, direction, function,
-                                  (data_size >= (uint16_t)64) ? SDIO_BLOCK_MODE : SDIO_BYTE_MODE, address, data_size,
+                                  (data_size >= block_size) ? SDIO_BLOCK_MODE : SDIO_BYTE_MODE, address, data_size,
                                   data, response_expected, NULL);
     }
 #endif
     else
     {
-        /* We need to handle remaining size for source image download */
-        data_byte_size = data_size % SDIO_64B_BLOCK;
+        /* Send whole blocks in as few CMD53s as the host allows, then the remainder in byte mode */
+        data_byte_size = data_size % block_size;
         data_blk_size = data_size - data_byte_size;
-        if (data_blk_size != 0)
+        while (data_blk_size != 0)
         {
+            chunk_size = (uint16_t)MIN_OF(data_blk_size, max_blk_size);
             result = whd_bus_sdio_cmd53(whd_driver, direction, function, SDIO_BLOCK_MODE, address,
-                                        data_blk_size, data, response_expected, NULL);
+                                        chunk_size, data, response_expected, NULL);
             if (result != WHD_SUCCESS)
             {
                 return result;
             }
-            data += data_blk_size;
-            address += data_blk_size;
+            data += chunk_size;
+            address += chunk_size;
+            data_blk_size = (uint16_t)(data_blk_size - chunk_size);
         }
         if (data_byte_size)
         {
@@ -1033,6 +1688,11 @@ whd_result_t whd_bus_sdio_cmd52(whd_driver_t whd_driver, whd_bus_transfer_direct
     uint32_t sdio_response = 0;
     whd_result_t result;
     sdio_cmd_argument_t arg;
+
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+    CHECK_RETURN(whd_bus_sdio_transfer_wait(whd_driver) );
+#endif
+
     arg.value = 0;
     arg.cmd52.function_number = (uint32_t)(function & BUS_FUNCTION_MASK);
     arg.cmd52.register_address = (uint32_t)(address & 0x00001ffff);
@@ -1065,53 +1725,76 @@ whd_result_t whd_bus_sdio_cmd53(whd_driver_t whd_driver, whd_bus_transfer_direct
                                        uint16_t data_size, uint8_t *data,
                                        sdio_response_needed_t response_expected, uint32_t *response)
 {
-    sdio_cmd_argument_t arg;
+    uint32_t arg;
     whd_result_t result = WHD_SUCCESS;
     uint8_t *aligned_local_buffer = data;
 #if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    struct whd_bus_priv *bus_priv = whd_driver->bus_priv;
     bool iscacheable = false;
     uint8_t *local_buffer = NULL;
 #endif
 
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+    CHECK_RETURN(whd_bus_sdio_transfer_wait(whd_driver) );
+#endif
+
     if (direction == BUS_WRITE)
     {
         WHD_BUS_STATS_INCREMENT_VARIABLE(whd_driver->bus_priv, cmd53_write);
     }
 
-    arg.value = 0;
-    arg.cmd53.function_number = (uint32_t)(function & BUS_FUNCTION_MASK);
-    arg.cmd53.register_address = (uint32_t)(address & BIT_MASK(17) );
-    arg.cmd53.op_code = (uint32_t)1;
-    arg.cmd53.rw_flag = (uint32_t)( (direction == BUS_WRITE) ? 1 : 0 );
+    if (mode == SDIO_BYTE_MODE)
+    {
+        whd_assert("whd_bus_sdio_cmd53: data_size > 512 for byte mode", (data_size <= (uint16_t )512) );
+    }
+    arg = whd_bus_sdio_cmd53_argument(whd_driver, direction, function, mode, address, data_size);
 
 #if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
-    if(Cy_Syslib_IsMemCacheable(MPU, (uint32_t)data, data_size) && ((size_t)data % DCACHE_BYTE_ALIGNEMNT != 0 || (size_t)data_size % DCACHE_BYTE_ALIGNEMNT != 0) )
+    /* DMA must not share cache lines with other data: bounce unless the buffer is aligned and
+     * either ends on a cache line or is a packet buffer that owns the rest of its last line */
+    if (Cy_Syslib_IsMemCacheable(MPU, (uint32_t)data, data_size) )
     {
-        local_buffer = (uint8_t *)whd_mem_malloc(data_size + (2*DCACHE_BYTE_ALIGNEMNT));
-        if (NULL == local_buffer)
+        if ( ( (size_t)data % DCACHE_BYTE_ALIGNEMNT == 0 ) &&
+             ( ( (size_t)data_size % DCACHE_BYTE_ALIGNEMNT == 0 ) || (bus_priv->rx_buffer_dma == WHD_TRUE) ) )
         {
-            WPRINT_WHD_ERROR( ("%s:%d whd_mem_malloc failed\n", __func__, __LINE__) );
-            goto done;
+            WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, cmd53_direct);
         }
-        aligned_local_buffer = (uint8_t*)((size_t)local_buffer + ((size_t)32 - ((size_t)local_buffer & 0x1F)));
-
-        if (direction == BUS_WRITE)
+        else
         {
-            /* Copy the data to aligned buffer */
-            memcpy((void *)aligned_local_buffer, (void *)data, data_size);
-        }
+            WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, cmd53_bounce);
+            if ( (bus_priv->bounce_buffer != NULL) && (data_size <= WHD_BUS_SDIO_BOUNCE_SIZE) &&
+                 (cy_rtos_get_semaphore(&bus_priv->bounce_semaphore, 0, WHD_FALSE) == WHD_SUCCESS) )
+            {
+                aligned_local_buffer = bus_priv->bounce_buffer;
+            }
+            else
+            {
+                WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, cmd53_bounce_alloc);
+                local_buffer = (uint8_t *)whd_mem_malloc(data_size + (2 * DCACHE_BYTE_ALIGNEMNT) );
+                if (NULL == local_buffer)
+                {
+                    WPRINT_WHD_ERROR( ("%s:%d whd_mem_malloc failed\n", __func__, __LINE__) );
+                    result = WHD_MALLOC_FAILURE;
+                    goto done;
+                }
+                aligned_local_buffer = (uint8_t *)ROUND_UP( (size_t)local_buffer, DCACHE_BYTE_ALIGNEMNT );
+            }
+
+            if (direction == BUS_WRITE)
+            {
+                /* Copy the data to aligned buffer */
+                memcpy((void *)aligned_local_buffer, (void *)data, data_size);
+            }
 
-        iscacheable = true;
+            iscacheable = true;
+        }
     }
 #endif
 
     if (mode == SDIO_BYTE_MODE)
     {
-        whd_assert("whd_bus_sdio_cmd53: data_size > 512 for byte mode", (data_size <= (uint16_t )512) );
-        arg.cmd53.count = (uint32_t)(data_size & 0x1FF);
-
         result =
-            whd_hal_sdio_host_bulk_transfer(whd_driver->bus_priv->sdio_obj, (whd_hal_sdio_host_transfer_type_t)direction, arg.value,
+            whd_hal_sdio_host_bulk_transfer(whd_driver->bus_priv->sdio_obj, (whd_hal_sdio_host_transfer_type_t)direction, arg,
                                      (uint32_t *)aligned_local_buffer, data_size, response);
 
         if (result != CY_RSLT_SUCCESS)
@@ -1122,15 +1805,8 @@ whd_result_t whd_bus_sdio_cmd53(whd_driver_t whd_driver, whd_bus_transfer_direct
     }
     else
     {
-        arg.cmd53.count = (uint32_t)( (data_size / (uint16_t)SDIO_64B_BLOCK) & BIT_MASK(9) );
-        if ( (uint32_t)(arg.cmd53.count * (uint16_t)SDIO_64B_BLOCK) < data_size )
-        {
-            ++arg.cmd53.count;
-        }
-        arg.cmd53.block_mode = (uint32_t)1;
-
         result =
-            whd_hal_sdio_host_bulk_transfer(whd_driver->bus_priv->sdio_obj, (whd_hal_sdio_host_transfer_type_t)direction, arg.value,
+            whd_hal_sdio_host_bulk_transfer(whd_driver->bus_priv->sdio_obj, (whd_hal_sdio_host_transfer_type_t)direction, arg,
 											 (uint32_t *)aligned_local_buffer, data_size, response);
 
         if (result != CY_RSLT_SUCCESS)
@@ -1155,10 +1831,14 @@ whd_result_t whd_bus_sdio_cmd53(whd_driver_t whd_driver, whd_bus_transfer_direct
 
 done:
 #if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
-    if(iscacheable == true)
+    if (local_buffer != NULL)
     {
         whd_mem_free(local_buffer);
     }
+    else if (iscacheable == true)
+    {
+        (void)cy_rtos_set_semaphore(&bus_priv->bounce_semaphore, WHD_FALSE);
+    }
 #endif
     WHD_BUS_STATS_CONDITIONAL_INCREMENT_VARIABLE(whd_driver->bus_priv,
                                                  ( (result != WHD_SUCCESS) && (direction == BUS_READ) ),
@@ -1169,8 +1849,201 @@ done:
     CHECK_RETURN(result);
     return WHD_SUCCESS;
 }
+
+static uint32_t whd_bus_sdio_cmd53_argument(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
+                                            whd_bus_function_t function, sdio_transfer_mode_t mode,
+                                            uint32_t address, uint16_t data_size)
+{
+    sdio_cmd_argument_t arg;
+
+    arg.value = 0;
+    arg.cmd53.function_number = (uint32_t)(function & BUS_FUNCTION_MASK);
+    arg.cmd53.register_address = (uint32_t)(address & BIT_MASK(17) );
+    arg.cmd53.op_code = (uint32_t)1;
+    arg.cmd53.rw_flag = (uint32_t)( (direction == BUS_WRITE) ? 1 : 0 );
+
+    if (mode == SDIO_BYTE_MODE)
+    {
+        arg.cmd53.count = (uint32_t)(data_size & 0x1FF);
+    }
+    else
+    {
+        arg.cmd53.count = (uint32_t)( (data_size / whd_driver->bus_priv->block_size) & BIT_MASK(9) );
+        if ( (uint32_t)(arg.cmd53.count * whd_driver->bus_priv->block_size) < data_size )
+        {
+            ++arg.cmd53.count;
+        }
+        arg.cmd53.block_mode = (uint32_t)1;
+    }
+
+    return arg.value;
+}
 #endif /* WHD_USE_CUSTOM_HAL_IMPL */
 
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+/** Starts a transfer that completes in the background, see whd_bus_transfer_async()
+ *
+ *  Only transfers that fit a single CMD53 on the caller's buffer are started asynchronously.
+ *  The rest, and everything before the bus is up, is transferred synchronously.
+ */
+static whd_result_t whd_bus_sdio_transfer_async(whd_driver_t whd_driver, whd_bus_transfer_direction_t direction,
+                                                whd_bus_function_t function, uint32_t address, uint16_t size,
+                                                whd_transfer_bytes_packet_t *data,
+                                                whd_bus_transfer_complete_t complete, void *arg)
+{
+    struct whd_bus_priv *bus_priv = whd_driver->bus_priv;
+    uint32_t max_blk_size = (uint32_t)bus_priv->block_size * bus_priv->max_block_count;
+    uint8_t *buffer = (uint8_t *)data->data;
+    sdio_transfer_mode_t mode = (size >= bus_priv->block_size) ? SDIO_BLOCK_MODE : SDIO_BYTE_MODE;
+    whd_bool_t async = WHD_FALSE;
+    whd_result_t result;
+
+    /* Before WLAN_UP whd_bus_sdio_transfer() splits partial blocks off, those stay synchronous */
+    if ( (bus_priv->async_ready == WHD_TRUE) && (size > 1) && (size <= max_blk_size) &&
+         ( (whd_driver->internal_info.whd_wlan_status.state == WLAN_UP) || (mode == SDIO_BYTE_MODE) ||
+           (size % bus_priv->block_size == 0) ) )
+    {
+        async = WHD_TRUE;
+#if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+        /* A transfer that needs the bounce buffer is not worth the overlap */
+        if (Cy_Syslib_IsMemCacheable(MPU, (uint32_t)buffer, size) &&
+            ( ( (size_t)buffer % DCACHE_BYTE_ALIGNEMNT != 0 ) || ( (size_t)size % DCACHE_BYTE_ALIGNEMNT != 0 ) ) )
+        {
+            async = WHD_FALSE;
+        }
+#endif
+    }
+
+    if (async == WHD_FALSE)
+    {
+        /* cmd53 waits for the transfer in flight */
+        result = whd_bus_sdio_transfer(whd_driver, direction, function, address, size, buffer, RESPONSE_NEEDED);
+        complete(whd_driver, arg, result);
+        return WHD_SUCCESS;
+    }
+
+    /* Only one transfer is in flight, another thread may start one between the wait and taking the mutex */
+    for ( ; ; )
+    {
+        result = whd_bus_sdio_transfer_wait(whd_driver);
+        if (result == WHD_SUCCESS)
+        {
+            result = cy_rtos_get_semaphore(&bus_priv->async_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE);
+        }
+        if (result != WHD_SUCCESS)
+        {
+            complete(whd_driver, arg, result);
+            return WHD_SUCCESS;
+        }
+        if (bus_priv->async_pending == WHD_FALSE)
+        {
+            break;
+        }
+        (void)cy_rtos_set_semaphore(&bus_priv->async_mutex, WHD_FALSE);
+    }
+
+    bus_priv->async_direction = direction;
+    bus_priv->async_complete = complete;
+    bus_priv->async_arg = arg;
+
+    /* Drop a completion left over from a transfer that timed out */
+    (void)cy_rtos_get_semaphore(&bus_priv->async_semaphore, 0, WHD_FALSE);
+
+    WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, cmd53_async);
+    bus_priv->async_pending = WHD_TRUE;
+    whd_hal_sdio_enable_xfer_event(bus_priv->sdio_obj, WHD_TRUE);
+
+    result = whd_hal_sdio_host_transfer_async(bus_priv->sdio_obj, (whd_hal_sdio_host_transfer_type_t)direction,
+                                              whd_bus_sdio_cmd53_argument(whd_driver, direction, function, mode,
+                                                                          address, size),
+                                              (const uint32_t *)buffer, size);
+    if (result != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("%s:%d whd_hal_sdio_host_transfer_async failed\n", __func__, __LINE__) );
+        bus_priv->async_pending = WHD_FALSE;
+        bus_priv->async_complete = NULL;
+        whd_hal_sdio_enable_xfer_event(bus_priv->sdio_obj, WHD_FALSE);
+        WHD_BUS_STATS_CONDITIONAL_INCREMENT_VARIABLE(bus_priv, (direction == BUS_READ), cmd53_read_fail);
+        WHD_BUS_STATS_CONDITIONAL_INCREMENT_VARIABLE(bus_priv, (direction == BUS_WRITE), cmd53_write_fail);
+        (void)cy_rtos_set_semaphore(&bus_priv->async_mutex, WHD_FALSE);
+
+        /* As for a synchronous transfer, the completion owns the data and reports the failure */
+        complete(whd_driver, arg, result);
+        return WHD_SUCCESS;
+    }
+    (void)cy_rtos_set_semaphore(&bus_priv->async_mutex, WHD_FALSE);
+
+    return WHD_SUCCESS;
+}
+
+/** Waits for the transfer started by whd_bus_sdio_transfer_async() and calls its completion callback
+ *
+ *  Any thread may wait. The first one to take the mutex takes the transfer off bus_priv, so its completion
+ *  callback runs exactly once, after the mutex is released.
+ */
+static whd_result_t whd_bus_sdio_transfer_wait(whd_driver_t whd_driver)
+{
+    struct whd_bus_priv *bus_priv = whd_driver->bus_priv;
+    whd_bus_transfer_complete_t complete;
+    void *arg;
+    whd_result_t result;
+
+    if ( (bus_priv->async_ready == WHD_FALSE) || (bus_priv->async_pending == WHD_FALSE) )
+    {
+        return WHD_SUCCESS;
+    }
+
+    CHECK_RETURN(cy_rtos_get_semaphore(&bus_priv->async_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) );
+    if (bus_priv->async_pending == WHD_FALSE)
+    {
+        /* Another waiter completed it */
+        (void)cy_rtos_set_semaphore(&bus_priv->async_mutex, WHD_FALSE);
+        return WHD_SUCCESS;
+    }
+
+    result = cy_rtos_get_semaphore(&bus_priv->async_semaphore, WHD_BUS_SDIO_ASYNC_TIMEOUT_MS, WHD_FALSE);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        /* The completion may have been missed, the host controller knows whether it is still busy */
+        if (whd_hal_sdio_host_is_busy(bus_priv->sdio_obj) )
+        {
+            WPRINT_WHD_ERROR( ("%s: transfer did not complete, aborting\n", __func__) );
+            (void)whd_hal_sdio_host_abort_async(bus_priv->sdio_obj);
+            result = WHD_TIMEOUT;
+        }
+        else
+        {
+            result = WHD_SUCCESS;
+        }
+    }
+
+    complete = bus_priv->async_complete;
+    arg = bus_priv->async_arg;
+    bus_priv->async_complete = NULL;
+    bus_priv->async_pending = WHD_FALSE;
+    whd_hal_sdio_enable_xfer_event(bus_priv->sdio_obj, WHD_FALSE);
+
+    if (bus_priv->async_direction == BUS_WRITE)
+    {
+        WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, cmd53_write);
+        WHD_BUS_STATS_CONDITIONAL_INCREMENT_VARIABLE(bus_priv, (result != WHD_SUCCESS), cmd53_write_fail);
+    }
+    else
+    {
+        WHD_BUS_STATS_INCREMENT_VARIABLE(bus_priv, cmd53_read);
+        WHD_BUS_STATS_CONDITIONAL_INCREMENT_VARIABLE(bus_priv, (result != WHD_SUCCESS), cmd53_read_fail);
+    }
+    (void)cy_rtos_set_semaphore(&bus_priv->async_mutex, WHD_FALSE);
+
+    if (complete != NULL)
+    {
+        complete(whd_driver, arg, result);
+    }
+
+    return result;
+}
+#endif /* WHD_HAL_SDIO_ASYNC_TRANSFER */
+
 static whd_result_t whd_bus_sdio_download_firmware(whd_driver_t whd_driver)
 {
     uint8_t csr_val = 0;
@@ -1373,8 +2246,7 @@ static whd_result_t whd_bus_sdio_set_oob_interrupt(whd_driver_t whd_driver, uint
                                                   (uint32_t)0x2) );
 
         /* Set GPIOx (bit x) on Chipcommon GPIO Control register */
-        CHECK_RETURN(whd_bus_write_register_value(whd_driver, BACKPLANE_FUNCTION, CHIPCOMMON_GPIO_CONTROL, (uint8_t)4,
-                                                  (uint32_t)0x2) );
+        CHECK_RETURN(whd_bus_write_backplane_value(whd_driver, CHIPCOMMON_GPIO_CONTROL, (uint8_t)4, (uint32_t)0x2) );
     }
 
     return WHD_SUCCESS;
@@ -1391,7 +2263,12 @@ whd_result_t whd_bus_sdio_print_stats(whd_driver_t whd_driver, whd_bool_t reset_
                    "cmd52:%" PRIu32 ", cmd53_read:%" PRIu32 ", cmd53_write:%" PRIu32 "\n"
                    "cmd52_fail:%" PRIu32 ", cmd53_read_fail:%" PRIu32 ", cmd53_write_fail:%" PRIu32 "\n"
                    "oob_intrs:%" PRIu32 ", sdio_intrs:%" PRIu32 ", error_intrs:%" PRIu32 ", read_aborts:%" PRIu32
-                   "\n",
+                   "\n"
+                   "rx_glom:%" PRIu32 ", rx_glom_frames:%" PRIu32 ", rx_glom_errors:%" PRIu32
+                   ", rx_nextlen_hit:%" PRIu32 ", rx_nextlen_miss:%" PRIu32 "\n"
+                   "cmd53_direct:%" PRIu32 ", cmd53_bounce:%" PRIu32 ", cmd53_bounce_alloc:%" PRIu32 "\n"
+                   "cmd53_async:%" PRIu32 ", reg_batch_ops:%" PRIu32 ", reg_batch_xfers:%" PRIu32 "\n"
+                   "download_direct_bytes:%" PRIu32 "\n",
                    whd_driver->bus_priv->whd_bus_stats.cmd52, whd_driver->bus_priv->whd_bus_stats.cmd53_read,
                    whd_driver->bus_priv->whd_bus_stats.cmd53_write,
                    whd_driver->bus_priv->whd_bus_stats.cmd52_fail,
@@ -1400,7 +2277,19 @@ whd_result_t whd_bus_sdio_print_stats(whd_driver_t whd_driver, whd_bool_t reset_
                    whd_driver->bus_priv->whd_bus_stats.oob_intrs,
                    whd_driver->bus_priv->whd_bus_stats.sdio_intrs,
                    whd_driver->bus_priv->whd_bus_stats.error_intrs,
-                   whd_driver->bus_priv->whd_bus_stats.read_aborts) );
+                   whd_driver->bus_priv->whd_bus_stats.read_aborts,
+                   whd_driver->bus_priv->whd_bus_stats.rx_glom,
+                   whd_driver->bus_priv->whd_bus_stats.rx_glom_frames,
+                   whd_driver->bus_priv->whd_bus_stats.rx_glom_errors,
+                   whd_driver->bus_priv->whd_bus_stats.rx_nextlen_hit,
+                   whd_driver->bus_priv->whd_bus_stats.rx_nextlen_miss,
+                   whd_driver->bus_priv->whd_bus_stats.cmd53_direct,
+                   whd_driver->bus_priv->whd_bus_stats.cmd53_bounce,
+                   whd_driver->bus_priv->whd_bus_stats.cmd53_bounce_alloc,
+                   whd_driver->bus_priv->whd_bus_stats.cmd53_async,
+                   whd_driver->bus_priv->whd_bus_stats.reg_batch_ops,
+                   whd_driver->bus_priv->whd_bus_stats.reg_batch_xfers,
+                   whd_driver->bus_priv->whd_bus_stats.download_direct_bytes) );
 
     if (reset_after_print == WHD_TRUE)
     {
@@ -1429,6 +2318,9 @@ whd_result_t whd_bus_sdio_reinit_stats(whd_driver_t whd_driver, whd_bool_t wake_
     uint32_t loop_count;
     loop_count = 0;
 
+    /* The device lost the backplane window across deep sleep; force the next access to reprogram it */
+    whd_bus_init_backplane_window(whd_driver);
+
     /* Setup the backplane*/
     loop_count = 0;
 
@@ -1486,14 +2378,7 @@ whd_result_t whd_bus_sdio_reinit_stats(whd_driver_t whd_driver, whd_bool_t wake_
 
     WPRINT_WHD_DEBUG( ("Modding registers for blocks\n") );
 
-    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_BLKSIZE_0,   (uint8_t)1,
-                                              (uint32_t)SDIO_64B_BLOCK) );
-    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F1BLKSIZE_0, (uint8_t)1,
-                                              (uint32_t)SDIO_64B_BLOCK) );
-    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F2BLKSIZE_0, (uint8_t)1,
-                                              (uint32_t)SDIO_64B_BLOCK) );
-    CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_F2BLKSIZE_1, (uint8_t)1,
-                                              (uint32_t)0) );                                                                                  /* Function 2 = 64 */
+    CHECK_RETURN(whd_bus_sdio_set_block_size(whd_driver) );
 
     /* Enable/Disable Client interrupts */
     CHECK_RETURN(whd_bus_write_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_INTEN,       (uint8_t)1,
@@ -1656,11 +2541,28 @@ uint32_t whd_bus_sdio_get_max_transfer_size(whd_driver_t whd_driver)
     return WHD_BUS_SDIO_MAX_BACKPLANE_TRANSFER_SIZE;
 }
 
+uint16_t whd_bus_sdio_get_block_size(whd_driver_t whd_driver)
+{
+    return whd_driver->bus_priv->block_size;
+}
+
 #ifndef WHD_USE_CUSTOM_HAL_IMPL
 static void whd_bus_sdio_irq_handler(void *handler_arg, whd_hal_sdio_event_t event)
 {
     whd_driver_t whd_driver = (whd_driver_t)handler_arg;
 
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+    /* Enabled only while whd_bus_sdio_transfer_async() has a transfer in flight */
+    if (event == WHD_HAL_SDIO_XFER_COMPLETE)
+    {
+        if (whd_driver->bus_priv->async_pending == WHD_TRUE)
+        {
+            (void)cy_rtos_set_semaphore(&whd_driver->bus_priv->async_semaphore, WHD_TRUE);
+        }
+        return;
+    }
+#endif
+
     /* WHD registered only for CY_CYHAL_SDIO_CARD_INTERRUPT */
     if (event != WHD_HAL_SDIO_CARD_INTERRUPT)
     {
@@ -1686,6 +2588,11 @@ whd_result_t whd_bus_sdio_irq_enable(whd_driver_t whd_driver, whd_bool_t enable)
     whd_sdio_t* sdio_obj = whd_driver->bus_priv->sdio_obj;
 
     whd_hal_sdio_enable_event(sdio_obj, enable);
+    /* With an OOB interrupt the card interrupt alone does not stop the WHD thread being woken */
+    if (whd_driver->bus_priv->oob_intr_ready == WHD_TRUE)
+    {
+        CHECK_RETURN(whd_bus_sdio_enable_oob_intr(whd_driver, enable) );
+    }
     return WHD_SUCCESS;
 }
 
@@ -1761,6 +2668,7 @@ static whd_result_t whd_bus_sdio_init_oob_intr(whd_driver_t whd_driver)
     /* XXX Remove this when BSP377 is implemented */
     CHECK_RETURN(whd_bus_sdio_register_oob_intr(whd_driver) );
     CHECK_RETURN(whd_bus_sdio_enable_oob_intr(whd_driver, WHD_TRUE) );
+    whd_driver->bus_priv->oob_intr_ready = WHD_TRUE;
 
     return WHD_SUCCESS;
 }
@@ -1769,6 +2677,7 @@ static whd_result_t whd_bus_sdio_deinit_oob_intr(whd_driver_t whd_driver)
 {
     const whd_oob_config_t *config = &whd_driver->bus_priv->sdio_config.oob_config;
 
+    whd_driver->bus_priv->oob_intr_ready = WHD_FALSE;
     if (whd_hal_is_oob_pin_avaliable(config) == WHD_TRUE)
     {
         CHECK_RETURN(whd_bus_sdio_enable_oob_intr(whd_driver, WHD_FALSE) );
@@ -1781,13 +2690,25 @@ static whd_result_t whd_bus_sdio_deinit_oob_intr(whd_driver_t whd_driver)
 
 
 #ifdef BLHS_SUPPORT
+/* On 43022 the DAR registers are backplane addresses, reached through the window */
+static whd_result_t whd_bus_sdio_blhs_set_window(whd_driver_t whd_driver)
+{
+#ifdef DM_43022C1
+    return whd_bus_set_backplane_window(whd_driver, SDIO_REG_DAR_H2D_MSG_0);
+#else
+    return WHD_SUCCESS;
+#endif
+}
+
 static whd_result_t whd_bus_sdio_blhs_read_h2d(whd_driver_t whd_driver, uint32_t *val)
 {
+    CHECK_RETURN(whd_bus_sdio_blhs_set_window(whd_driver) );
     return whd_bus_sdio_read_register_value(whd_driver, BACKPLANE_FUNCTION, SDIO_REG_DAR_H2D_MSG_0, 1, (uint8_t *)val);
 }
 
 static whd_result_t whd_bus_sdio_blhs_write_h2d(whd_driver_t whd_driver, uint32_t val)
 {
+    CHECK_RETURN(whd_bus_sdio_blhs_set_window(whd_driver) );
     return whd_bus_sdio_write_register_value(whd_driver, BACKPLANE_FUNCTION, (uint32_t)SDIO_REG_DAR_H2D_MSG_0,
                                              (uint8_t)1, val);
 }
@@ -1803,6 +2724,7 @@ static whd_result_t whd_bus_sdio_blhs_wait_d2h(whd_driver_t whd_driver, uint16_t
     uint8_t no_of_bytes = 1;
 #endif
 
+    CHECK_RETURN(whd_bus_sdio_blhs_set_window(whd_driver) );
     while ( ( (result =
                    whd_bus_sdio_read_register_value(whd_driver, BACKPLANE_FUNCTION, SDIO_REG_DAR_D2H_MSG_0, (uint8_t)no_of_bytes,
                                                     (uint8_t*)&byte_data) ) == WHD_SUCCESS ) &&
@@ -1840,6 +2762,7 @@ static whd_result_t whd_bus_sdio_blhs(whd_driver_t whd_driver, whd_bus_blhs_stag
        case CHK_BL_INIT:
             WPRINT_WHD_DEBUG(("CHK_BL_INIT \n"));
 #ifdef DM_43022C1
+            CHECK_RETURN(whd_bus_sdio_blhs_set_window(whd_driver) );
             CHECK_RETURN(whd_bus_sdio_write_register_value(whd_driver, BACKPLANE_FUNCTION, (uint32_t)SDIO_REG_DAR_H2D_MSG_0,
                                                (uint8_t)4, SDIO_BLHS_H2D_BL_INIT));
 #else
@@ -1950,53 +2873,142 @@ static whd_result_t whd_bus_sdio_blhs(whd_driver_t whd_driver, whd_bus_blhs_stag
 
 #endif
 
-#ifdef WPRINT_ENABLE_WHD_DEBUG
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_FULL)
 #define WHD_BLOCK_SIZE       (1024)
+/* Reads back the size bytes written at address by whd_bus_sdio_download_resource() and compares them
+ * with the resource, block by block in the order and with the clipping the download used */
 static whd_result_t whd_bus_sdio_verify_resource(whd_driver_t whd_driver, whd_resource_type_t resource,
-                                                 whd_bool_t direct_resource, uint32_t address, uint32_t image_size)
+                                                 const uint8_t *direct_image, uint32_t direct_size,
+                                                 uint32_t address, uint32_t size)
 {
     whd_result_t result = WHD_SUCCESS;
     uint8_t *image;
     uint8_t *cmd_img = NULL;
-    uint32_t blocks_count = 0;
+    uint32_t blocks_count = 1;
     uint32_t i;
     uint32_t size_out;
+    uint32_t offset;
+    uint32_t chunk;
 
-    result = whd_get_resource_no_of_blocks(whd_driver, resource, &blocks_count);
-    if (result != WHD_SUCCESS)
+    if (direct_image == NULL)
     {
-        WPRINT_WHD_ERROR( ("Fatal error: download_resource blocks count not known, %s failed at line %d \n", __func__,
-                           __LINE__) );
-        goto exit;
+        result = whd_get_resource_no_of_blocks(whd_driver, resource, &blocks_count);
+        if (result != WHD_SUCCESS)
+        {
+            WPRINT_WHD_ERROR( ("Fatal error: download_resource blocks count not known, %s failed at line %d \n",
+                               __func__, __LINE__) );
+            goto exit;
+        }
     }
     cmd_img = whd_mem_malloc(WHD_BLOCK_SIZE);
-    if (cmd_img != NULL)
+    if (cmd_img == NULL)
+    {
+        result = WHD_MALLOC_FAILURE;
+        goto exit;
+    }
+    for (i = 0; i < blocks_count && size > 0; i++)
     {
-        for (i = 0; i < blocks_count; i++)
+        if (direct_image != NULL)
+        {
+            image = (uint8_t *)direct_image;
+            size_out = direct_size;
+        }
+        else
+        {
+            result = whd_get_resource_block(whd_driver, resource, i, (const uint8_t **)&image, &size_out);
+            if (result != WHD_SUCCESS)
+            {
+                goto exit;
+            }
+        }
+        size_out = MIN_OF(size_out, size);
+        size -= size_out;
+
+        for (offset = 0; offset < size_out; offset += chunk)
         {
-            CHECK_RETURN(whd_get_resource_block(whd_driver, resource, i, (const uint8_t **)&image, &size_out) );
-            result = whd_bus_transfer_backplane_bytes(whd_driver, BUS_READ, address, size_out, cmd_img);
+            chunk = MIN_OF(size_out - offset, (uint32_t)WHD_BLOCK_SIZE);
+            result = whd_bus_transfer_backplane_bytes(whd_driver, BUS_READ, address, chunk, cmd_img);
             if (result != WHD_SUCCESS)
             {
                 WPRINT_WHD_ERROR( ("%s: Failed to read firmware image\n", __FUNCTION__) );
                 goto exit;
             }
-            if (memcmp(cmd_img, &image[0], size_out) )
+            if (memcmp(cmd_img, &image[offset], chunk) )
             {
                 WPRINT_WHD_ERROR( ("%s: Downloaded image is corrupted, address is %d, len is %d, resource is %d \n",
-                                   __FUNCTION__, (int)address, (int)size_out, (int)resource) );
+                                   __FUNCTION__, (int)address, (int)chunk, (int)resource) );
+                result = WHD_WLAN_SDIO_ERROR;
+                goto exit;
             }
-            address += size_out;
+            address += chunk;
         }
     }
 exit:
     if (cmd_img)
         whd_mem_free(cmd_img);
-    return WHD_SUCCESS;
+    return result;
 }
 
 #endif
 
+/* Whether cmd53 can DMA straight from data instead of bouncing it */
+static whd_bool_t whd_bus_sdio_can_dma_from(const uint8_t *data, uint32_t size)
+{
+    if ( (size_t)data % sizeof(uint32_t) != 0 )
+    {
+        return WHD_FALSE;
+    }
+#if !defined (CY_DISABLE_XMC7000_DATA_CACHE) && defined (__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+    if (Cy_Syslib_IsMemCacheable(MPU, (uint32_t)data, size) &&
+        ( ( (size_t)data % DCACHE_BYTE_ALIGNEMNT != 0 ) || ( (size_t)size % DCACHE_BYTE_ALIGNEMNT != 0 ) ) )
+    {
+        return WHD_FALSE;
+    }
+#else
+    UNUSED_PARAMETER(size);
+#endif
+
+    return WHD_TRUE;
+}
+
+/* Writes a memory mapped resource from where it is, in transfers as large as the backplane window
+ * and the host allow. Chunks the host cannot DMA from go through the download buffers. */
+static whd_result_t whd_bus_sdio_download_direct(whd_driver_t whd_driver, whd_bus_download_t *download,
+                                                 uint32_t address, const uint8_t *data, uint32_t size)
+{
+    struct whd_bus_priv *bus_priv = whd_driver->bus_priv;
+    uint32_t max_blk_size = (uint32_t)bus_priv->block_size * bus_priv->max_block_count;
+    uint32_t transfer_size;
+    cy_time_t start;
+    cy_time_t now;
+
+    for (; size != 0; size -= transfer_size, address += transfer_size, data += transfer_size)
+    {
+        transfer_size = MIN_OF(size, BACKPLANE_WINDOW_SIZE - (address & BACKPLANE_ADDRESS_MASK) );
+        transfer_size = MIN_OF(transfer_size, max_blk_size);
+
+        if (whd_bus_sdio_can_dma_from(data, transfer_size) == WHD_FALSE)
+        {
+            CHECK_RETURN(whd_bus_download_write(whd_driver, download, address, data, transfer_size) );
+            continue;
+        }
+
+        (void)cy_rtos_get_time(&start);
+        CHECK_RETURN(whd_bus_set_backplane_window(whd_driver, address) );
+        DISABLE_COMPILER_WARNING(diag_suppress = Pa039)
+        CHECK_RETURN(whd_bus_sdio_transfer(whd_driver, BUS_WRITE, BACKPLANE_FUNCTION, address & BACKPLANE_ADDRESS_MASK,
+                                           (uint16_t)transfer_size, (uint8_t *)data, RESPONSE_NEEDED) );
+        ENABLE_COMPILER_WARNING(diag_suppress = Pa039)
+        (void)cy_rtos_get_time(&now);
+        download->bus_wait_time += (uint32_t)(now - start);
+        download->bytes += transfer_size;
+        whd_bus_download_record(download, address, data, transfer_size);
+        WHD_BUS_STATS_ADD_VARIABLE(bus_priv, download_direct_bytes, transfer_size);
+    }
+
+    return WHD_SUCCESS;
+}
+
 static whd_result_t whd_bus_sdio_download_resource(whd_driver_t whd_driver, whd_resource_type_t resource,
                                                    whd_bool_t direct_resource, uint32_t address, uint32_t image_size)
 {
@@ -2006,26 +3018,55 @@ static whd_result_t whd_bus_sdio_download_resource(whd_driver_t whd_driver, whd_
 #endif
 
     whd_result_t result = WHD_SUCCESS;
+    whd_bus_download_t download;
+    const uint8_t *direct_image = NULL;
+    uint32_t direct_size = 0;
     uint8_t *image;
     uint32_t blocks_count = 0;
     uint32_t i;
     uint32_t size_out;
     uint32_t reset_instr = 0;
-#ifdef WPRINT_ENABLE_WHD_DEBUG
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_FULL)
     uint32_t pre_addr = address;
 #endif
 
-    result = whd_get_resource_no_of_blocks(whd_driver, resource, &blocks_count);
-    if (result != WHD_SUCCESS)
+    /* The next block is fetched while the previous one is written */
+    CHECK_RETURN(whd_bus_download_start(whd_driver, &download) );
+
+    /* A memory mapped resource is written from where it is, as a single block */
+    if (whd_get_resource_direct(whd_driver, resource, &direct_image, &direct_size) == WHD_SUCCESS)
     {
-        WPRINT_WHD_ERROR( ("Fatal error: download_resource blocks count not known, %s failed at line %d \n", __func__,
-                           __LINE__) );
-        goto exit;
+        blocks_count = 1;
+    }
+    else
+    {
+        direct_image = NULL;
+        result = whd_get_resource_no_of_blocks(whd_driver, resource, &blocks_count);
+        if (result != WHD_SUCCESS)
+        {
+            WPRINT_WHD_ERROR( ("Fatal error: download_resource blocks count not known, %s failed at line %d \n",
+                               __func__, __LINE__) );
+            goto exit;
+        }
     }
 
     for (i = 0; i < blocks_count && image_size > 0; i++)
     {
-        CHECK_RETURN(whd_get_resource_block(whd_driver, resource, i, (const uint8_t **)&image, &size_out) );
+        if (direct_image != NULL)
+        {
+            image = (uint8_t *)direct_image;
+            size_out = direct_size;
+        }
+        else
+        {
+            result = whd_bus_download_get_block(whd_driver, &download, resource, i, (const uint8_t **)&image,
+                                                &size_out);
+            if (result != WHD_SUCCESS)
+            {
+                WPRINT_WHD_ERROR( ("%s: Failed to read resource block %" PRIu32 "\n", __FUNCTION__, i) );
+                goto exit;
+            }
+        }
         if (resource == WHD_RESOURCE_WLAN_FIRMWARE)
         {
 #ifdef BLHS_SUPPORT
@@ -2053,7 +3094,7 @@ static whd_result_t whd_bus_sdio_download_resource(whd_driver_t whd_driver, whd_
                     }
 #endif /* DM_43022C1 */
 
-#ifdef WPRINT_ENABLE_WHD_DEBUG
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_FULL)
                     pre_addr = address;
 #endif
                 }
@@ -2080,7 +3121,14 @@ static whd_result_t whd_bus_sdio_download_resource(whd_driver_t whd_driver, whd_
                 reset_instr = *( (uint32_t *)(&image[0]) );
             }
         }
-        result = whd_bus_transfer_backplane_bytes(whd_driver, BUS_WRITE, address, size_out, &image[0]);
+        if (direct_image != NULL)
+        {
+            result = whd_bus_sdio_download_direct(whd_driver, &download, address, &image[0], size_out);
+        }
+        else
+        {
+            result = whd_bus_download_write(whd_driver, &download, address, &image[0], size_out);
+        }
         if (result != WHD_SUCCESS)
         {
             WPRINT_WHD_ERROR( ("%s: Failed to write firmware image\n", __FUNCTION__) );
@@ -2088,8 +3136,27 @@ static whd_result_t whd_bus_sdio_download_resource(whd_driver_t whd_driver, whd_
         }
         address += size_out;
     }
-#ifdef WPRINT_ENABLE_WHD_DEBUG
-    whd_bus_sdio_verify_resource(whd_driver, resource, direct_resource, pre_addr, image_size);
+    result = whd_bus_download_finish(whd_driver, &download);
+    if (result != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("%s: Failed to write firmware image\n", __FUNCTION__) );
+        return result;
+    }
+#if (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_FULL)
+    result = whd_bus_sdio_verify_resource(whd_driver, resource, direct_image, direct_size, pre_addr,
+                                          address - pre_addr);
+    if (result != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("%s: Downloaded resource %d failed verification\n", __FUNCTION__, (int)resource) );
+        return result;
+    }
+#elif (WHD_RESOURCE_VERIFY == WHD_RESOURCE_VERIFY_DIGEST)
+    result = whd_bus_download_verify(whd_driver, &download);
+    if (result != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("%s: Downloaded resource %d failed verification\n", __FUNCTION__, (int)resource) );
+        return result;
+    }
 #endif
     /* Below part of the code is applicable to arm_CR4 type chips only
      * The CR4 chips by default firmware is not loaded at 0. So we need
@@ -2118,7 +3185,11 @@ static whd_result_t whd_bus_sdio_download_resource(whd_driver_t whd_driver, whd_
         }
     }
 #endif
-exit: return result;
+    return result;
+
+exit:
+    (void)whd_bus_download_finish(whd_driver, &download);
+    return result;
 }
 
 static whd_result_t whd_bus_sdio_write_wifi_nvram_image(whd_driver_t whd_driver)
@@ -41,6 +41,9 @@ extern "C" {
 #define WHD_BUS_STATS_CONDITIONAL_INCREMENT_VARIABLE(bus_priv, condition, var) \
     do { if (condition){ bus_priv->whd_bus_stats.var++; }} while (0)
 
+#define WHD_BUS_STATS_ADD_VARIABLE(bus_priv, var, value) \
+    do { bus_priv->whd_bus_stats.var += (value); } while (0)
+
 /******************************************************
 *             Structures
 ******************************************************/
@@ -133,6 +136,12 @@ typedef enum
     SDIO_1024B_BLOCK = 1024, SDIO_2048B_BLOCK = 2048
 } sdio_block_size_t;
 
+#define SDIO_CMD53_MAX_BLOCK_COUNT    (511)   /* Largest count the 9 bit CMD53 count field can carry */
+
+#ifndef WHD_BUS_SDIO_ASYNC_TIMEOUT_MS
+#define WHD_BUS_SDIO_ASYNC_TIMEOUT_MS (100)   /* Longest wait for an asynchronous CMD53 to complete */
+#endif
+
 typedef enum
 {
     RESPONSE_NEEDED, NO_RESPONSE
@@ -150,6 +159,18 @@ typedef struct
     uint32_t sdio_intrs;       /* Number of SDIO interrupts generated by wlan chip */
     uint32_t error_intrs;      /* Number of SDIO error interrupts generated by wlan chip */
     uint32_t read_aborts;      /* Number of times read aborts are called */
+    uint32_t rx_glom;          /* Number of RX superframes received */
+    uint32_t rx_glom_frames;   /* Number of frames split out of RX superframes */
+    uint32_t rx_glom_errors;   /* Number of malformed glom descriptors and superframes dropped */
+    uint32_t rx_nextlen_hit;   /* Number of frames read in one transfer using the next length hint */
+    uint32_t rx_nextlen_miss;  /* Number of next length hints that did not match the frame */
+    uint32_t cmd53_direct;     /* Number of cmd53s on cacheable memory that used the caller's buffer for DMA */
+    uint32_t cmd53_bounce;     /* Number of cmd53s copied through a cache aligned bounce buffer */
+    uint32_t cmd53_bounce_alloc; /* Number of bounced cmd53s that did not fit the bounce arena and allocated one */
+    uint32_t cmd53_async;      /* Number of cmd53s started without waiting for them to complete */
+    uint32_t reg_batch_ops;    /* Number of register operations done through a register batch */
+    uint32_t reg_batch_xfers;  /* Number of bus transfers those operations took */
+    uint32_t download_direct_bytes; /* Resource bytes written straight from memory mapped resources */
 } whd_bus_stats_t;
 #pragma pack()
 
@@ -210,6 +231,7 @@ extern whd_result_t  whd_bus_sdio_wait_for_wlan_event(whd_driver_t whd_driver,
                                                       cy_semaphore_t *transceive_semaphore);
 extern whd_bool_t whd_bus_sdio_use_status_report_scheme(whd_driver_t whd_driver);
 extern uint32_t whd_bus_sdio_get_max_transfer_size(whd_driver_t whd_driver);
+extern uint16_t whd_bus_sdio_get_block_size(whd_driver_t whd_driver);
 /******************************************************
 *             Global variables
 ******************************************************/
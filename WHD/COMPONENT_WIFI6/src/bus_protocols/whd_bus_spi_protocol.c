@@ -271,11 +271,8 @@ whd_result_t whd_bus_spi_transfer(whd_driver_t whd_driver, const uint8_t *tx, si
 whd_result_t whd_bus_spi_send_buffer(whd_driver_t whd_driver, whd_buffer_t buffer)
 {
     whd_result_t result = whd_bus_spi_transfer_buffer(whd_driver, BUS_WRITE, WLAN_FUNCTION, 0, buffer);
+    whd_sdpcm_tx_buffer_done(whd_driver, buffer, result);
     CHECK_RETURN(whd_buffer_release(whd_driver, buffer, WHD_NETWORK_TX) );
-    if (result == WHD_SUCCESS)
-    {
-        DELAYED_BUS_RELEASE_SCHEDULE (whd_driver, WHD_TRUE);
-    }
     CHECK_RETURN(result);
 
     return WHD_SUCCESS;
@@ -521,9 +518,9 @@ whd_result_t whd_bus_spi_read_frame(whd_driver_t whd_driver, whd_buffer_t *buffe
     }
 
     /* Allocate a suitable buffer */
-    result = whd_host_buffer_get(whd_driver, buffer, WHD_NETWORK_RX,
-                                 (uint16_t)(whd_gspi_bytes_pending + WHD_BUS_GSPI_PACKET_OVERHEAD),
-                                 (whd_sdpcm_has_tx_packet(whd_driver) ? 0 : WHD_RX_BUF_TIMEOUT) );
+    result = whd_bus_rx_buffer_get(whd_driver, buffer,
+                                   (uint16_t)(whd_gspi_bytes_pending + WHD_BUS_GSPI_PACKET_OVERHEAD),
+                                   (whd_sdpcm_has_tx_packet(whd_driver) ? 0 : WHD_RX_BUF_TIMEOUT) );
 
     if (result != WHD_SUCCESS)
     {
@@ -694,7 +691,7 @@ whd_result_t whd_bus_spi_init(whd_driver_t whd_driver)
 
     /* Read the chip id */
     CHECK_RETURN(whd_bus_spi_read_backplane_value(whd_driver, CHIPCOMMON_BASE_ADDRESS, 2, (uint8_t *)&chip_id) );
-    whd_chip_set_chip_id(whd_driver, chip_id);
+    CHECK_RETURN(whd_chip_set_chip_id(whd_driver, chip_id) );
 
     /* Download the firmware */
     result = whd_spi_download_firmware(whd_driver);
@@ -815,6 +812,9 @@ whd_result_t whd_bus_spi_wait_for_wlan_event(whd_driver_t whd_driver, cy_semapho
         }
     }
 
+    /* Bounded while an asynchronous IOCTL waits for its response */
+    timeout_ms = MIN_OF(timeout_ms, whd_driver->thread_info.max_sleep_ms);
+
     /* Check if we have run out of bus credits */
     if (whd_sdpcm_get_available_credits(whd_driver) == 0)
     {
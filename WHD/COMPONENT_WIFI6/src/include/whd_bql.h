@@ -0,0 +1,106 @@
+/*
+ * (c) 2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG.  SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file WHD byte queue limits
+ *
+ * Dynamic byte limit for a TX queue. Bytes are accounted when a packet enters the
+ * queue and when it leaves it (completion). The limit grows when the queue drains
+ * while senders were being held off, and shrinks by the standing backlog when the
+ * queue never drains during a hold period.
+ *
+ * The caller serialises whd_bql_queued(), whd_bql_completed() and whd_bql_reset(), the
+ * limit keeps no lock of its own. whd_bql_over_limit() and whd_bql_get_limit() only read
+ * and may be used unlocked as a hint.
+ */
+#ifndef INCLUDED_WHD_BQL_H
+#define INCLUDED_WHD_BQL_H
+
+#include "cyabs_rtos.h"
+#include "whd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Default period over which a standing backlog must persist before the limit shrinks */
+#define WHD_BQL_HOLD_TIME_MS    (1000)
+
+typedef struct whd_bql
+{
+    uint32_t num_queued;                /* Bytes queued and not completed yet */
+    uint32_t limit;                     /* Current byte limit */
+    whd_bool_t over_limit;              /* Set when the queue went over the limit since the last growth */
+    uint32_t min_limit;                 /* Lower bound of the limit */
+    uint32_t max_limit;                 /* Upper bound of the limit */
+    uint32_t hold_time;                 /* Hold period in ms */
+    uint32_t lowest_backlog;            /* Smallest backlog seen at completion in the current hold period */
+    cy_time_t hold_start;               /* Start of the current hold period */
+} whd_bql_t;
+
+/** Initialises a byte queue limit, the limit starts at min_limit
+ *
+ *  @param bql           Byte queue limit to initialise
+ *  @param min_limit     Lower bound of the limit in bytes
+ *  @param max_limit     Upper bound of the limit in bytes
+ *  @param hold_time     Hold period in ms
+ */
+extern void whd_bql_init(whd_bql_t *bql, uint32_t min_limit, uint32_t max_limit, uint32_t hold_time);
+
+/** Forgets all queued bytes, keeping the current limit
+ *
+ *  @param bql           Byte queue limit
+ */
+extern void whd_bql_reset(whd_bql_t *bql);
+
+/** Accounts bytes entering the queue
+ *
+ *  @param bql           Byte queue limit
+ *  @param bytes         Bytes queued
+ *
+ *  @return WHD_TRUE if the queue is at or over its limit after queueing
+ */
+extern whd_bool_t whd_bql_queued(whd_bql_t *bql, uint32_t bytes);
+
+/** Accounts bytes leaving the queue and adapts the limit
+ *
+ *  @param bql           Byte queue limit
+ *  @param bytes         Bytes completed
+ */
+extern void whd_bql_completed(whd_bql_t *bql, uint32_t bytes);
+
+/** Checks whether the queue is at or over its limit
+ *
+ *  @param bql           Byte queue limit
+ *
+ *  @return WHD_TRUE if no more bytes should be queued
+ */
+extern whd_bool_t whd_bql_over_limit(whd_bql_t *bql);
+
+/** Returns the current byte limit
+ *
+ *  @param bql           Byte queue limit
+ *
+ *  @return limit in bytes
+ */
+extern uint32_t whd_bql_get_limit(whd_bql_t *bql);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ifndef INCLUDED_WHD_BQL_H */
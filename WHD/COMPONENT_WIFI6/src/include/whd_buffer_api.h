@@ -143,6 +143,14 @@ whd_result_t whd_buffer_set_size(whd_driver_t whd_driver, whd_buffer_t buffer, u
  *  @return                  : WHD_SUCCESS or error code
  */
 whd_result_t whd_buffer_add_remove_at_front(whd_driver_t whd_driver, whd_buffer_t *buffer, int32_t add_remove_amount);
+
+/** Retrieves the alignment guaranteed for packet buffers
+ *
+ *  Implemented in the port layer interface, optional.
+ *
+ *  @return : The alignment in bytes, 0 if the port layer does not guarantee one
+ */
+uint32_t whd_buffer_get_alignment(whd_driver_t whd_driver);
 #ifdef __cplusplus
 } /*extern "C" */
 #endif
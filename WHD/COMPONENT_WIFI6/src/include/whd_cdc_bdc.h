@@ -55,6 +55,11 @@ extern "C"
 
 #define BDC_HEADER_LEN                 (4)
 
+/* IOCTLs which may wait for their response at the same time, further callers wait for one to complete */
+#ifndef WHD_CDC_MAX_PENDING_IOCTLS
+#define WHD_CDC_MAX_PENDING_IOCTLS     (4)
+#endif
+
 /******************************************************
 *                 Enumerations
 ******************************************************/
@@ -97,6 +102,21 @@ typedef struct
 
 /** @endcond */
 
+/* An IOCTL sent and waiting for its response, matched by the ID in the CDC header flags */
+typedef struct whd_cdc_ioctl_pending
+{
+    uint16_t id;                /* 0 when the entry is free */
+    whd_buffer_t response;
+    cy_semaphore_t done;        /* Set once response is stored */
+
+    /* Only for IOCTLs sent without waiting, callback is NULL when a sender waits on done */
+    whd_ioctl_async_callback_t callback;
+    void *user_data;
+    whd_interface_t ifp;
+    cy_time_t start_time;
+    uint32_t timeout_ms;
+} whd_cdc_ioctl_pending_t;
+
 typedef struct whd_cdc_info
 {
     /* Event list variables (Must be at the begining) */
@@ -105,9 +125,9 @@ typedef struct whd_cdc_info
 
     /* IOCTL variables*/
     uint16_t requested_ioctl_id;
-    cy_semaphore_t ioctl_mutex;
-    whd_buffer_t ioctl_response;
-    cy_semaphore_t ioctl_sleep;
+    cy_semaphore_t ioctl_mutex;     /* Protects requested_ioctl_id and ioctl_pending, never held across a wait */
+    cy_semaphore_t ioctl_slots;     /* Counts the free ioctl_pending entries */
+    whd_cdc_ioctl_pending_t ioctl_pending[WHD_CDC_MAX_PENDING_IOCTLS];
 
 } whd_cdc_bdc_info_t;
 
@@ -23,6 +23,7 @@
 #include "whd_endian.h"
 #include "whd.h"
 #include "whd_wifi_api.h"
+#include "whd_chip_constants.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -123,6 +124,7 @@ typedef struct whd_chip_info
     uint8_t chiprev_id;
     whd_bool_t save_restore_enable;
     uint32_t fwcap_flags;
+    uint32_t chip_vars[CHIP_VAR_MAX];  /* Chip constants resolved for chip_id, read through GET_C_VAR() */
 } whd_chip_info_t;
 
 typedef struct whd_fwcap
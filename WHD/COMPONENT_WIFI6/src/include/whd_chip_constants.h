@@ -57,7 +57,8 @@ typedef enum chip_var
     CHANSPEC_CTL_SB_UUL,
     CHANSPEC_CTL_SB_UUU,
     CHANSPEC_CTL_SB_MASK,
-    NVRAM_DNLD_ADDR
+    NVRAM_DNLD_ADDR,
+    CHIP_VAR_MAX                /* Size of the per driver table of resolved constants */
 } chip_var_t;
 #define CHANSPEC_CTL_SB_LL          CHANSPEC_CTL_SB_LLL
 #define CHANSPEC_CTL_SB_LU          CHANSPEC_CTL_SB_LLU
@@ -70,7 +71,31 @@ typedef enum chip_var
                            if (verify_result != WHD_SUCCESS){ \
                                WPRINT_WHD_ERROR( ("Function %s failed at line %d \n", __func__, __LINE__) ); \
                                return verify_result; } }
-#define GET_C_VAR(whd_driver, var) get_whd_var(whd_driver, var)
+/* Resolved for the detected chip by whd_chip_set_chip_id() */
+#define GET_C_VAR(whd_driver, var) ( (whd_driver)->chip_info.chip_vars[var] )
+
+/* SDIO core base address of each chip, X(chip_id, base). Expanded into get_sdiod_core_base_address()
+ * and into GET_SDIOD_CORE_BASE() for pinned builds. */
+#define WHD_SDIOD_CORE_BASE_ADDRESSES(X) \
+    X(55560, 0x18004000) \
+    X(55500, 0x18003000) \
+    X(55530, 0x18003000) \
+    X(0x4373, 0x18005000) \
+    X(43012, 0x18002000) \
+    X(43022, 0x18002000) \
+    X(43430, 0x18002000) \
+    X(43439, 0x18002000)
+
+/* Builds for a single chip may define WHD_CHIP_ID_PINNED to its ID. The SDIO core registers,
+ * accessed on every interrupt, then resolve at compile time. A pinned chip without an entry
+ * above keeps the run time lookup. */
+#if defined(WHD_CHIP_ID_PINNED)
+#define WHD_SDIOD_CORE_BASE_PINNED(chip_id, base)    (WHD_CHIP_ID_PINNED == (chip_id) ) ? (uint32_t)(base) :
+#define GET_SDIOD_CORE_BASE(whd_driver) \
+    (WHD_SDIOD_CORE_BASE_ADDRESSES(WHD_SDIOD_CORE_BASE_PINNED) GET_C_VAR(whd_driver, SDIOD_CORE_BASE_ADDRESS) )
+#else
+#define GET_SDIOD_CORE_BASE(whd_driver)    GET_C_VAR(whd_driver, SDIOD_CORE_BASE_ADDRESS)
+#endif
 
 #define WL_CHANSPEC_CHAN_MASK           (0x00ff)
 #define CHSPEC_IS6G(chspec)          ( (chspec & \
@@ -96,6 +121,7 @@ typedef enum chip_var
 #define CH_10MHZ_APART              2
 #define CH_5MHZ_APART               1 /* 2G band channels are 5 Mhz apart */
 
+/* Looks the constant up for the current chip, GET_C_VAR() reads the resolved copy */
 uint32_t get_whd_var(whd_driver_t whd_driver, chip_var_t var);
 
 whd_result_t get_arm_core_base_address(uint16_t, uint32_t *);
@@ -126,6 +126,9 @@ extern "C"
 #define WHD_STATS_CONDITIONAL_INCREMENT_VARIABLE(whd_driver, condition, var) \
     do { if (condition){ whd_driver->whd_stats.var++; }} while (0)
 
+#define WHD_STATS_ADD_VARIABLE(whd_driver, var, value) \
+    do { whd_driver->whd_stats.var += (value); } while (0)
+
 #if (defined(__GNUC__) && (__GNUC__ >= 6) )
 #define __FUNCTION__ __func__
 #endif
@@ -160,6 +160,7 @@ typedef cyhal_sdio_transfer_type_t whd_hal_sdio_host_transfer_type_t;
 /* The enum of cyhal_sdio_event_t */
 #define WHD_HAL_SDIO_CARD_INTERRUPT CYHAL_SDIO_CARD_INTERRUPT
 #define WHD_HAL_SDIO_CMD_IO_RW_DIRECT CYHAL_SDIO_CMD_IO_RW_DIRECT
+#define WHD_HAL_SDIO_XFER_COMPLETE CYHAL_SDIO_XFER_COMPLETE
 
 /******************************************************
 *             HAL APIs
@@ -175,6 +176,11 @@ typedef cyhal_sdio_transfer_type_t whd_hal_sdio_host_transfer_type_t;
 #define whd_hal_sdio_host_bulk_transfer cyhal_sdio_bulk_transfer
 #define whd_hal_sdio_host_send_cmd cyhal_sdio_send_cmd
 #define whd_hal_sdio_register_callback cyhal_sdio_register_callback
+#define whd_hal_sdio_host_transfer_async cyhal_sdio_transfer_async
+#define whd_hal_sdio_host_is_busy cyhal_sdio_is_busy
+#define whd_hal_sdio_host_abort_async cyhal_sdio_abort_async
+/* Transfers can complete in the background, signalled by WHD_HAL_SDIO_XFER_COMPLETE */
+#define WHD_HAL_SDIO_ASYNC_TRANSFER
 #else /* (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SPI_INTERFACE) */
 // spi
 #define whd_hal_spi_transfer cyhal_spi_transfer
@@ -228,6 +234,7 @@ typedef cyhal_transfer_t whd_hal_sdio_host_transfer_type_t;
 /* The enum of cyhal_sdio_event_t */
 #define WHD_HAL_SDIO_CARD_INTERRUPT CYHAL_SDIO_CARD_INTERRUPT
 #define WHD_HAL_SDIO_CMD_IO_RW_DIRECT CYHAL_SDIO_CMD_IO_RW_DIRECT
+#define WHD_HAL_SDIO_XFER_COMPLETE CYHAL_SDIO_XFER_COMPLETE
 
 /******************************************************
 *             HAL APIs
@@ -243,6 +250,11 @@ typedef cyhal_transfer_t whd_hal_sdio_host_transfer_type_t;
 #define whd_hal_sdio_host_bulk_transfer cyhal_sdio_bulk_transfer
 #define whd_hal_sdio_host_send_cmd cyhal_sdio_send_cmd
 #define whd_hal_sdio_register_callback cyhal_sdio_register_irq
+#define whd_hal_sdio_host_transfer_async cyhal_sdio_transfer_async
+#define whd_hal_sdio_host_is_busy cyhal_sdio_is_busy
+#define whd_hal_sdio_host_abort_async cyhal_sdio_abort_async
+/* Transfers can complete in the background, signalled by WHD_HAL_SDIO_XFER_COMPLETE */
+#define WHD_HAL_SDIO_ASYNC_TRANSFER
 #else /* (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SPI_INTERFACE) */
 // spi
 #define whd_hal_spi_transfer cyhal_spi_transfer
@@ -262,6 +274,9 @@ extern whd_result_t whd_hal_gpio_register_callback(whd_oob_config_t* oob_config,
 extern void whd_hal_gpio_enable_event(whd_oob_config_t* oob_config, whd_bool_t enable);
 #if (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SDIO_INTERFACE)
 extern void whd_hal_sdio_enable_event(whd_sdio_t* sdio_obj, whd_bool_t enable);
+#ifdef WHD_HAL_SDIO_ASYNC_TRANSFER
+extern void whd_hal_sdio_enable_xfer_event(whd_sdio_t* sdio_obj, whd_bool_t enable);
+#endif /* WHD_HAL_SDIO_ASYNC_TRANSFER */
 #endif /* #if (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SDIO_INTERFACE) */
 
 
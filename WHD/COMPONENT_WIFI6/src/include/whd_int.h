@@ -32,6 +32,8 @@
 #include "whd_chip.h"
 #include "whd_ap.h"
 #include "whd_debug.h"
+#include "whd_resource_api.h"
+#include "whd_iovar_cache.h"
 #if defined(COMPONENT_WLANSENSE)
 #include "whd_wlansense_core.h"
 #endif /* defined(COMPONENT_WLANSENSE) */
@@ -45,6 +47,7 @@ extern "C"
 struct whd_proto;   /* device communication protocol info */
 struct whd_ram_shared_info;   /* device ram shared info */
 struct whd_msgbuf;   /* device msg buffer info */
+struct whd_resource_stream;   /* decode state of a packed resource */
 
 typedef struct
 {
@@ -56,6 +59,32 @@ typedef struct
     uint32_t no_credit; /* Number of times WHD could not send due to no credit */
     uint32_t flow_control; /* Number of times WHD Flow control is enabled */
     uint32_t internal_host_buffer_fail_with_timeout; /* Internal host buffer get failed after timeout */
+    uint32_t tx_glom; /* Number of SDPCM TX superframes sent */
+    uint32_t tx_glom_frames; /* Number of TX packets sent inside SDPCM TX superframes */
+    uint32_t tx_ac_dequeue[WHD_TX_SCHED_NUM_AC + 1]; /* Packets dequeued per TX queue (BK, BE, VI, VO, control) */
+    uint32_t tx_ac_latency_total[WHD_TX_SCHED_NUM_AC + 1]; /* Sum of queueing delays in ms per TX queue */
+    uint32_t tx_ac_latency_max[WHD_TX_SCHED_NUM_AC + 1]; /* Largest queueing delay in ms per TX queue */
+    uint32_t tx_flow_controlled; /* Number of TX packets queued over the byte queue limit */
+    uint32_t rx_ring_hit; /* RX buffers taken from the driver RX buffer ring */
+    uint32_t rx_ring_miss; /* RX buffers allocated in the read path because the ring could not be used */
+    uint32_t rx_ring_low_watermark; /* Number of times the RX buffer ring dropped to its low watermark */
+    uint32_t rx_irq; /* Number of WHD thread rounds woken by a bus interrupt */
+    uint32_t rx_poll; /* Number of RX poll rounds run with bus interrupts masked */
+    uint32_t rx_budget_exhausted; /* Number of RX poll rounds that used up their budget */
+    uint32_t bp_window_reg_switch; /* Backplane window moves for register accesses */
+    uint32_t bp_window_mem_switch; /* Backplane window moves for memory transfers */
+    uint32_t dl_bytes; /* Bytes written by pipelined resource downloads */
+    uint32_t dl_read_time; /* ms spent fetching resource blocks during downloads */
+    uint32_t dl_bus_wait_time; /* ms spent waiting for the bus during downloads */
+    uint32_t dl_total_time; /* ms taken by downloads in total */
+    uint32_t iovar_batch; /* Number of IOCTL/IOVAR batches executed */
+    uint32_t iovar_batch_entries; /* IOCTLs/IOVARs sent in batches */
+    uint32_t on_platform_time; /* ms whd_wifi_on() took to bring up the bus and download the firmware */
+    uint32_t on_clm_time; /* ms whd_wifi_on() took to download the CLM blob */
+    uint32_t on_config_time; /* ms whd_wifi_on() took to configure the firmware */
+    uint32_t join_prepare_time; /* ms the last join took to set up security before joining */
+    uint32_t iovar_cache_hit; /* IOCTL/IOVAR reads answered from the IOVAR cache */
+    uint32_t iovar_cache_miss; /* Cacheable IOCTL/IOVAR reads sent to the firmware */
 } whd_stats_t;
 
 #define WHD_INTERFACE_MAX 3
@@ -124,6 +153,10 @@ struct whd_driver
     whd_buffer_funcs_t *buffer_if;
     whd_netif_funcs_t *network_if;
     whd_resource_source_t *resource_if;
+#ifdef WHD_COMPRESSED_RESOURCES
+    struct whd_resource_stream *resource_stream[WHD_RESOURCE_WLAN_CLM + 1];
+    uint32_t resource_source_reads; /* Blocks fetched from resource_if, tells a stream its input moved */
+#endif
     uint8_t *aligned_addr;
 
     whd_bool_t bus_gspi_32bit;
@@ -139,6 +172,7 @@ struct whd_driver
     whd_chip_info_t chip_info;
 
     whd_stats_t whd_stats;
+    whd_iovar_cache_t iovar_cache;
     whd_country_code_t country;
 #ifdef WHD_IOCTL_LOG_ENABLE
     whd_ioctl_log_t whd_ioctl_log[WHD_IOCTL_LOG_SIZE];
@@ -0,0 +1,100 @@
+/*
+ * (c) 2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG.  SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file WHD IOVAR cache
+ *
+ * Read-through cache for GET IOCTL/IOVAR results which rarely or never change, such as the firmware
+ * capabilities and versions, the MAC address and the country. Each cached value belongs to a class
+ * which says what makes it stale: reloading the firmware flushes every class, the others are flushed
+ * by the driver calls and WLAN events that change the value.
+ */
+#ifndef INCLUDED_WHD_IOVAR_CACHE_H
+#define INCLUDED_WHD_IOVAR_CACHE_H
+
+#include "whd.h"
+#include "cyabs_rtos.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Values cached per driver, the least recently filled one is replaced when all are in use */
+#ifndef WHD_IOVAR_CACHE_ENTRIES
+#define WHD_IOVAR_CACHE_ENTRIES        (8)
+#endif
+
+/* Cacheability classes, flushed as a bit mask */
+#define WHD_IOVAR_CACHE_FIRMWARE       (0x01)   /* Fixed until the firmware is reloaded */
+#define WHD_IOVAR_CACHE_ADDRESS        (0x02)   /* Changed by whd_wifi_set_mac_address() */
+#define WHD_IOVAR_CACHE_COUNTRY        (0x04)   /* Changed by setting the country */
+#define WHD_IOVAR_CACHE_ALL            (0xFF)
+
+typedef struct whd_iovar_cache_entry
+{
+    uint8_t *data;              /* NULL when the entry is free */
+    uint16_t length;
+    uint8_t cache_class;
+    uint8_t ifidx;
+    uint32_t command;           /* WLC_GET_VAR for an IOVAR */
+    const char *name;           /* IOVAR name, NULL for an IOCTL */
+    uint32_t key;               /* Request parameter the response depends on */
+} whd_iovar_cache_entry_t;
+
+typedef struct whd_iovar_cache
+{
+    cy_semaphore_t mutex;
+    uint32_t generation;        /* Bumped by every flush, a response fetched across one is not cached */
+    uint8_t next_victim;
+    whd_iovar_cache_entry_t entries[WHD_IOVAR_CACHE_ENTRIES];
+} whd_iovar_cache_t;
+
+whd_result_t whd_iovar_cache_init(whd_driver_t whd_driver);
+void         whd_iovar_cache_deinit(whd_driver_t whd_driver);
+
+/** Gets an IOVAR through the cache, the response is copied to out_buffer
+ *
+ *  @param cache_class : WHD_IOVAR_CACHE_* class which makes the value stale
+ */
+whd_result_t whd_iovar_cache_get_iovar(whd_interface_t ifp, uint8_t cache_class, const char *iovar,
+                                       uint8_t *out_buffer, uint16_t out_length);
+
+/** Gets an IOCTL through the cache, the response is copied over the request
+ *
+ *  @param key         : Identifies the request held in buffer, responses to different requests are cached apart
+ *  @param buffer      : Holds the request and receives the response
+ */
+whd_result_t whd_iovar_cache_get_ioctl(whd_interface_t ifp, uint8_t cache_class, uint32_t ioctl, uint32_t key,
+                                       uint8_t *buffer, uint16_t length);
+
+/* Drops the cached values of the given classes */
+void whd_iovar_cache_flush(whd_driver_t whd_driver, uint8_t cache_classes);
+
+/* Drops the values a SET of the named IOVAR makes stale, called by the generic set IOVAR functions */
+void whd_iovar_cache_set_iovar(whd_driver_t whd_driver, const char *iovar);
+
+/* Drops the values a WLAN event makes stale, called for every event received */
+void whd_iovar_cache_event(whd_driver_t whd_driver, const whd_event_header_t *event_header);
+
+/* Sets the bits of the WLAN events the cache is flushed on, these stay enabled whatever handlers are registered */
+void whd_iovar_cache_set_event_mask(uint8_t *event_mask);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ifndef INCLUDED_WHD_IOVAR_CACHE_H */
@@ -0,0 +1,112 @@
+/*
+ * (c) 2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG.  SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file WHD compressed resource stream
+ *
+ * Streaming decoder for resources packed by tools/whd_pack_resource.py. A packed resource is
+ * a 16 byte header followed by LZ4 block format sequences whose match offsets stay below the
+ * window size given in the header:
+ *
+ *   offset  size  field
+ *   0       4     magic "WHZ1"
+ *   4       1     format version (1)
+ *   5       1     log2 of the window size
+ *   6       2     reserved, 0
+ *   8       4     unpacked size, little endian
+ *   12      4     packed size following the header, little endian
+ *
+ * Input may be fed in pieces of any size. Output is written to a ring buffer of the window
+ * size plus the output block size, so the last decoded block stays in place while the next
+ * one is decoded and no full size copy of the resource is needed.
+ */
+#ifndef INCLUDED_WHD_LZ_H
+#define INCLUDED_WHD_LZ_H
+
+#include "whd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WHD_LZ_HEADER_SIZE          (16)
+#define WHD_LZ_VERSION              (1)
+#define WHD_LZ_WINDOW_LOG_MIN       (8)
+#define WHD_LZ_WINDOW_LOG_MAX       (16)
+
+typedef struct whd_lz_header
+{
+    uint32_t size;              /* Unpacked size */
+    uint32_t packed_size;       /* Packed size following the header */
+    uint32_t window_size;       /* Match offsets are smaller than this */
+} whd_lz_header_t;
+
+typedef struct whd_lz_stream
+{
+    uint8_t *ring;              /* Output ring, at least window_size bytes */
+    uint32_t ring_size;
+    uint32_t ring_pos;          /* Where the next output byte goes */
+    uint32_t window_size;
+    uint32_t out_pos;           /* Bytes decoded so far */
+    uint32_t out_size;          /* Unpacked size */
+    uint8_t state;
+    uint8_t match_nibble;
+    uint32_t lit_len;
+    uint32_t match_len;
+    uint32_t offset;
+} whd_lz_stream_t;
+
+/** Parses the header of a packed resource
+ *
+ *  @param data          Start of the resource
+ *  @param len           Bytes available at data
+ *  @param header        Receives the header
+ *
+ *  @return WHD_SUCCESS, or WHD_BADARG if data is not a packed resource this decoder supports
+ */
+extern whd_result_t whd_lz_parse_header(const uint8_t *data, uint32_t len, whd_lz_header_t *header);
+
+/** Starts decoding a packed resource, input starts right after the header
+ *
+ *  @param lz            Stream to initialise
+ *  @param header        Header of the resource
+ *  @param ring          Output ring
+ *  @param ring_size     Size of the ring, at least the window size of the resource
+ */
+extern void whd_lz_stream_init(whd_lz_stream_t *lz, const whd_lz_header_t *header, uint8_t *ring,
+                               uint32_t ring_size);
+
+/** Decodes input until out_limit bytes in total have been decoded or the input is used up
+ *
+ *  Output goes to the ring at the position out_pos had before the call, wrapping at ring_size.
+ *
+ *  @param lz            Stream
+ *  @param in            Input
+ *  @param in_len        Bytes available at in
+ *  @param in_used       Receives the number of input bytes consumed
+ *  @param out_limit     Total decoded size to stop at, at most the unpacked size
+ *
+ *  @return WHD_SUCCESS, or WHD_BADARG if the input is corrupt
+ */
+extern whd_result_t whd_lz_stream_decode(whd_lz_stream_t *lz, const uint8_t *in, uint32_t in_len,
+                                         uint32_t *in_used, uint32_t out_limit);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* ifndef INCLUDED_WHD_LZ_H */
@@ -24,6 +24,7 @@
 #include "whd_types_int.h"
 #include "whd_wlioctl.h"
 #include "whd_commonring.h"
+#include "whd_bql.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -144,6 +145,10 @@ extern "C"
 #define WHD_TXPOOL_BUFFER_THRESH        (TX_PACKET_POOL_SIZE - TXPOOL_RESV_FOR_STACK)
 #endif
 
+/* Bounds of the TX byte queue limit, WHD_TXPOOL_BUFFER_THRESH remains the hard packet bound */
+#define WHD_MSGBUF_TX_BQL_MIN_LIMIT     (WHD_LINK_MTU)
+#define WHD_MSGBUF_TX_BQL_MAX_LIMIT     (WHD_TXPOOL_BUFFER_THRESH * WHD_LINK_MTU)
+
 #ifdef PROTO_MSGBUF
 /** Error list element structure
  *
@@ -170,6 +175,17 @@ typedef struct whd_error_info
 /* Forward declarations */
 struct whd_flowring;
 
+/* An IOCTL sent without waiting for its response */
+typedef struct whd_msgbuf_ioctl_async
+{
+    whd_ioctl_async_callback_t callback;    /* NULL when none is outstanding */
+    void *user_data;
+    whd_interface_t ifp;
+    cy_time_t start_time;
+    uint32_t timeout_ms;
+    uint16_t request;
+} whd_msgbuf_ioctl_async_t;
+
 typedef struct whd_msgbuf_info
 {
     /* Event list variables (Must be at the begining) */
@@ -183,6 +199,11 @@ typedef struct whd_msgbuf_info
     uint8_t ioctl_response_status;
     uint32_t ioctl_response_length;
     uint32_t ioctl_response_pktid;
+
+    /* An asynchronous IOCTL holds ioctl_mutex until it completes, like a blocking one */
+    cy_semaphore_t ioctl_async_mutex;   /* Protects ioctl_async */
+    whd_msgbuf_ioctl_async_t ioctl_async;
+    uint16_t ioctl_async_last_request;
 } whd_msgbuf_info_t;
 
 typedef struct whd_msgbuftx_info
@@ -441,6 +462,8 @@ struct whd_msgbuf
     uint32_t priority;
     uint32_t current_flowring_count;
     uint32_t tot_txpkt_inqueue;
+    whd_bql_t tx_bql;           /* Byte queue limit of the TX packets posted to the dongle, WHD thread only */
+    whd_bool_t tx_held;         /* Set when a sender was flow controlled, cleared when the flowrings are rescheduled */
     whd_bool_t rx_buf_recovery;
 };
 
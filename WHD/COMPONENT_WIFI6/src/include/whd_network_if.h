@@ -68,6 +68,13 @@ extern "C"
  *
  */
 whd_result_t whd_network_process_ethernet_data(whd_interface_t ifp, whd_buffer_t buffer);
+
+/** Tells the network stack of every interface that it may resume sending
+ *
+ *  Called in the context of the WHD thread once the TX queues which went over their byte limit
+ *  have drained below it.
+ */
+void whd_network_tx_resume(whd_driver_t whd_driver);
 #ifdef __cplusplus
 } /*extern "C" */
 #endif
@@ -44,6 +44,16 @@ struct whd_proto
     whd_result_t (*set_iovar)(whd_interface_t ifp, whd_buffer_t send_buffer_hnd, whd_buffer_t *response_buffer_hnd);
     whd_result_t (*get_iovar)(whd_interface_t ifp, whd_buffer_t send_buffer_hnd, whd_buffer_t *response_buffer_hnd);
     whd_result_t (*tx_queue_data)(whd_interface_t ifp, whd_buffer_t buffer);
+    whd_result_t (*tx_queue_data_batch)(whd_interface_t ifp, const whd_buffer_t *buffers, uint32_t count);
+    whd_bool_t (*tx_flow_controlled)(whd_driver_t whd_driver);
+    whd_result_t (*set_ioctl_async)(whd_interface_t ifp, uint32_t command, whd_buffer_t send_buffer_hnd,
+                                    uint32_t timeout_ms, whd_ioctl_async_callback_t callback, void *user_data,
+                                    uint16_t *request);
+    whd_result_t (*get_ioctl_async)(whd_interface_t ifp, uint32_t command, whd_buffer_t send_buffer_hnd,
+                                    uint32_t timeout_ms, whd_ioctl_async_callback_t callback, void *user_data,
+                                    uint16_t *request);
+    whd_result_t (*cancel_ioctl_async)(whd_driver_t whd_driver, uint16_t request);
+    uint32_t (*poll_ioctl_async)(whd_driver_t whd_driver);
     void *pd;
 };
 
@@ -91,6 +101,64 @@ static inline whd_result_t whd_proto_tx_queue_data(whd_interface_t ifp, whd_buff
     return ifp->whd_driver->proto->tx_queue_data(ifp, buffer);
 }
 
+static inline whd_result_t whd_proto_tx_queue_data_batch(whd_interface_t ifp, const whd_buffer_t *buffers,
+                                                         uint32_t count)
+{
+    return ifp->whd_driver->proto->tx_queue_data_batch(ifp, buffers, count);
+}
+
+static inline whd_bool_t whd_proto_tx_flow_controlled(whd_driver_t whd_driver)
+{
+    return whd_driver->proto->tx_flow_controlled(whd_driver);
+}
+
+/** Sends an IOCTL and returns without waiting for the response
+ *
+ *  The send buffer is consumed in all cases. Unless an error is returned, callback runs exactly once from
+ *  the WHD thread with the response, or with WHD_TIMEOUT if none arrived within timeout_ms (0 selects
+ *  WHD_IOCTL_TIMEOUT_MS), or not at all if the request is cancelled first. It may run before this returns.
+ *  The callback must not wait for another IOCTL, it would block the thread which delivers the response.
+ *
+ *  @param request   : Receives the handle for cancelling the request, may be NULL
+ *
+ *  @return WHD_SUCCESS once sent, or WHD_WLAN_BUSY if no more IOCTLs can be outstanding
+ */
+static inline whd_result_t whd_proto_set_ioctl_async(whd_interface_t ifp, uint32_t command,
+                                                     whd_buffer_t send_buffer_hnd, uint32_t timeout_ms,
+                                                     whd_ioctl_async_callback_t callback, void *user_data,
+                                                     uint16_t *request)
+{
+    return ifp->whd_driver->proto->set_ioctl_async(ifp, command, send_buffer_hnd, timeout_ms, callback, user_data,
+                                                   request);
+}
+
+static inline whd_result_t whd_proto_get_ioctl_async(whd_interface_t ifp, uint32_t command,
+                                                     whd_buffer_t send_buffer_hnd, uint32_t timeout_ms,
+                                                     whd_ioctl_async_callback_t callback, void *user_data,
+                                                     uint16_t *request)
+{
+    return ifp->whd_driver->proto->get_ioctl_async(ifp, command, send_buffer_hnd, timeout_ms, callback, user_data,
+                                                   request);
+}
+
+/** Cancels an IOCTL sent with whd_proto_set_ioctl_async/whd_proto_get_ioctl_async
+ *
+ *  @return WHD_SUCCESS if its callback will not run, WHD_DOES_NOT_EXIST if it already ran or is running
+ */
+static inline whd_result_t whd_proto_cancel_ioctl_async(whd_driver_t whd_driver, uint16_t request)
+{
+    return whd_driver->proto->cancel_ioctl_async(whd_driver, request);
+}
+
+/** Completes outstanding asynchronous IOCTLs whose timeout expired, called by the WHD thread
+ *
+ *  @return Milliseconds until the next outstanding one times out, 0 if none is outstanding
+ */
+static inline uint32_t whd_proto_poll_ioctl_async(whd_driver_t whd_driver)
+{
+    return whd_driver->proto->poll_ioctl_async(whd_driver);
+}
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
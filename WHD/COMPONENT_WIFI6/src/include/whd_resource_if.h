@@ -33,6 +33,12 @@ extern "C"
 /******************************************************
 *                      Macros
 ******************************************************/
+#ifdef WHD_COMPRESSED_RESOURCES
+/* Block size packed firmware and CLM resources are handed out in */
+#ifndef WHD_RESOURCE_LZ_BLOCK_SIZE
+#define WHD_RESOURCE_LZ_BLOCK_SIZE    (1024)
+#endif
+#endif /* WHD_COMPRESSED_RESOURCES */
 
 /******************************************************
 *             Structures
@@ -50,6 +56,14 @@ uint32_t whd_get_resource_block(whd_driver_t whd_driver, whd_resource_type_t typ
 uint32_t whd_resource_read(whd_driver_t whd_driver, whd_resource_type_t type, uint32_t offset,
                            uint32_t size, uint32_t *size_out, void *buffer);
 
+/* Returns WHD_UNSUPPORTED unless type is the firmware and the source maps it, unpacked, in memory */
+uint32_t whd_get_resource_direct(whd_driver_t whd_driver, whd_resource_type_t type, const uint8_t **data,
+                                 uint32_t *size_out);
+
+/* Frees the decode buffers of a resource that has been downloaded */
+void whd_resource_release(whd_driver_t whd_driver, whd_resource_type_t type);
+void whd_resource_deinit(whd_driver_t whd_driver);
+
 #ifdef __cplusplus
 } /*extern "C" */
 #endif
@@ -31,6 +31,7 @@
 #include "whd_network_types.h"
 #include "whd_types_int.h"
 #include "whd_cdc_bdc.h"
+#include "whd_bql.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -64,12 +65,36 @@ typedef struct whd_sdpcm_info
     uint8_t tx_max;
 
 
-    /* Packet send queue variables */
+    /* Packet send queue variables: any thread pushes onto send_queue_in under send_queue_mutex,
+     * only the WHD thread takes from it and keeps the packets in FIFO order in send_queue_head */
     cy_semaphore_t send_queue_mutex;
+    whd_buffer_t send_queue_in[5];
     whd_buffer_t send_queue_head[5];
-    whd_buffer_t send_queue_tail[5];
-    uint32_t npkt_in_q[5]; /** 4 AC queues + 1 Contol queue(IOVAR/IOCTLs) */
-    uint32_t totpkt_in_q;
+    uint32_t npkt_pushed[5];            /** 4 AC queues + 1 Contol queue(IOVAR/IOCTLs), under send_queue_mutex */
+    uint32_t totpkt_pushed;
+    uint32_t npkt_sent[5];              /** Packets taken off each queue, only written by the WHD thread */
+    uint32_t totpkt_sent;
+
+    /* Byte queue limit variables, under send_queue_mutex */
+    whd_bql_t tx_bql[4];                /** Byte queue limits of the 4 AC queues */
+    uint32_t tx_done_bytes[4];          /** Bytes the bus finished sending, folded into tx_bql by the WHD thread */
+    uint8_t tx_held_acs;                /** Bit per AC queue which went over its byte limit, cleared once it drains */
+    uint32_t tx_done_frames;            /** Frames the bus sent, counted into the stats by the WHD thread */
+    uint32_t tx_failed_frames;          /** Frames the bus failed to send, counted into the stats by the WHD thread */
+
+    /* TX glom variables */
+    uint8_t tx_glom_max_frames;         /** Frames per superframe requested at whd_init(), <= 1 when disabled */
+    whd_bool_t tx_glom_enabled;         /** Set once the firmware accepted bus:txglom */
+    uint8_t *tx_glom_buffer;            /** Superframe staging buffer, prefixed by MAX_BUS_HEADER_SIZE bytes */
+    uint16_t tx_glom_buffer_size;       /** Superframe capacity of tx_glom_buffer, excluding the bus header */
+    uint32_t tx_glom_bytes[4];          /** Bytes per AC queue in the superframe being sent */
+
+    /* TX scheduler variables */
+    const struct whd_sdpcm_tx_sched *tx_sched;          /** Policy picking the data AC to serve next */
+    whd_tx_sched_mode_t tx_sched_mode;                  /** Requested at whd_init() */
+    uint32_t tx_sched_quantum[WHD_TX_SCHED_NUM_AC];     /** DRR bytes added per round */
+    uint32_t tx_sched_deficit[WHD_TX_SCHED_NUM_AC];     /** DRR bytes an AC may still send this round */
+    uint8_t tx_sched_ac;                                /** AC the DRR scheduler is serving */
 } whd_sdpcm_info_t;
 
 typedef struct
@@ -79,12 +104,6 @@ typedef struct
 } bus_common_header_t;
 
 #pragma pack(1)
-typedef struct
-{
-    bus_common_header_t common;
-    cdc_header_t cdc_header;
-} control_header_t;
-
 typedef struct
 {
     bus_common_header_t common;
@@ -105,13 +124,24 @@ extern void whd_sdpcm_quit(whd_driver_t whd_driver);
 extern whd_bool_t whd_sdpcm_has_tx_packet(whd_driver_t whd_driver);
 
 extern whd_result_t whd_sdpcm_get_packet_to_send(whd_driver_t whd_driver, whd_buffer_t *buffer);
+extern whd_result_t whd_sdpcm_tx_glom_enable(whd_driver_t whd_driver);
+extern whd_result_t whd_sdpcm_get_glom_to_send(whd_driver_t whd_driver, uint8_t **glom, uint16_t *glom_size,
+                                               uint8_t *frame_count);
+extern void whd_sdpcm_tx_buffer_done(whd_driver_t whd_driver, whd_buffer_t buffer, whd_result_t result);
+extern void whd_sdpcm_tx_glom_done(whd_driver_t whd_driver);
+extern void whd_sdpcm_tx_complete(whd_driver_t whd_driver);
+extern whd_bool_t whd_sdpcm_tx_flow_controlled(whd_driver_t whd_driver);
 extern void whd_sdpcm_update_credit(whd_driver_t whd_driver, uint8_t *data);
 extern uint8_t whd_sdpcm_get_available_credits(whd_driver_t whd_driver);
 extern void whd_update_host_interface_to_bss_index_mapping(whd_driver_t whd_driver, whd_interface_t interface,
                                                            uint32_t bssid_index);
 
+extern void whd_sdpcm_set_control_pad(bus_common_header_t *packet, uint8_t pad);
+extern uint8_t whd_sdpcm_get_control_pad(const bus_common_header_t *packet);
 extern whd_result_t whd_send_to_bus(whd_driver_t whd_driver, whd_buffer_t buffer,
                                     sdpcm_header_type_t header_type, uint8_t prio);
+extern whd_result_t whd_send_to_bus_batch(whd_driver_t whd_driver, const whd_buffer_t *buffers,
+                                          const uint8_t *prios, uint32_t count, sdpcm_header_type_t header_type);
 
 /******************************************************
 *             Global variables
@@ -50,6 +50,8 @@ extern "C"
 #else
 #define WHD_THREAD_RX_BOUND           (20)
 #define WHD_MAX_BUS_FAIL              (10)
+#define WHD_THREAD_RX_BUDGET_MIN      (4)
+#define WHD_THREAD_RX_RATE_SHIFT      (3)   /* RX rate average weight, 1/8 per poll round */
 #endif /* PROTO_MSGBUF */
 
 typedef struct whd_thread_info
@@ -63,6 +65,13 @@ typedef struct whd_thread_info
     void *thread_stack_start;
     uint32_t thread_stack_size;
     cy_thread_priority_t thread_priority;
+    uint32_t max_sleep_ms;          /* Bounds the bus wait for WLAN events, CY_RTOS_NEVER_TIMEOUT if unbounded */
+#ifndef PROTO_MSGBUF
+    whd_bool_t rx_polling;          /* Bus interrupts are masked while RX is polled */
+    uint16_t rx_budget_max;         /* Upper bound of rx_budget, 0 disables RX polling */
+    uint16_t rx_budget;             /* Packets read per poll round */
+    uint32_t rx_rate_avg;           /* Average packets per poll round, scaled by 1 << WHD_THREAD_RX_RATE_SHIFT */
+#endif /* PROTO_MSGBUF */
 
 } whd_thread_info_t;
 
@@ -26,6 +26,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <inttypes.h>
+#include "cyabs_rtos.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -188,6 +189,9 @@ extern "C"
 *                    Constants
 ******************************************************/
 
+/* Most IOCTLs/IOVARs queued in one whd_iovar_batch_t */
+#define WHD_IOVAR_BATCH_MAX_ENTRIES    (8)
+
 /******************************************************
 *             Structures and Enumerations
 ******************************************************/
@@ -209,6 +213,25 @@ typedef struct
 
 #pragma pack()
 
+typedef struct
+{
+    uint32_t command;           /* WLC_SET_VAR for an IOVAR */
+    const char *name;           /* IOVAR name, NULL for an IOCTL */
+    uint32_t data[2];           /* Small values only, they are packed when the batch is executed */
+    uint16_t length;
+    whd_result_t result;        /* Set by whd_iovar_batch_execute() */
+    cy_semaphore_t *done;
+} whd_iovar_batch_entry_t;
+
+/* Set IOCTLs/IOVARs sent back to back without waiting for each response in turn */
+typedef struct
+{
+    whd_interface_t ifp;
+    whd_iovar_batch_entry_t entries[WHD_IOVAR_BATCH_MAX_ENTRIES];
+    uint8_t count;
+    cy_semaphore_t done;        /* Counts the responses collected by whd_iovar_batch_execute() */
+} whd_iovar_batch_t;
+
 /* 802.11 Information Element Identification Numbers (as per section 8.4.2.1 of 802.11-2012) */
 typedef enum
 {
@@ -372,6 +395,14 @@ whd_result_t whd_wifi_set_iovar_buffers(whd_interface_t ifp, const char *iovar,
                                     const uint16_t *lengths, const uint8_t num_buffers);
 whd_result_t whd_wifi_set_iovar_value(whd_interface_t ifp, const char *iovar, uint32_t value);
 
+/* IOCTL/IOVAR batching: entries are sent in order by whd_iovar_batch_execute(), which returns the first error
+ * and leaves the result of each entry in entries[], in the order they were added */
+void         whd_iovar_batch_init(whd_iovar_batch_t *batch, whd_interface_t ifp);
+whd_result_t whd_iovar_batch_add(whd_iovar_batch_t *batch, const char *iovar, const void *data, uint16_t length);
+whd_result_t whd_iovar_batch_add_value(whd_iovar_batch_t *batch, const char *iovar, uint32_t value);
+whd_result_t whd_iovar_batch_add_ioctl_value(whd_iovar_batch_t *batch, uint32_t ioctl, uint32_t value);
+whd_result_t whd_iovar_batch_execute(whd_iovar_batch_t *batch);
+
 /** Sends an IOVAR command
  *
  *  @param  ifp                 : Pointer to handle instance of whd interface
@@ -230,6 +230,21 @@ bool whd_str_to_ip(const char *ip4addr, size_t len, void *dest);
  */
 uint8_t whd_ip4_to_string(const void *ip4addr, char *p);
 
+/*!
+ ******************************************************************************
+ * Updates a CRC-32 (IEEE 802.3, reflected) with data. The CRC is neither
+ * preset nor inverted here: start from WHD_CRC32_INIT, as the crc32 field of
+ * TRX headers does.
+ *
+ * @param[in] crc       : CRC of the preceding data
+ * @param[in] data      : Data to add
+ * @param[in] len       : Length of data
+ *
+ * @return CRC of the preceding data and data
+ */
+#define WHD_CRC32_INIT    (0xFFFFFFFFUL)
+uint32_t whd_crc32(uint32_t crc, const uint8_t *data, uint32_t len);
+
 /*!
  ******************************************************************************
  * The wrapper function for memory allocation.
@@ -0,0 +1,123 @@
+/*
+ * (c) 2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG.  SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ *  Byte queue limits used by the TX queues of the SDPCM and msgbuf protocols
+ */
+
+#include "whd_bql.h"
+
+static void whd_bql_restart_hold(whd_bql_t *bql)
+{
+    cy_time_t now;
+
+    (void)cy_rtos_get_time(&now);
+    bql->hold_start = now;
+    bql->lowest_backlog = 0xFFFFFFFF;
+}
+
+void whd_bql_init(whd_bql_t *bql, uint32_t min_limit, uint32_t max_limit, uint32_t hold_time)
+{
+    bql->min_limit = min_limit;
+    bql->max_limit = (max_limit > min_limit) ? max_limit : min_limit;
+    bql->hold_time = hold_time;
+    bql->num_queued = 0;
+    bql->limit = min_limit;
+    bql->over_limit = WHD_FALSE;
+    whd_bql_restart_hold(bql);
+}
+
+void whd_bql_reset(whd_bql_t *bql)
+{
+    bql->num_queued = 0;
+    bql->over_limit = WHD_FALSE;
+    whd_bql_restart_hold(bql);
+}
+
+whd_bool_t whd_bql_queued(whd_bql_t *bql, uint32_t bytes)
+{
+    bql->num_queued += bytes;
+    if (bql->num_queued >= bql->limit)
+    {
+        bql->over_limit = WHD_TRUE;
+        return WHD_TRUE;
+    }
+
+    return WHD_FALSE;
+}
+
+void whd_bql_completed(whd_bql_t *bql, uint32_t bytes)
+{
+    uint32_t limit = bql->limit;
+    uint32_t backlog;
+    cy_time_t now;
+
+    if (bytes > bql->num_queued)
+    {
+        bytes = bql->num_queued;
+    }
+    bql->num_queued -= bytes;
+    backlog = bql->num_queued;
+
+    /* Drained while senders were held off: the limit starved the bus, grow it */
+    if ( (backlog == 0) && (bql->over_limit == WHD_TRUE) )
+    {
+        bql->over_limit = WHD_FALSE;
+        limit += (limit / 2 > bytes) ? limit / 2 : bytes;
+        if (limit > bql->max_limit)
+        {
+            limit = bql->max_limit;
+        }
+        bql->limit = limit;
+        whd_bql_restart_hold(bql);
+        return;
+    }
+
+    if (backlog < bql->lowest_backlog)
+    {
+        bql->lowest_backlog = backlog;
+    }
+
+    (void)cy_rtos_get_time(&now);
+    if ( (uint32_t)(now - bql->hold_start) < bql->hold_time )
+    {
+        return;
+    }
+
+    /* The queue never drained during the hold period: the standing backlog is excess limit */
+    if (bql->lowest_backlog > 0)
+    {
+        limit = (limit > bql->min_limit + bql->lowest_backlog) ? limit - bql->lowest_backlog : bql->min_limit;
+        bql->limit = limit;
+        /* Shrunk below the backlog, the senders are held off from now on */
+        if (backlog >= limit)
+        {
+            bql->over_limit = WHD_TRUE;
+        }
+    }
+    whd_bql_restart_hold(bql);
+}
+
+whd_bool_t whd_bql_over_limit(whd_bql_t *bql)
+{
+    return (bql->num_queued >= bql->limit) ? WHD_TRUE : WHD_FALSE;
+}
+
+uint32_t whd_bql_get_limit(whd_bql_t *bql)
+{
+    return bql->limit;
+}
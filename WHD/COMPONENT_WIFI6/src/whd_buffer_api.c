@@ -217,3 +217,21 @@ whd_result_t whd_buffer_add_remove_at_front(whd_driver_t whd_driver, whd_buffer_
 
     return WHD_WLAN_NOFUNCTION;
 }
+
+/** Retrieves the alignment guaranteed for packet buffers
+ *
+ *  Implemented in the port layer interface, optional.
+ *  A port layer that returns N promises that packet buffers start on an N byte boundary
+ *  and are padded to a multiple of N bytes.
+ *
+ *  @return : The alignment in bytes, 0 if the port layer does not guarantee one
+ */
+uint32_t whd_buffer_get_alignment(whd_driver_t whd_driver)
+{
+    if (whd_driver->buffer_if->whd_buffer_get_alignment)
+    {
+        return whd_driver->buffer_if->whd_buffer_get_alignment();
+    }
+
+    return 0;
+}
@@ -54,6 +54,8 @@
 /* QoS related definitions (type of service) */
 #define IPV4_DSCP_OFFSET              (15)      /** Offset for finding the DSCP field in an IPv4 header */
 
+#define WHD_CDC_TX_BATCH_CHUNK        (16)      /** Packets handed to the bus in one go by whd_cdc_tx_queue_data_batch */
+
 #define IOCTL_OFFSET (sizeof(whd_buffer_header_t) + 12 + 16)
 #define WHD_IOCTL_PACKET_TIMEOUT      (0xFFFFFFFF)
 #define WHD_IOCTL_TIMEOUT_MS         (5000)     /** Need to give enough time for coming out of Deep sleep (was 400) */
@@ -89,6 +91,11 @@ static const uint8_t dscp_to_wmm_qos[] =
 ******************************************************/
 
 static uint8_t         whd_map_dscp_to_priority(whd_driver_t whd_driver, uint8_t dscp_val);
+static whd_result_t    whd_cdc_send_ioctl_async(whd_interface_t ifp, cdc_command_type_t type, uint32_t command,
+                                                whd_buffer_t send_buffer_hnd, uint32_t timeout_ms,
+                                                whd_ioctl_async_callback_t callback, void *user_data,
+                                                uint16_t *request);
+static whd_result_t    whd_cdc_cancel_ioctl_async(whd_driver_t whd_driver, uint16_t request);
 
 /******************************************************
 *             Static Functions
@@ -108,6 +115,170 @@ static uint8_t whd_map_dscp_to_priority(whd_driver_t whd_driver, uint8_t val)
     return dscp_to_wmm_qos[dscp_val];
 }
 
+/* Returns the pending IOCTL entry waiting for id, the caller holds ioctl_mutex */
+static whd_cdc_ioctl_pending_t *whd_cdc_ioctl_find(whd_cdc_bdc_info_t *cdc_bdc_info, uint16_t id)
+{
+    uint32_t i;
+
+    for (i = 0; i < WHD_CDC_MAX_PENDING_IOCTLS; i++)
+    {
+        if (cdc_bdc_info->ioctl_pending[i].id == id)
+        {
+            return &cdc_bdc_info->ioctl_pending[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Frees a pending IOCTL entry, the caller holds ioctl_mutex and releases a slot afterwards */
+static void whd_cdc_ioctl_free(whd_cdc_ioctl_pending_t *pending)
+{
+    pending->id = 0;
+    pending->response = NULL;
+    pending->callback = NULL;
+    pending->user_data = NULL;
+    pending->ifp = NULL;
+}
+
+/** Takes a free pending IOCTL entry and gives it a new request ID
+ *
+ *  A sender which waits for the response (callback NULL) waits while all WHD_CDC_MAX_PENDING_IOCTLS
+ *  entries are in use, an asynchronous sender does not.
+ *
+ * @return The entry, or NULL if none is free or on a semaphore error
+ */
+static whd_cdc_ioctl_pending_t *whd_cdc_ioctl_claim(whd_cdc_bdc_info_t *cdc_bdc_info, whd_interface_t ifp,
+                                                    uint32_t timeout_ms, whd_ioctl_async_callback_t callback,
+                                                    void *user_data)
+{
+    whd_cdc_ioctl_pending_t *pending;
+    uint16_t id;
+
+    if (cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_slots, (callback == NULL) ? CY_RTOS_NEVER_TIMEOUT : 0,
+                              WHD_FALSE) != WHD_SUCCESS)
+    {
+        return NULL;
+    }
+    if (cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
+    {
+        (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_slots, WHD_FALSE);
+        return NULL;
+    }
+
+    /* Holding a slot guarantees a free entry */
+    pending = whd_cdc_ioctl_find(cdc_bdc_info, 0);
+
+    /* ID 0 marks a free entry. IDs wrap, skip any still waiting for a response */
+    do
+    {
+        id = ++cdc_bdc_info->requested_ioctl_id;
+    } while ( (id == 0) || (whd_cdc_ioctl_find(cdc_bdc_info, id) != NULL) );
+
+    pending->id = id;
+    pending->response = NULL;
+    pending->callback = callback;
+    pending->user_data = user_data;
+    pending->ifp = ifp;
+    pending->timeout_ms = timeout_ms;
+    (void)cy_rtos_get_time(&pending->start_time);
+
+    (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE);
+
+    return pending;
+}
+
+/** Frees a pending IOCTL entry
+ *
+ * @return The response stored for it, NULL if none arrived
+ */
+static whd_buffer_t whd_cdc_ioctl_unclaim(whd_cdc_bdc_info_t *cdc_bdc_info, whd_cdc_ioctl_pending_t *pending)
+{
+    whd_buffer_t response;
+
+    (void)cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE);
+    response = pending->response;
+    whd_cdc_ioctl_free(pending);
+    (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE);
+
+    /* A response which arrived after the wait timed out left the semaphore set */
+    (void)cy_rtos_get_semaphore(&pending->done, 0, WHD_FALSE);
+    (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_slots, WHD_FALSE);
+
+    return response;
+}
+
+/** Strips the CDC header from an IOCTL response
+ *
+ * @param response_buffer_hnd : Receives the response, NULL to release it. Set to NULL if the IOCTL failed
+ *
+ * @return WHD_SUCCESS, or the error the firmware reported
+ */
+static whd_result_t whd_cdc_ioctl_response(whd_driver_t whd_driver, whd_buffer_t response,
+                                           whd_buffer_t *response_buffer_hnd)
+{
+    uint32_t flags;
+    uint32_t status;
+    cdc_header_t *cdc_header;
+
+    cdc_header    = (cdc_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, response);
+    CHECK_PACKET_NULL(cdc_header, WHD_NO_REGISTER_FUNCTION_POINTER);
+    flags         = dtoh32(cdc_header->flags);
+    status        = dtoh32(cdc_header->status);
+    /* Check if the caller wants the response */
+    if (response_buffer_hnd != NULL)
+    {
+        *response_buffer_hnd = response;
+        CHECK_RETURN(whd_buffer_add_remove_at_front(whd_driver, response_buffer_hnd, sizeof(cdc_header_t) ) );
+    }
+    else
+    {
+        CHECK_RETURN(whd_buffer_release(whd_driver, response, WHD_NETWORK_RX) );
+    }
+
+    /* Check whether the IOCTL response indicates it failed. */
+    if ( (flags & CDCF_IOC_ERROR) != 0 )
+    {
+        if (response_buffer_hnd != NULL)
+        {
+            CHECK_RETURN(whd_buffer_release(whd_driver, *response_buffer_hnd, WHD_NETWORK_RX) );
+            *response_buffer_hnd = NULL;
+        }
+        if (status)
+            return WHD_RESULT_CREATE( (WLAN_ENUM_OFFSET - status) );
+        else
+            return WHD_IOCTL_FAIL;
+    }
+
+    return WHD_SUCCESS;
+}
+
+/* Hands the response of an asynchronous IOCTL to its callback, then releases it */
+static void whd_cdc_ioctl_deliver(whd_driver_t whd_driver, whd_interface_t ifp, whd_ioctl_async_callback_t callback,
+                                  void *user_data, whd_buffer_t response)
+{
+    whd_buffer_t data_buffer = NULL;
+    whd_result_t result;
+
+    result = whd_cdc_ioctl_response(whd_driver, response, &data_buffer);
+    if ( (result == WHD_SUCCESS) && (data_buffer != NULL) )
+    {
+        callback(ifp, WHD_SUCCESS, whd_buffer_get_current_piece_data_pointer(whd_driver, data_buffer),
+                 whd_buffer_get_current_piece_size(whd_driver, data_buffer), user_data);
+    }
+    else
+    {
+        callback(ifp, result, NULL, 0, user_data);
+    }
+
+    if (data_buffer != NULL)
+    {
+        result = whd_buffer_release(whd_driver, data_buffer, WHD_NETWORK_RX);
+        if (result != WHD_SUCCESS)
+            WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
+    }
+}
+
 static whd_result_t whd_cdc_set_ioctl(whd_interface_t ifp, uint32_t command,
                                       whd_buffer_t send_buffer_hnd,
                                       whd_buffer_t *response_buffer_hnd)
@@ -136,6 +307,112 @@ static whd_result_t whd_cdc_get_iovar(whd_interface_t ifp,
     return whd_cdc_send_iovar(ifp, CDC_GET, send_buffer_hnd, response_buffer_hnd);
 }
 
+static whd_result_t whd_cdc_set_ioctl_async(whd_interface_t ifp, uint32_t command, whd_buffer_t send_buffer_hnd,
+                                            uint32_t timeout_ms, whd_ioctl_async_callback_t callback,
+                                            void *user_data, uint16_t *request)
+{
+    return whd_cdc_send_ioctl_async(ifp, CDC_SET, command, send_buffer_hnd, timeout_ms, callback, user_data,
+                                    request);
+}
+
+static whd_result_t whd_cdc_get_ioctl_async(whd_interface_t ifp, uint32_t command, whd_buffer_t send_buffer_hnd,
+                                            uint32_t timeout_ms, whd_ioctl_async_callback_t callback,
+                                            void *user_data, uint16_t *request)
+{
+    return whd_cdc_send_ioctl_async(ifp, CDC_GET, command, send_buffer_hnd, timeout_ms, callback, user_data,
+                                    request);
+}
+
+/* Gets the CDC header of an IOCTL packet, which follows the padding set when the packet was allocated */
+static cdc_header_t *whd_cdc_ioctl_header(bus_common_header_t *send_packet)
+{
+    return (cdc_header_t *)( (uint8_t *)&send_packet[1] + whd_sdpcm_get_control_pad(send_packet) );
+}
+
+/** Checks an IOCTL packet and trims it to what is sent to the firmware
+ *
+ * @param data_length : Receives the length of the IOCTL data for the CDC header
+ */
+static whd_result_t whd_cdc_ioctl_prepare(whd_interface_t ifp, uint32_t command, whd_buffer_t send_buffer_hnd,
+                                          uint32_t *data_length)
+{
+    bus_common_header_t *send_packet;
+    whd_driver_t whd_driver = ifp->whd_driver;
+
+    /* Validate the command value */
+    if (command > INT_MAX)
+    {
+        WPRINT_WHD_ERROR( ("The ioctl command value is invalid\n") );
+        return WHD_BADARG;
+    }
+
+    send_packet = (bus_common_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, send_buffer_hnd);
+    CHECK_PACKET_NULL(send_packet, WHD_NO_REGISTER_FUNCTION_POINTER);
+    WHD_IOCTL_LOG_ADD(ifp->whd_driver, command, send_buffer_hnd);
+
+    /* IOVAR name and data are already in place after the CDC header, see whd_cdc_get_iovar_buffer() */
+    *data_length =
+        (uint32_t)(whd_buffer_get_current_piece_size(whd_driver,
+                                                     send_buffer_hnd) - sizeof(bus_common_header_t) -
+                   whd_sdpcm_get_control_pad(send_packet) - sizeof(cdc_header_t) );
+
+    /* Manufacturing test can receive big buffers, but sending big buffers causes a wlan firmware error */
+    /* Even though data portion needs to be truncated, cdc_header should have the actual length of the ioctl packet */
+    if (whd_buffer_get_current_piece_size(whd_driver, send_buffer_hnd) > WHD_IOCTL_MAX_TX_PKT_LEN)
+    {
+        CHECK_RETURN(whd_buffer_set_size(whd_driver, send_buffer_hnd, WHD_IOCTL_MAX_TX_PKT_LEN) );
+    }
+
+    return WHD_SUCCESS;
+}
+
+/* Fills in the CDC header of a prepared IOCTL packet and passes it to the bus */
+static whd_result_t whd_cdc_ioctl_submit(whd_interface_t ifp, cdc_command_type_t type, uint32_t command,
+                                         whd_buffer_t send_buffer_hnd, uint32_t data_length,
+                                         uint32_t requested_ioctl_id)
+{
+    bus_common_header_t *send_packet;
+    cdc_header_t *cdc_header;
+    uint32_t bss_index = ifp->bsscfgidx;
+    whd_driver_t whd_driver = ifp->whd_driver;
+#ifdef BUS_ENC
+    unsigned char tag[16];
+    uint8_t *out;
+    uint8_t *data;
+    mbedtls_gcm_context ctx;
+    mbedtls_cipher_id_t cipher = MBEDTLS_CIPHER_ID_AES;
+    mbedtls_gcm_setkey( &ctx, cipher, whd_driver->key, GCM_KEY_SIZE );
+#endif /* BUS_ENC */
+
+    send_packet = (bus_common_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, send_buffer_hnd);
+    CHECK_PACKET_NULL(send_packet, WHD_NO_REGISTER_FUNCTION_POINTER);
+    cdc_header = whd_cdc_ioctl_header(send_packet);
+
+    /* Prepare the CDC header */
+    cdc_header->cmd    = htod32(command);
+    cdc_header->len    = htod32(data_length);
+
+    cdc_header->flags  = ( (requested_ioctl_id << CDCF_IOC_ID_SHIFT)
+                           & CDCF_IOC_ID_MASK ) | type | bss_index << CDCF_IOC_IF_SHIFT;
+    cdc_header->flags = htod32(cdc_header->flags);
+#ifdef BUS_ENC
+    cdc_header->flags  |= (CDCF_IOC_ENC << CDCF_IOC_ENC_SHIFT);
+#endif /* BUS_ENC */
+
+    cdc_header->status = 0;
+#ifdef BUS_ENC
+    data = (uint8_t *)DATA_AFTER_HEADER(cdc_header);
+    out = whd_mem_malloc(data_length + 16);
+    mbedtls_gcm_crypt_and_tag( &ctx, MBEDTLS_GCM_ENCRYPT, data_length, whd_driver->iv,
+               GCM_IV_SIZE, aad, sizeof(aad),  data, out, sizeof(tag), tag);
+    whd_mem_memcpy(DATA_AFTER_HEADER(cdc_header), out, data_length);
+    whd_mem_free(out);
+#endif /* BUS_ENC */
+
+    /* Store the length of the data and the IO control header and pass "down" */
+    return whd_send_to_bus(whd_driver, send_buffer_hnd, CONTROL_HEADER, 8);
+}
+
 /** Sends an IOCTL command
  *
  *  Sends a I/O Control command to the Broadcom 802.11 device.
@@ -146,7 +423,7 @@ static whd_result_t whd_cdc_get_iovar(whd_interface_t ifp,
  *
  *  @Note: The caller is responsible for releasing the response buffer.
  *  @Note: The function blocks until the IOCTL has completed
- *  @Note: Only one IOCTL may happen simultaneously.
+ *  @Note: Up to WHD_CDC_MAX_PENDING_IOCTLS IOCTLs may be outstanding, further callers wait for one to complete.
  *
  *  @param type       : CDC_SET or CDC_GET - indicating whether to set or get the I/O control
  *  @param send_buffer_hnd : A handle for a packet buffer containing the data value to be sent.
@@ -160,152 +437,194 @@ whd_result_t whd_cdc_send_ioctl(whd_interface_t ifp, cdc_command_type_t type, ui
                                 whd_buffer_t send_buffer_hnd,
                                 whd_buffer_t *response_buffer_hnd)
 {
-
     uint32_t data_length;
-    uint32_t flags;
     uint32_t requested_ioctl_id;
-    uint32_t status;
     whd_result_t retval;
-    control_header_t *send_packet;
-    cdc_header_t *cdc_header;
-    uint32_t bss_index = ifp->bsscfgidx;
+    whd_cdc_ioctl_pending_t *pending;
+    whd_buffer_t response;
     whd_driver_t whd_driver = ifp->whd_driver;
     whd_cdc_bdc_info_t *cdc_bdc_info = whd_driver->proto->pd;
-#ifdef BUS_ENC
-    unsigned char tag[16];
-    uint8_t *out;
-    uint8_t *data;
-    mbedtls_gcm_context ctx;
-    mbedtls_cipher_id_t cipher = MBEDTLS_CIPHER_ID_AES;
-    mbedtls_gcm_setkey( &ctx, cipher, whd_driver->key, GCM_KEY_SIZE );
-#endif /* BUS_ENC */
 
-    /* Validate the command value */
-    if (command > INT_MAX)
+    CHECK_RETURN(whd_cdc_ioctl_prepare(ifp, command, send_buffer_hnd, &data_length) );
+
+    /* Take an entry to receive the response in, the ID pairs it with the request */
+    pending = whd_cdc_ioctl_claim(cdc_bdc_info, ifp, 0, NULL, NULL);
+    if (pending == NULL)
     {
-        WPRINT_WHD_ERROR( ("The ioctl command value is invalid\n") );
-        return WHD_BADARG;
+        CHECK_RETURN(whd_buffer_release(whd_driver, send_buffer_hnd, WHD_NETWORK_TX) );
+        return WHD_SEMAPHORE_ERROR;
     }
+    requested_ioctl_id = (uint32_t)pending->id;
 
-    /* Acquire mutex which prevents multiple simultaneous IOCTLs */
-    retval = cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE);
+    retval = whd_cdc_ioctl_submit(ifp, type, command, send_buffer_hnd, data_length, requested_ioctl_id);
+    if (retval == WHD_SUCCESS)
+    {
+        /* Wait till response has been received, other IOCTLs may be sent and completed meanwhile */
+        retval = cy_rtos_get_semaphore(&pending->done, (uint32_t)WHD_IOCTL_TIMEOUT_MS, WHD_FALSE);
+    }
+
+    response = whd_cdc_ioctl_unclaim(cdc_bdc_info, pending);
     if (retval != WHD_SUCCESS)
     {
-        CHECK_RETURN(whd_buffer_release(whd_driver, send_buffer_hnd, WHD_NETWORK_TX) );
+        WPRINT_WHD_DEBUG( ("IOCTL %" PRIu32 " ID %" PRIu32 " not answered, result %" PRIu32 "\n", command,
+                           requested_ioctl_id, retval) );
+        /* It may have arrived between the timeout and freeing the entry */
+        if (response != NULL)
+        {
+            CHECK_RETURN(whd_buffer_release(whd_driver, response, WHD_NETWORK_RX) );
+        }
         return retval;
     }
 
-    /* Count request ioctl ID after acquiring ioctl mutex */
-    requested_ioctl_id = (uint32_t)(++cdc_bdc_info->requested_ioctl_id);
-
-    /* Get the data length and cast packet to a CDC BUS header */
-    data_length =
-        (uint32_t)(whd_buffer_get_current_piece_size(whd_driver,
-                                                     send_buffer_hnd) - sizeof(bus_common_header_t) -
-                   sizeof(cdc_header_t) );
+    return whd_cdc_ioctl_response(whd_driver, response, response_buffer_hnd);
+}
 
-    send_packet = (control_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, send_buffer_hnd);
-    CHECK_PACKET_NULL(send_packet, WHD_NO_REGISTER_FUNCTION_POINTER);
-    WHD_IOCTL_LOG_ADD(ifp->whd_driver, command, send_buffer_hnd);
+/** Sends an IOCTL command without waiting for the response
+ *
+ *  The response goes to callback from the WHD thread, see whd_proto_set_ioctl_async.
+ *  Asynchronous IOCTLs share the WHD_CDC_MAX_PENDING_IOCTLS entries with blocking ones.
+ *
+ *  @return    WHD_SUCCESS once sent, WHD_WLAN_BUSY if all entries are in use
+ */
+static whd_result_t whd_cdc_send_ioctl_async(whd_interface_t ifp, cdc_command_type_t type, uint32_t command,
+                                             whd_buffer_t send_buffer_hnd, uint32_t timeout_ms,
+                                             whd_ioctl_async_callback_t callback, void *user_data,
+                                             uint16_t *request)
+{
+    uint32_t data_length;
+    uint16_t id;
+    whd_result_t retval;
+    whd_cdc_ioctl_pending_t *pending;
+    whd_driver_t whd_driver = ifp->whd_driver;
+    whd_cdc_bdc_info_t *cdc_bdc_info = whd_driver->proto->pd;
 
-    /* Check if IOCTL is actually IOVAR */
-    if ( (command == WLC_SET_VAR) || (command == WLC_GET_VAR) )
+    if (callback == NULL)
     {
-        uint8_t *data = (uint8_t *)DATA_AFTER_HEADER(send_packet);
-        uint8_t *ptr = data;
-
-        /* Calculate the offset added to compensate for IOVAR string creating unaligned data section */
-        while (*ptr == 0)
-        {
-            ptr++;
-        }
-        if (data != ptr)
-        {
-            data_length -= (uint32_t)(ptr - data);
-            memmove(data, ptr, data_length);
-            CHECK_RETURN(whd_buffer_set_size(whd_driver, send_buffer_hnd,
-                                             (uint16_t)(data_length + sizeof(bus_common_header_t) +
-                                                        sizeof(cdc_header_t) ) ) );
-        }
+        CHECK_RETURN(whd_buffer_release(whd_driver, send_buffer_hnd, WHD_NETWORK_TX) );
+        return WHD_BADARG;
     }
 
-    /* Prepare the CDC header */
-    send_packet->cdc_header.cmd    = htod32(command);
-    send_packet->cdc_header.len    = htod32(data_length);
+    CHECK_RETURN(whd_cdc_ioctl_prepare(ifp, command, send_buffer_hnd, &data_length) );
 
-    send_packet->cdc_header.flags  = ( (requested_ioctl_id << CDCF_IOC_ID_SHIFT)
-                                       & CDCF_IOC_ID_MASK ) | type | bss_index << CDCF_IOC_IF_SHIFT;
-    send_packet->cdc_header.flags = htod32(send_packet->cdc_header.flags);
-#ifdef BUS_ENC
-    send_packet->cdc_header.flags  |= (CDCF_IOC_ENC << CDCF_IOC_ENC_SHIFT);
-#endif /* BUS_ENC */
+    pending = whd_cdc_ioctl_claim(cdc_bdc_info, ifp, (timeout_ms != 0) ? timeout_ms : WHD_IOCTL_TIMEOUT_MS,
+                                  callback, user_data);
+    if (pending == NULL)
+    {
+        CHECK_RETURN(whd_buffer_release(whd_driver, send_buffer_hnd, WHD_NETWORK_TX) );
+        return WHD_WLAN_BUSY;
+    }
 
-    send_packet->cdc_header.status = 0;
+    /* The entry belongs to the WHD thread once sent, it may complete before the send returns */
+    id = pending->id;
+    if (request != NULL)
+    {
+        *request = id;
+    }
 
-    /* Manufacturing test can receive big buffers, but sending big buffers causes a wlan firmware error */
-    /* Even though data portion needs to be truncated, cdc_header should have the actual length of the ioctl packet */
-    if (whd_buffer_get_current_piece_size(whd_driver, send_buffer_hnd) > WHD_IOCTL_MAX_TX_PKT_LEN)
+    retval = whd_cdc_ioctl_submit(ifp, type, command, send_buffer_hnd, data_length, id);
+    if ( (retval != WHD_SUCCESS) && (whd_cdc_cancel_ioctl_async(whd_driver, id) != WHD_SUCCESS) )
     {
-        CHECK_RETURN(whd_buffer_set_size(whd_driver, send_buffer_hnd, WHD_IOCTL_MAX_TX_PKT_LEN) );
+        /* It timed out meanwhile and the callback has already reported it */
+        retval = WHD_SUCCESS;
     }
-#ifdef BUS_ENC
-    data = (uint8_t *)DATA_AFTER_HEADER(send_packet);
-    out = whd_mem_malloc(data_length + 16);
-    mbedtls_gcm_crypt_and_tag( &ctx, MBEDTLS_GCM_ENCRYPT, data_length, whd_driver->iv,
-               GCM_IV_SIZE, aad, sizeof(aad),  data, out, sizeof(tag), tag);
-    whd_mem_memcpy(DATA_AFTER_HEADER(send_packet), out, data_length);
-    whd_mem_free(out);
-#endif /* BUS_ENC */
 
-    /* Store the length of the data and the IO control header and pass "down" */
-    CHECK_RETURN(whd_send_to_bus(whd_driver, send_buffer_hnd, CONTROL_HEADER, 8) );
+    return retval;
+}
 
+/** Cancels an asynchronous IOCTL, its callback will not run and a late response is dropped
+ *
+ *  @return    WHD_SUCCESS, or WHD_DOES_NOT_EXIST if the callback already ran or is running
+ */
+static whd_result_t whd_cdc_cancel_ioctl_async(whd_driver_t whd_driver, uint16_t request)
+{
+    whd_cdc_bdc_info_t *cdc_bdc_info = whd_driver->proto->pd;
+    whd_cdc_ioctl_pending_t *pending = NULL;
 
-    /* Wait till response has been received  */
-    retval = cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_sleep, (uint32_t)WHD_IOCTL_TIMEOUT_MS, WHD_FALSE);
-    if (retval != WHD_SUCCESS)
+    if (request == 0)
     {
-        /* Release the mutex since ioctl response will no longer be referenced. */
-        WPRINT_WHD_DEBUG(("Release the mutex since ioctl response will no longer be referenced !\n"));
-        CHECK_RETURN(cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE) );
-        return retval;
+        return WHD_BADARG;
     }
 
-    cdc_header    = (cdc_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, cdc_bdc_info->ioctl_response);
-    CHECK_PACKET_NULL(cdc_header, WHD_NO_REGISTER_FUNCTION_POINTER);
-    flags         = dtoh32(cdc_header->flags);
-    status        = dtoh32(cdc_header->status);
-    /* Check if the caller wants the response */
-    if (response_buffer_hnd != NULL)
+    if (cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
     {
-        *response_buffer_hnd = cdc_bdc_info->ioctl_response;
-        CHECK_RETURN(whd_buffer_add_remove_at_front(whd_driver, response_buffer_hnd, sizeof(cdc_header_t) ) );
+        return WHD_SEMAPHORE_ERROR;
+    }
+    pending = whd_cdc_ioctl_find(cdc_bdc_info, request);
+    if ( (pending != NULL) && (pending->callback != NULL) )
+    {
+        whd_cdc_ioctl_free(pending);
     }
     else
     {
-        CHECK_RETURN(whd_buffer_release(whd_driver, cdc_bdc_info->ioctl_response, WHD_NETWORK_RX) );
+        pending = NULL;
     }
+    (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE);
 
-    cdc_bdc_info->ioctl_response = NULL;
+    if (pending == NULL)
+    {
+        return WHD_DOES_NOT_EXIST;
+    }
+    (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_slots, WHD_FALSE);
 
-    /* Release the mutex since ioctl response will no longer be referenced. */
-    CHECK_RETURN(cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE) );
+    return WHD_SUCCESS;
+}
 
-    /* Check whether the IOCTL response indicates it failed. */
-    if ( (flags & CDCF_IOC_ERROR) != 0 )
+/** Reports WHD_TIMEOUT for asynchronous IOCTLs not answered in time, called by the WHD thread
+ *
+ * @return Milliseconds until the next one times out, 0 if none is outstanding
+ */
+static uint32_t whd_cdc_poll_ioctl_async(whd_driver_t whd_driver)
+{
+    whd_cdc_bdc_info_t *cdc_bdc_info = whd_driver->proto->pd;
+    whd_cdc_ioctl_pending_t *pending;
+    whd_ioctl_async_callback_t callback;
+    void *user_data;
+    whd_interface_t ifp;
+    cy_time_t now;
+    uint32_t elapsed;
+    uint32_t next_timeout_ms = 0;
+    uint32_t i;
+
+    (void)cy_rtos_get_time(&now);
+
+    for (i = 0; i < WHD_CDC_MAX_PENDING_IOCTLS; i++)
     {
-        if (response_buffer_hnd != NULL)
+        pending = &cdc_bdc_info->ioctl_pending[i];
+        callback = NULL;
+
+        /* Unlocked check first, the thread polls this on every pass */
+        if ( (pending->callback == NULL) ||
+             (cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS) )
         {
-            CHECK_RETURN(whd_buffer_release(whd_driver, *response_buffer_hnd, WHD_NETWORK_RX) );
-            *response_buffer_hnd = NULL;
+            continue;
+        }
+        if ( (pending->id != 0) && (pending->callback != NULL) )
+        {
+            elapsed = (uint32_t)(now - pending->start_time);
+            if (elapsed >= pending->timeout_ms)
+            {
+                WPRINT_WHD_DEBUG( ("Async IOCTL ID %d not answered in %" PRIu32 " ms\n", pending->id,
+                                   pending->timeout_ms) );
+                callback = pending->callback;
+                user_data = pending->user_data;
+                ifp = pending->ifp;
+                whd_cdc_ioctl_free(pending);
+            }
+            else if ( (next_timeout_ms == 0) || (pending->timeout_ms - elapsed < next_timeout_ms) )
+            {
+                next_timeout_ms = pending->timeout_ms - elapsed;
+            }
+        }
+        (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE);
+
+        if (callback != NULL)
+        {
+            (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_slots, WHD_FALSE);
+            callback(ifp, WHD_TIMEOUT, NULL, 0, user_data);
         }
-        if (status)
-            return WHD_RESULT_CREATE( (WLAN_ENUM_OFFSET - status) );
-        else
-            return WHD_IOCTL_FAIL;
     }
 
-    return WHD_SUCCESS;
+    return next_timeout_ms;
 }
 
 /** Sets/Gets an I/O Variable (IOVar)
@@ -339,6 +658,9 @@ whd_result_t whd_cdc_send_iovar(whd_interface_t ifp, cdc_command_type_t type,
 }
 
 /** A helper function to easily acquire and initialise a buffer destined for use as an iovar
+ *
+ * The name and data are placed where they are sent from. To keep the data 4 byte aligned, padding goes
+ * between the SDPCM and CDC headers, where the firmware skips it through the SDPCM data offset.
  *
  * @param  buffer      : A pointer to a whd_buffer_t object where the created buffer will be stored
  * @param  data_length : The length of space reserved for user data
@@ -360,10 +682,10 @@ void *whd_cdc_get_iovar_buffer(whd_driver_t whd_driver,
     {
         uint8_t *data = whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer);
         CHECK_PACKET_NULL(data, NULL);
-        data = data + IOCTL_OFFSET;
-        whd_mem_memset(data, 0, name_length_alignment_offset);
-        whd_mem_memcpy(data + name_length_alignment_offset, name, name_length);
-        return (data + name_length + name_length_alignment_offset);
+        whd_sdpcm_set_control_pad( (bus_common_header_t *)data, (uint8_t)name_length_alignment_offset );
+        data = data + IOCTL_OFFSET + name_length_alignment_offset;
+        whd_mem_memcpy(data, name, name_length);
+        return (data + name_length);
     }
     else
     {
@@ -383,6 +705,8 @@ void *whd_cdc_get_ioctl_buffer(whd_driver_t whd_driver,
                                whd_buffer_t *buffer,
                                uint16_t data_length)
 {
+    uint8_t *data;
+
     if ( (uint32_t)IOCTL_OFFSET + data_length > USHRT_MAX )
     {
         WPRINT_WHD_ERROR( ("The reserved ioctl buffer length is over %u\n", USHRT_MAX) );
@@ -391,7 +715,10 @@ void *whd_cdc_get_ioctl_buffer(whd_driver_t whd_driver,
     if (whd_host_buffer_get(whd_driver, buffer, WHD_NETWORK_TX, (uint16_t)(IOCTL_OFFSET + data_length),
                             (uint32_t)WHD_IOCTL_PACKET_TIMEOUT) == WHD_SUCCESS)
     {
-        return (whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer) + IOCTL_OFFSET);
+        data = whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer);
+        CHECK_PACKET_NULL(data, NULL);
+        whd_sdpcm_set_control_pad( (bus_common_header_t *)data, 0 );
+        return (data + IOCTL_OFFSET);
     }
     else
     {
@@ -400,20 +727,17 @@ void *whd_cdc_get_ioctl_buffer(whd_driver_t whd_driver,
     }
 }
 
-/** Sends a data packet.
- *
- *  This function should be called by the bottom of the network stack in order for it
- *  to send an ethernet frame.
- *  The function prepends a BDC header, before sending to @ref whd_send_to_bus where
- *  the BUS header will be added
+/** Prepends the BDC header to a data packet
  *
- * @param buffer  : The ethernet packet buffer to be sent
- * @param interface : the interface over which to send the packet (AP or STA)
+ * @param ifp        : the interface over which to send the packet (AP or STA)
+ * @param buffer_ptr : The ethernet packet buffer, updated to include the BDC header
+ * @param prio       : Receives the priority of the packet
  *
- * @return    WHD result code
+ * @return    WHD result code, the buffer is released on failure
  */
-whd_result_t whd_cdc_tx_queue_data(whd_interface_t ifp, whd_buffer_t buffer)
+static whd_result_t whd_cdc_tx_prepare_data(whd_interface_t ifp, whd_buffer_t *buffer_ptr, uint8_t *prio)
 {
+    whd_buffer_t buffer = *buffer_ptr;
     data_header_t *packet;
     whd_result_t result;
     uint8_t *dscp = NULL;
@@ -505,9 +829,83 @@ whd_result_t whd_cdc_tx_queue_data(whd_interface_t ifp, whd_buffer_t buffer)
    whd_mem_free(out);
    mbedtls_gcm_free( &ctx );
 #endif /* BUS_ENC */
+    *buffer_ptr = buffer;
+    *prio = packet->bdc_header.priority;
+    return WHD_SUCCESS;
+}
+
+/** Sends a data packet.
+ *
+ *  This function should be called by the bottom of the network stack in order for it
+ *  to send an ethernet frame.
+ *  The function prepends a BDC header, before sending to @ref whd_send_to_bus where
+ *  the BUS header will be added
+ *
+ * @param buffer  : The ethernet packet buffer to be sent
+ * @param interface : the interface over which to send the packet (AP or STA)
+ *
+ * @return    WHD result code
+ */
+whd_result_t whd_cdc_tx_queue_data(whd_interface_t ifp, whd_buffer_t buffer)
+{
+    whd_result_t result;
+    uint8_t prio;
+
+    result = whd_cdc_tx_prepare_data(ifp, &buffer, &prio);
+    if (result != WHD_SUCCESS)
+    {
+        return result;
+    }
+
     /* Add the length of the BDC header and pass "down" */
-    return whd_send_to_bus(whd_driver, buffer, DATA_HEADER, packet->bdc_header.priority);
+    return whd_send_to_bus(ifp->whd_driver, buffer, DATA_HEADER, prio);
+}
 
+/** Sends a batch of data packets.
+ *
+ *  Same as @ref whd_cdc_tx_queue_data for every packet, the packets are passed to
+ *  @ref whd_send_to_bus_batch in chunks of WHD_CDC_TX_BATCH_CHUNK.
+ *
+ * @param ifp     : the interface over which to send the packets (AP or STA)
+ * @param buffers : The ethernet packet buffers to be sent
+ * @param count   : Number of packets
+ *
+ * @return    WHD_SUCCESS or the first error
+ */
+whd_result_t whd_cdc_tx_queue_data_batch(whd_interface_t ifp, const whd_buffer_t *buffers, uint32_t count)
+{
+    whd_buffer_t chunk[WHD_CDC_TX_BATCH_CHUNK];
+    uint8_t prios[WHD_CDC_TX_BATCH_CHUNK];
+    whd_result_t batch_result = WHD_SUCCESS;
+    whd_result_t result;
+    uint32_t n = 0;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        chunk[n] = buffers[i];
+        result = whd_cdc_tx_prepare_data(ifp, &chunk[n], &prios[n]);
+        if (result == WHD_SUCCESS)
+        {
+            n++;
+        }
+        else if (batch_result == WHD_SUCCESS)
+        {
+            batch_result = result;
+        }
+
+        if ( (n == WHD_CDC_TX_BATCH_CHUNK) || ( (i == count - 1) && (n > 0) ) )
+        {
+            result = whd_send_to_bus_batch(ifp->whd_driver, chunk, prios, n, DATA_HEADER);
+            if ( (result != WHD_SUCCESS) && (batch_result == WHD_SUCCESS) )
+            {
+                batch_result = result;
+            }
+            n = 0;
+        }
+    }
+
+    return batch_result;
 }
 
 void whd_cdc_bdc_info_deinit(whd_driver_t whd_driver)
@@ -515,8 +913,18 @@ void whd_cdc_bdc_info_deinit(whd_driver_t whd_driver)
     whd_cdc_bdc_info_t *cdc_bdc_info = whd_driver->proto->pd;
     whd_error_info_t *error_info = &whd_driver->error_info;
 
-    /* Delete the sleep mutex */
-    (void)cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_sleep);
+    uint32_t i;
+
+    /* Delete the per request sleep semaphores */
+    for (i = 0; i < WHD_CDC_MAX_PENDING_IOCTLS; i++)
+    {
+        if (cdc_bdc_info->ioctl_pending[i].response != NULL)
+        {
+            (void)whd_buffer_release(whd_driver, cdc_bdc_info->ioctl_pending[i].response, WHD_NETWORK_RX);
+        }
+        (void)cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_pending[i].done);
+    }
+    (void)cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_slots);
 
     /* Delete the queue mutex.  */
     (void)cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_mutex);
@@ -535,12 +943,14 @@ whd_result_t whd_cdc_bdc_info_init(whd_driver_t whd_driver)
 {
     whd_cdc_bdc_info_t *cdc_bdc_info;
     whd_error_info_t *error_info = &whd_driver->error_info;
+    uint32_t i;
 
     cdc_bdc_info = (whd_cdc_bdc_info_t *)whd_mem_malloc(sizeof(whd_cdc_bdc_info_t) );
     if (!cdc_bdc_info)
     {
         return WHD_MALLOC_FAILURE;
     }
+    cdc_bdc_info->requested_ioctl_id = 0;
 
     /* Create the mutex protecting the packet send queue */
     if (cy_rtos_init_semaphore(&cdc_bdc_info->ioctl_mutex, 1, 0) != WHD_SUCCESS)
@@ -553,17 +963,38 @@ whd_result_t whd_cdc_bdc_info_init(whd_driver_t whd_driver)
         return WHD_SEMAPHORE_ERROR;
     }
 
-    /* Create the event flag which signals the whd thread needs to wake up */
-    if (cy_rtos_init_semaphore(&cdc_bdc_info->ioctl_sleep, 1, 0) != WHD_SUCCESS)
+    /* Create the count of free pending IOCTL entries */
+    if (cy_rtos_init_semaphore(&cdc_bdc_info->ioctl_slots, WHD_CDC_MAX_PENDING_IOCTLS,
+                               WHD_CDC_MAX_PENDING_IOCTLS) != WHD_SUCCESS)
     {
         cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_mutex);
         return WHD_SEMAPHORE_ERROR;
     }
 
+    /* Create the event flags which signal a sender its IOCTL response arrived */
+    for (i = 0; i < WHD_CDC_MAX_PENDING_IOCTLS; i++)
+    {
+        whd_cdc_ioctl_free(&cdc_bdc_info->ioctl_pending[i]);
+        if (cy_rtos_init_semaphore(&cdc_bdc_info->ioctl_pending[i].done, 1, 0) != WHD_SUCCESS)
+        {
+            while (i-- > 0)
+            {
+                cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_pending[i].done);
+            }
+            cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_slots);
+            cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_mutex);
+            return WHD_SEMAPHORE_ERROR;
+        }
+    }
+
     /* Create semaphore to protect event list management */
     if (cy_rtos_init_semaphore(&cdc_bdc_info->event_list_mutex, 1, 0) != WHD_SUCCESS)
     {
-        cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_sleep);
+        for (i = 0; i < WHD_CDC_MAX_PENDING_IOCTLS; i++)
+        {
+            cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_pending[i].done);
+        }
+        cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_slots);
         cy_rtos_deinit_semaphore(&cdc_bdc_info->ioctl_mutex);
         return WHD_SEMAPHORE_ERROR;
     }
@@ -598,6 +1029,12 @@ whd_result_t whd_cdc_bdc_info_init(whd_driver_t whd_driver)
     whd_driver->proto->set_iovar = whd_cdc_set_iovar;
     whd_driver->proto->get_iovar = whd_cdc_get_iovar;
     whd_driver->proto->tx_queue_data = whd_cdc_tx_queue_data;
+    whd_driver->proto->tx_queue_data_batch = whd_cdc_tx_queue_data_batch;
+    whd_driver->proto->tx_flow_controlled = whd_sdpcm_tx_flow_controlled;
+    whd_driver->proto->set_ioctl_async = whd_cdc_set_ioctl_async;
+    whd_driver->proto->get_ioctl_async = whd_cdc_get_ioctl_async;
+    whd_driver->proto->cancel_ioctl_async = whd_cdc_cancel_ioctl_async;
+    whd_driver->proto->poll_ioctl_async = whd_cdc_poll_ioctl_async;
     whd_driver->proto->pd = cdc_bdc_info;
 
     return WHD_SUCCESS;
@@ -616,7 +1053,10 @@ void whd_process_cdc(whd_driver_t whd_driver, whd_buffer_t buffer)
     whd_cdc_bdc_info_t *cdc_bdc_info = whd_driver->proto->pd;
     whd_result_t result;
     cdc_header_t *cdc_header = (cdc_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, buffer);
-    whd_result_t ioctl_mutex_res;
+    whd_cdc_ioctl_pending_t *pending = NULL;
+    whd_ioctl_async_callback_t callback;
+    void *user_data;
+    whd_interface_t ifp;
 #ifdef BUS_ENC
     unsigned char tag[16];
     uint8_t *tmp;
@@ -632,13 +1072,19 @@ void whd_process_cdc(whd_driver_t whd_driver, whd_buffer_t buffer)
     tmp = (uint8 *)&cdc_header[1];
 #endif /* BUS_ENC */
 
-    /* Validate request ioctl ID and check if whd_cdc_send_ioctl is still waiting for response*/
-    if ( ( (ioctl_mutex_res = cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_mutex, 0, WHD_FALSE) ) != WHD_SUCCESS ) &&
-         (id == cdc_bdc_info->requested_ioctl_id) )
+    /* Find the whd_cdc_send_ioctl call still waiting for this request ID */
+    result = cy_rtos_get_semaphore(&cdc_bdc_info->ioctl_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE);
+    if ( (result == WHD_SUCCESS) && (id != 0) )
     {
-        /* Save the response packet in a variable */
-        cdc_bdc_info->ioctl_response = buffer;
+        pending = whd_cdc_ioctl_find(cdc_bdc_info, id);
+        if ( (pending != NULL) && (pending->response != NULL) )
+        {
+            pending = NULL;
+        }
+    }
 
+    if (pending != NULL)
+    {
 #ifdef BUS_ENC
     if (((flags & CDCF_IOC_ENC_MASK ) == CDCF_IOC_ENC_MASK) && (dtoh32(cdc_header->len) > 0))
      {
@@ -652,34 +1098,53 @@ void whd_process_cdc(whd_driver_t whd_driver, whd_buffer_t buffer)
         whd_mem_memcpy(tmp, out, dtoh32(cdc_header->len));
         mbedtls_gcm_free( &ctx );
         whd_mem_free(out);
-        cdc_bdc_info->ioctl_response = buffer;
      }
 #endif /*BUS_ENC */
         WPRINT_WHD_DATA_LOG( ("Wcd:< Procd pkt 0x%08lX: IOCTL Response\n", (unsigned long)buffer) );
 
-        /* Wake the thread which sent the IOCTL/IOVAR so that it will resume */
-        result = cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_sleep, WHD_FALSE);
+        if (pending->callback != NULL)
+        {
+            /* Nobody waits for an asynchronous IOCTL, free its entry and run the callback from here */
+            callback = pending->callback;
+            user_data = pending->user_data;
+            ifp = pending->ifp;
+            whd_cdc_ioctl_free(pending);
+
+            result = cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE);
+            if (result != WHD_SUCCESS)
+                WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
+            (void)cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_slots, WHD_FALSE);
+
+            whd_cdc_ioctl_deliver(whd_driver, ifp, callback, user_data, buffer);
+            return;
+        }
+
+        /* Save the response packet in the entry of its request */
+        pending->response = buffer;
+
+        /* Wake the thread which sent the IOCTL/IOVAR so that it will resume. Setting it before
+         * releasing ioctl_mutex lets a sender which timed out meanwhile clear it again */
+        result = cy_rtos_set_semaphore(&pending->done, WHD_FALSE);
         if (result != WHD_SUCCESS)
             WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
 
+        result = cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE);
+        if (result != WHD_SUCCESS)
+            WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
     }
     else
     {
-        WPRINT_WHD_ERROR( ("Received buffer request ID: %d (expectation: %d)\n",
-                           id, cdc_bdc_info->requested_ioctl_id) );
-        if (ioctl_mutex_res == WHD_SUCCESS)
+        if (result == WHD_SUCCESS)
         {
-            WPRINT_WHD_ERROR( ("whd_cdc_send_ioctl is already timed out, drop the buffer\n") );
             result = cy_rtos_set_semaphore(&cdc_bdc_info->ioctl_mutex, WHD_FALSE);
             if (result != WHD_SUCCESS)
             {
                 WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
             }
         }
-        else
-        {
-            WPRINT_WHD_ERROR( ("Received a response for a different IOCTL - retry\n") );
-        }
+        WPRINT_WHD_ERROR( ("Received buffer request ID: %d (last sent: %d)\n",
+                           id, cdc_bdc_info->requested_ioctl_id) );
+        WPRINT_WHD_ERROR( ("whd_cdc_send_ioctl is no longer waiting for it, drop the buffer\n") );
 
         result = whd_buffer_release(whd_driver, buffer, WHD_NETWORK_RX);
         if (result != WHD_SUCCESS)
@@ -882,6 +1347,7 @@ void whd_process_bdc_event(whd_driver_t whd_driver, whd_buffer_t buffer, uint16_
     /* do any needed debug logging of event */
     WHD_IOCTL_LOG_ADD_EVENT(whd_driver, whd_event->event_type, whd_event->status,
                             whd_event->reason);
+    whd_iovar_cache_event(whd_driver, whd_event);
 
     if (cy_rtos_get_semaphore(&cdc_bdc_info->event_list_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
     {
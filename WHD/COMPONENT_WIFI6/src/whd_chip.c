@@ -132,11 +132,12 @@ whd_result_t whd_internal_info_init(whd_driver_t whd_driver)
         return WHD_SEMAPHORE_ERROR;
     }
 #endif
-    return WHD_SUCCESS;
+    return whd_iovar_cache_init(whd_driver);
 }
 
 whd_result_t whd_internal_info_deinit(whd_driver_t whd_driver)
 {
+    whd_iovar_cache_deinit(whd_driver);
 #ifdef WHD_IOCTL_LOG_ENABLE
     /* Delete the whd_log mutex */
     (void)cy_rtos_deinit_semaphore(&whd_driver->whd_log_mutex);
@@ -690,8 +691,8 @@ whd_result_t whd_ioctl_log_add(whd_driver_t whd_driver, uint32_t cmd, whd_buffer
     CHECK_IOCTL_BUFFER(data);
     CHECK_RETURN(cy_rtos_get_semaphore(&whd_driver->whd_log_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) );
 #ifndef PROTO_MSGBUF
-    data = data + IOCTL_OFFSET;
-    data_size = data_size - IOCTL_OFFSET;
+    data_size = data_size - IOCTL_OFFSET - whd_sdpcm_get_control_pad( (bus_common_header_t *)data );
+    data = data + IOCTL_OFFSET + whd_sdpcm_get_control_pad( (bus_common_header_t *)data );
 #endif
     whd_driver->whd_ioctl_log[whd_driver->whd_ioctl_log_index % WHD_IOCTL_LOG_SIZE].ioct_log = cmd;
     whd_driver->whd_ioctl_log[whd_driver->whd_ioctl_log_index % WHD_IOCTL_LOG_SIZE].is_this_event = 0;
@@ -735,13 +736,7 @@ whd_result_t whd_ioctl_print(whd_driver_t whd_driver)
         if ( (whd_driver->whd_ioctl_log[i].ioct_log == WLC_SET_VAR) ||
              (whd_driver->whd_ioctl_log[i].ioct_log == WLC_GET_VAR) )
         {
-            /* refer to whd_cdc_get_iovar_buffer()/whd_msgbuf_get_iovar_buffer() */
-            while (!*data)
-            {
-                whd_driver->whd_ioctl_log[i].data_size--;
-                data++;
-            }
-
+            /* The name starts the data, refer to whd_cdc_get_iovar_buffer()/whd_msgbuf_get_iovar_buffer() */
             if (strlen( (char *)data ) <= WHD_IOVAR_STRING_SIZE)
                 strncpy(iovar, (char *)data, strlen( (char *)data ) );
 
@@ -1004,7 +999,7 @@ whd_result_t whd_wifi_read_fw_capabilities(whd_interface_t ifp)
     CHECK_IFP_NULL(ifp);
     whd_driver_t whd_driver = ifp->whd_driver;
 
-    result = whd_wifi_get_iovar_buffer(ifp, IOVAR_STR_CAP, (uint8_t *)caps, sizeof(caps) );
+    result = whd_iovar_cache_get_iovar(ifp, WHD_IOVAR_CACHE_FIRMWARE, IOVAR_STR_CAP, (uint8_t *)caps, sizeof(caps) );
     CHECK_RETURN(result);
 
     for (uint32_t i = 0; i < ARRAY_SIZE(whd_fwcap_map); i++)
@@ -1467,6 +1462,9 @@ whd_result_t whd_wlan_bus_complete_ds_wake(whd_driver_t whd_driver, whd_bool_t w
             cy_rtos_delay_milliseconds(10);
         }
 
+        /* The backplane window register is back at its reset value after deep sleep */
+        whd_bus_init_backplane_window(whd_driver);
+
         CHECK_RETURN(whd_bus_read_backplane_value(whd_driver, D11SHM_ADDR(wake_event_indication_addr), 2,
                                                   (uint8_t *)&val) );
         CHECK_RETURN(whd_bus_read_backplane_value(whd_driver, D11SHM_ADDR(wake_indication_addr), 2, (uint8_t *)&val) );
@@ -1686,6 +1684,9 @@ whd_result_t whd_wlan_bus_complete_ds_wake(whd_driver_t whd_driver, whd_bool_t w
 
         whd_driver->internal_info.whd_wlan_status.state = WLAN_OFF;
 
+        /* The backplane window register is back at its reset value after deep sleep */
+        whd_bus_init_backplane_window(whd_driver);
+
         CHECK_RETURN(whd_bus_read_register_value(whd_driver, BUS_FUNCTION, SDIOD_CCCR_IOEN, (uint8_t)1, &enb_rd))
 
         if(enb_rd == SDIO_FUNC_ENABLE_1)
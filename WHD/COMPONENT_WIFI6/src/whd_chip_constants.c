@@ -25,10 +25,34 @@
 *               Function Definitions
 ******************************************************/
 
+static whd_result_t whd_chip_lookup_var(uint16_t wlan_chip_id, chip_var_t var, uint32_t *val);
+
 uint32_t whd_chip_set_chip_id(whd_driver_t whd_driver, uint16_t id)
 {
+    uint32_t val;
+    whd_result_t result;
+    int var;
+
+#ifdef WHD_CHIP_ID_PINNED
+    /* The SDIO core is accessed at the pinned chip's address, any other chip cannot be driven */
+    if (id != WHD_CHIP_ID_PINNED)
+    {
+        WPRINT_WHD_ERROR( ("Chip ID %u does not match the pinned chip ID %u\n", (unsigned int)id,
+                           (unsigned int)WHD_CHIP_ID_PINNED) );
+        return WHD_UNSUPPORTED;
+    }
+#endif
+
     whd_driver->chip_info.chip_id = id;
 
+    /* Constants the chip does not have keep the error code get_whd_var() would return */
+    for (var = 0; var < CHIP_VAR_MAX; var++)
+    {
+        val = 0;
+        result = whd_chip_lookup_var(id, (chip_var_t)var, &val);
+        whd_driver->chip_info.chip_vars[var] = (result == WHD_SUCCESS) ? val : result;
+    }
+
     return 0;
 }
 
@@ -129,109 +153,83 @@ whd_result_t whd_chip_get_chanspec_ctl_channel_num(whd_driver_t whd_driver, uint
     return WHD_SUCCESS;
 }
 
-uint32_t get_whd_var(whd_driver_t whd_driver, chip_var_t var)
+static whd_result_t whd_chip_lookup_var(uint16_t wlan_chip_id, chip_var_t var, uint32_t *val)
 {
-    uint32_t val = 0;
-
-    uint16_t wlan_chip_id = whd_chip_get_chip_id(whd_driver);
     switch (var)
     {
         case ARM_CORE_BASE_ADDRESS:
-            CHECK_RETURN(get_arm_core_base_address(wlan_chip_id, &val) );
-            break;
+            return get_arm_core_base_address(wlan_chip_id, val);
         case SOCSRAM_BASE_ADDRESS:
-            CHECK_RETURN(get_socsram_base_address(wlan_chip_id, &val, WHD_FALSE) );
-            break;
+            return get_socsram_base_address(wlan_chip_id, val, WHD_FALSE);
         case SOCSRAM_WRAPPER_BASE_ADDRESS:
-            CHECK_RETURN(get_socsram_base_address(wlan_chip_id, &val, WHD_TRUE) );
-            break;
+            return get_socsram_base_address(wlan_chip_id, val, WHD_TRUE);
         case SDIOD_CORE_BASE_ADDRESS:
-            CHECK_RETURN(get_sdiod_core_base_address(wlan_chip_id, &val) );
-            break;
+            return get_sdiod_core_base_address(wlan_chip_id, val);
         case PMU_BASE_ADDRESS:
-            CHECK_RETURN(get_pmu_base_address(wlan_chip_id, &val) );
-            break;
+            return get_pmu_base_address(wlan_chip_id, val);
         case CHIP_RAM_SIZE:
-            CHECK_RETURN(get_chip_ram_size(wlan_chip_id, &val) );
-            break;
+            return get_chip_ram_size(wlan_chip_id, val);
         case ATCM_RAM_BASE_ADDRESS:
-            CHECK_RETURN(get_atcm_ram_base_address(wlan_chip_id, &val) );
-            break;
+            return get_atcm_ram_base_address(wlan_chip_id, val);
         case SOCRAM_SRMEM_SIZE:
-            CHECK_RETURN(get_socsram_srmem_size(wlan_chip_id, &val) );
-            break;
+            return get_socsram_srmem_size(wlan_chip_id, val);
         case CHANSPEC_BAND_MASK:
-            CHECK_RETURN(get_wl_chanspec_band_mask(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_band_mask(wlan_chip_id, val);
         case CHANSPEC_BAND_2G:
-            CHECK_RETURN(get_wl_chanspec_band_2G(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_band_2G(wlan_chip_id, val);
         case CHANSPEC_BAND_5G:
-            CHECK_RETURN(get_wl_chanspec_band_5G(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_band_5G(wlan_chip_id, val);
         case CHANSPEC_BAND_6G:
-            CHECK_RETURN(get_wl_chanspec_band_6G(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_band_6G(wlan_chip_id, val);
         case CHANSPEC_BAND_SHIFT:
-            CHECK_RETURN(get_wl_chanspec_band_shift(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_band_shift(wlan_chip_id, val);
         case CHANSPEC_BW_10:
-            CHECK_RETURN(get_wl_chanspec_bw_10(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_bw_10(wlan_chip_id, val);
         case CHANSPEC_BW_20:
-            CHECK_RETURN(get_wl_chanspec_bw_20(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_bw_20(wlan_chip_id, val);
         case CHANSPEC_BW_40:
-            CHECK_RETURN(get_wl_chanspec_bw_40(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_bw_40(wlan_chip_id, val);
         case CHANSPEC_BW_80:
-            CHECK_RETURN(get_wl_chanspec_bw_80(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_bw_80(wlan_chip_id, val);
         case CHANSPEC_BW_160:
-            CHECK_RETURN(get_wl_chanspec_bw_160(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_bw_160(wlan_chip_id, val);
         case CHANSPEC_BW_MASK:
-            CHECK_RETURN(get_wl_chanspec_bw_mask(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_bw_mask(wlan_chip_id, val);
         case CHANSPEC_BW_SHIFT:
-            CHECK_RETURN(get_wl_chanspec_bw_shift(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_bw_shift(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_NONE:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_none(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_none(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_LLL:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_LLL(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_LLL(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_LLU:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_LLU(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_LLU(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_LUL:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_LUL(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_LUL(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_LUU:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_LUU(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_LUU(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_ULL:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_ULL(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_ULL(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_ULU:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_ULU(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_ULU(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_UUL:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_UUL(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_UUL(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_UUU:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_UUU(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_UUU(wlan_chip_id, val);
         case CHANSPEC_CTL_SB_MASK:
-            CHECK_RETURN(get_wl_chanspec_ctl_sb_mask(wlan_chip_id, &val) );
-            break;
+            return get_wl_chanspec_ctl_sb_mask(wlan_chip_id, val);
         case NVRAM_DNLD_ADDR:
-            CHECK_RETURN(get_nvram_dwnld_start_address(wlan_chip_id, &val) );
-            break;
+            return get_nvram_dwnld_start_address(wlan_chip_id, val);
         default:
-            break;
+            *val = 0;
+            return WHD_SUCCESS;
     }
+}
+
+uint32_t get_whd_var(whd_driver_t whd_driver, chip_var_t var)
+{
+    uint32_t val = 0;
+
+    CHECK_RETURN(whd_chip_lookup_var(whd_chip_get_chip_id(whd_driver), var, &val) );
     return val;
 }
 
@@ -283,26 +281,16 @@ whd_result_t get_socsram_base_address(uint16_t wlan_chip_id, uint32_t *addr, whd
     return WHD_SUCCESS;
 }
 
+#define WHD_SDIOD_CORE_BASE_CASE(chip_id, base) \
+    case (chip_id): \
+        *addr = (base); \
+        break;
+
 whd_result_t get_sdiod_core_base_address(uint16_t wlan_chip_id, uint32_t *addr)
 {
     switch (wlan_chip_id)
     {
-        case 55560:
-            *addr = 0x18004000;
-            break;
-        case 55500:
-        case 55530:
-            *addr = 0x18003000;
-            break;
-        case 0x4373:
-            *addr = 0x18005000;
-            break;
-        case 43012:
-        case 43022:
-        case 43430:
-        case 43439:
-            *addr = 0x18002000;
-            break;
+        WHD_SDIOD_CORE_BASE_ADDRESSES(WHD_SDIOD_CORE_BASE_CASE)
         default:
             return WHD_BADARG;
     }
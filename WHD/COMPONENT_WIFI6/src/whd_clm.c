@@ -178,5 +178,7 @@ whd_result_t whd_process_clm_data(whd_interface_t ifp)
         ret = WHD_MALLOC_FAILURE;
     }
 
+    whd_resource_release(whd_driver, WHD_RESOURCE_WLAN_CLM);
+
     return ret;
 }
@@ -41,6 +41,8 @@ void whd_init_stats(whd_driver_t whd_driver)
 
 whd_result_t whd_print_stats(whd_driver_t whd_driver, whd_bool_t reset_after_print)
 {
+    int ac;
+
     CHECK_DRIVER_NULL(whd_driver);
 
     WPRINT_MACRO( ("WHD Stats.. \n"
@@ -50,6 +52,54 @@ whd_result_t whd_print_stats(whd_driver_t whd_driver, whd_bool_t reset_after_pri
                    whd_driver->whd_stats.tx_no_mem, whd_driver->whd_stats.rx_no_mem,
                    whd_driver->whd_stats.tx_fail, whd_driver->whd_stats.no_credit,
                    whd_driver->whd_stats.flow_control) );
+    WPRINT_MACRO( ("tx_glom:%" PRIu32 ", tx_glom_frames:%" PRIu32 ", frames_per_glom:%" PRIu32 "\n",
+                   whd_driver->whd_stats.tx_glom, whd_driver->whd_stats.tx_glom_frames,
+                   (whd_driver->whd_stats.tx_glom == 0) ? 0 :
+                   whd_driver->whd_stats.tx_glom_frames / whd_driver->whd_stats.tx_glom) );
+    for (ac = 0; ac <= WHD_TX_SCHED_NUM_AC; ac++)
+    {
+        WPRINT_MACRO( ("tx_ac[%d] dequeue:%" PRIu32 ", latency_avg_ms:%" PRIu32 ", latency_max_ms:%" PRIu32 "\n",
+                       ac, whd_driver->whd_stats.tx_ac_dequeue[ac],
+                       (whd_driver->whd_stats.tx_ac_dequeue[ac] == 0) ? 0 :
+                       whd_driver->whd_stats.tx_ac_latency_total[ac] / whd_driver->whd_stats.tx_ac_dequeue[ac],
+                       whd_driver->whd_stats.tx_ac_latency_max[ac]) );
+    }
+    WPRINT_MACRO( ("tx_flow_controlled:%" PRIu32 "\n", whd_driver->whd_stats.tx_flow_controlled) );
+    WPRINT_MACRO( ("rx_ring_hit:%" PRIu32 ", rx_ring_miss:%" PRIu32 ", rx_ring_low_watermark:%" PRIu32 "\n",
+                   whd_driver->whd_stats.rx_ring_hit, whd_driver->whd_stats.rx_ring_miss,
+                   whd_driver->whd_stats.rx_ring_low_watermark) );
+    WPRINT_MACRO( ("rx_irq:%" PRIu32 ", rx_poll:%" PRIu32 ", rx_budget_exhausted:%" PRIu32 "\n",
+                   whd_driver->whd_stats.rx_irq, whd_driver->whd_stats.rx_poll,
+                   whd_driver->whd_stats.rx_budget_exhausted) );
+    WPRINT_MACRO( ("bp_window_reg_switch:%" PRIu32 ", bp_window_mem_switch:%" PRIu32 "\n",
+                   whd_driver->whd_stats.bp_window_reg_switch, whd_driver->whd_stats.bp_window_mem_switch) );
+    WPRINT_MACRO( ("dl_bytes:%" PRIu32 ", dl_read_ms:%" PRIu32 ", dl_bus_wait_ms:%" PRIu32 ", dl_total_ms:%" PRIu32 "\n",
+                   whd_driver->whd_stats.dl_bytes, whd_driver->whd_stats.dl_read_time,
+                   whd_driver->whd_stats.dl_bus_wait_time, whd_driver->whd_stats.dl_total_time) );
+    WPRINT_MACRO( ("on_platform_ms:%" PRIu32 ", on_clm_ms:%" PRIu32 ", on_config_ms:%" PRIu32
+                   ", join_prepare_ms:%" PRIu32 "\n",
+                   whd_driver->whd_stats.on_platform_time, whd_driver->whd_stats.on_clm_time,
+                   whd_driver->whd_stats.on_config_time, whd_driver->whd_stats.join_prepare_time) );
+    WPRINT_MACRO( ("iovar_batch:%" PRIu32 ", iovar_batch_entries:%" PRIu32 "\n",
+                   whd_driver->whd_stats.iovar_batch, whd_driver->whd_stats.iovar_batch_entries) );
+    WPRINT_MACRO( ("iovar_cache_hit:%" PRIu32 ", iovar_cache_miss:%" PRIu32 "\n",
+                   whd_driver->whd_stats.iovar_cache_hit, whd_driver->whd_stats.iovar_cache_miss) );
+#ifndef PROTO_MSGBUF
+    if (whd_driver->thread_info.rx_budget_max != 0)
+    {
+        WPRINT_MACRO( ("rx_budget:%u\n", (unsigned int)whd_driver->thread_info.rx_budget) );
+    }
+    for (ac = 0; ac < WHD_TX_SCHED_NUM_AC; ac++)
+    {
+        WPRINT_MACRO( ("tx_ac[%d] byte_limit:%" PRIu32 "\n", ac,
+                       whd_bql_get_limit(&whd_driver->sdpcm_info.tx_bql[ac]) ) );
+    }
+#else
+    if (whd_driver->msgbuf != NULL)
+    {
+        WPRINT_MACRO( ("tx byte_limit:%" PRIu32 "\n", whd_bql_get_limit(&whd_driver->msgbuf->tx_bql) ) );
+    }
+#endif /* PROTO_MSGBUF */
 
     if (reset_after_print == WHD_TRUE)
     {
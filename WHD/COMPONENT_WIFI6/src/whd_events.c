@@ -417,6 +417,7 @@ whd_result_t whd_management_set_event_handler(whd_interface_t ifp, const whd_eve
             }
         }
     }
+    whd_iovar_cache_set_event_mask(event_mask);
 
     res = whd_proto_set_iovar(prim_ifp, buffer, 0);
     if (res != WHD_SUCCESS)
@@ -513,6 +514,7 @@ whd_result_t whd_wifi_set_event_handler(whd_interface_t ifp, const uint32_t *eve
             }
         }
     }
+    whd_iovar_cache_set_event_mask(event_mask);
 
     res = whd_proto_set_iovar(prim_ifp, buffer, 0);
     if (res != WHD_SUCCESS)
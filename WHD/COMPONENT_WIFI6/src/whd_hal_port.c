@@ -121,6 +121,11 @@ void whd_hal_sdio_enable_event(whd_sdio_t* sdio_obj, whd_bool_t enable)
 {
     cyhal_sdio_enable_event(sdio_obj, CYHAL_SDIO_CARD_INTERRUPT, CYHAL_ISR_PRIORITY_DEFAULT, enable);
 }
+
+void whd_hal_sdio_enable_xfer_event(whd_sdio_t* sdio_obj, whd_bool_t enable)
+{
+    cyhal_sdio_enable_event(sdio_obj, CYHAL_SDIO_XFER_COMPLETE, CYHAL_ISR_PRIORITY_DEFAULT, enable);
+}
 #endif /* #if (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SDIO_INTERFACE) */
 
 
@@ -178,6 +183,11 @@ void whd_hal_sdio_enable_event(whd_sdio_t* sdio_obj, whd_bool_t enable)
 {
     cyhal_sdio_irq_enable(sdio_obj, CYHAL_SDIO_CARD_INTERRUPT, enable);
 }
+
+void whd_hal_sdio_enable_xfer_event(whd_sdio_t* sdio_obj, whd_bool_t enable)
+{
+    cyhal_sdio_irq_enable(sdio_obj, CYHAL_SDIO_XFER_COMPLETE, enable);
+}
 #endif /* #if (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SDIO_INTERFACE) */
 
 #endif /* defined (COMPONENT_MTB_HAL) */
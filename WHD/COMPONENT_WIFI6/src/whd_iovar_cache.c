@@ -0,0 +1,306 @@
+/*
+ * (c) 2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG.  SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ *  Read-through cache for slowly changing IOCTL/IOVAR results
+ */
+
+#include <string.h>
+#include "whd_iovar_cache.h"
+#include "whd_int.h"
+#include "whd_debug.h"
+#include "whd_utils.h"
+#include "whd_types_int.h"
+#include "whd_wlioctl.h"
+#include "whd_events_int.h"
+#include "whd_buffer_api.h"
+#include "whd_proto.h"
+
+whd_result_t whd_iovar_cache_init(whd_driver_t whd_driver)
+{
+    whd_iovar_cache_t *cache = &whd_driver->iovar_cache;
+
+    whd_mem_memset(cache->entries, 0, sizeof(cache->entries) );
+    cache->generation = 0;
+    cache->next_victim = 0;
+
+    if (cy_rtos_init_semaphore(&cache->mutex, 1, 0) != WHD_SUCCESS)
+    {
+        return WHD_SEMAPHORE_ERROR;
+    }
+    if (cy_rtos_set_semaphore(&cache->mutex, WHD_FALSE) != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
+        return WHD_SEMAPHORE_ERROR;
+    }
+
+    return WHD_SUCCESS;
+}
+
+void whd_iovar_cache_deinit(whd_driver_t whd_driver)
+{
+    whd_iovar_cache_flush(whd_driver, WHD_IOVAR_CACHE_ALL);
+    (void)cy_rtos_deinit_semaphore(&whd_driver->iovar_cache.mutex);
+}
+
+static void whd_iovar_cache_free_entry(whd_iovar_cache_entry_t *entry)
+{
+    if (entry->data != NULL)
+    {
+        whd_mem_free(entry->data);
+        entry->data = NULL;
+    }
+}
+
+static whd_iovar_cache_entry_t *whd_iovar_cache_find(whd_iovar_cache_t *cache, uint8_t ifidx, uint32_t command,
+                                                     const char *name, uint32_t key)
+{
+    whd_iovar_cache_entry_t *entry;
+    uint8_t i;
+
+    for (i = 0; i < WHD_IOVAR_CACHE_ENTRIES; i++)
+    {
+        entry = &cache->entries[i];
+        if ( (entry->data != NULL) && (entry->ifidx == ifidx) && (entry->command == command) &&
+             (entry->key == key) && ( (entry->name == name) ||
+                                      ( (entry->name != NULL) && (name != NULL) && (strcmp(entry->name, name) == 0) ) ) )
+        {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/* Copies a cached response of at least length bytes to out_buffer */
+static whd_bool_t whd_iovar_cache_lookup(whd_interface_t ifp, uint32_t command, const char *name, uint32_t key,
+                                         uint8_t *out_buffer, uint16_t length, uint32_t *generation)
+{
+    whd_driver_t whd_driver = ifp->whd_driver;
+    whd_iovar_cache_t *cache = &whd_driver->iovar_cache;
+    whd_iovar_cache_entry_t *entry;
+    whd_bool_t hit = WHD_FALSE;
+
+    if (cy_rtos_get_semaphore(&cache->mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
+    {
+        /* Never matches, the response fetched is not cached */
+        *generation = cache->generation - 1;
+        return WHD_FALSE;
+    }
+    entry = whd_iovar_cache_find(cache, ifp->ifidx, command, name, key);
+    if ( (entry != NULL) && (entry->length >= length) )
+    {
+        whd_mem_memcpy(out_buffer, entry->data, length);
+        hit = WHD_TRUE;
+    }
+    *generation = cache->generation;
+    (void)cy_rtos_set_semaphore(&cache->mutex, WHD_FALSE);
+
+    if (hit == WHD_TRUE)
+    {
+        WHD_STATS_INCREMENT_VARIABLE(whd_driver, iovar_cache_hit);
+    }
+    else
+    {
+        WHD_STATS_INCREMENT_VARIABLE(whd_driver, iovar_cache_miss);
+    }
+
+    return hit;
+}
+
+/* Caches a response fetched from the firmware, unless the cache was flushed while it was fetched */
+static void whd_iovar_cache_store(whd_interface_t ifp, uint8_t cache_class, uint32_t command, const char *name,
+                                  uint32_t key, const uint8_t *data, uint16_t length, uint32_t generation)
+{
+    whd_iovar_cache_t *cache = &ifp->whd_driver->iovar_cache;
+    whd_iovar_cache_entry_t *entry;
+    uint8_t *copy;
+
+    copy = (uint8_t *)whd_mem_malloc(length);
+    if (copy == NULL)
+    {
+        return;
+    }
+    whd_mem_memcpy(copy, data, length);
+
+    if (cy_rtos_get_semaphore(&cache->mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
+    {
+        whd_mem_free(copy);
+        return;
+    }
+    if (cache->generation != generation)
+    {
+        (void)cy_rtos_set_semaphore(&cache->mutex, WHD_FALSE);
+        whd_mem_free(copy);
+        return;
+    }
+
+    entry = whd_iovar_cache_find(cache, ifp->ifidx, command, name, key);
+    if (entry == NULL)
+    {
+        entry = &cache->entries[cache->next_victim];
+        cache->next_victim = (uint8_t)( (cache->next_victim + 1) % WHD_IOVAR_CACHE_ENTRIES );
+    }
+    whd_iovar_cache_free_entry(entry);
+    entry->data = copy;
+    entry->length = length;
+    entry->cache_class = cache_class;
+    entry->ifidx = ifp->ifidx;
+    entry->command = command;
+    entry->name = name;
+    entry->key = key;
+    (void)cy_rtos_set_semaphore(&cache->mutex, WHD_FALSE);
+}
+
+/* Fetches the response from the firmware, for an IOCTL buffer holds the request */
+static whd_result_t whd_iovar_cache_fetch(whd_interface_t ifp, uint32_t command, const char *name, uint8_t *buffer,
+                                          uint16_t length)
+{
+    whd_driver_t whd_driver = ifp->whd_driver;
+    whd_buffer_t request;
+    whd_buffer_t response;
+    uint8_t *data;
+
+    if (name != NULL)
+    {
+        CHECK_IOCTL_BUFFER(whd_proto_get_iovar_buffer(whd_driver, &request, length, name) );
+        CHECK_RETURN(whd_proto_get_iovar(ifp, request, &response) );
+    }
+    else
+    {
+        data = (uint8_t *)whd_proto_get_ioctl_buffer(whd_driver, &request, length);
+        CHECK_IOCTL_BUFFER(data);
+        whd_mem_memcpy(data, buffer, length);
+        CHECK_RETURN(whd_proto_get_ioctl(ifp, command, request, &response) );
+    }
+
+    data = whd_buffer_get_current_piece_data_pointer(whd_driver, response);
+    CHECK_PACKET_NULL(data, WHD_NO_REGISTER_FUNCTION_POINTER);
+    whd_mem_memcpy(buffer, data, (size_t)MIN_OF(whd_buffer_get_current_piece_size(whd_driver, response), length) );
+    CHECK_RETURN(whd_buffer_release(whd_driver, response, WHD_NETWORK_RX) );
+
+    return WHD_SUCCESS;
+}
+
+whd_result_t whd_iovar_cache_get_iovar(whd_interface_t ifp, uint8_t cache_class, const char *iovar,
+                                       uint8_t *out_buffer, uint16_t out_length)
+{
+    uint32_t generation;
+
+    CHECK_IFP_NULL(ifp);
+
+    if ( (iovar == NULL) || (out_buffer == NULL) )
+    {
+        return WHD_BADARG;
+    }
+
+    if (whd_iovar_cache_lookup(ifp, (uint32_t)WLC_GET_VAR, iovar, 0, out_buffer, out_length, &generation) == WHD_TRUE)
+    {
+        return WHD_SUCCESS;
+    }
+
+    CHECK_RETURN(whd_iovar_cache_fetch(ifp, (uint32_t)WLC_GET_VAR, iovar, out_buffer, out_length) );
+    whd_iovar_cache_store(ifp, cache_class, (uint32_t)WLC_GET_VAR, iovar, 0, out_buffer, out_length, generation);
+
+    return WHD_SUCCESS;
+}
+
+whd_result_t whd_iovar_cache_get_ioctl(whd_interface_t ifp, uint8_t cache_class, uint32_t ioctl, uint32_t key,
+                                       uint8_t *buffer, uint16_t length)
+{
+    uint32_t generation;
+
+    CHECK_IFP_NULL(ifp);
+
+    if (buffer == NULL)
+    {
+        return WHD_BADARG;
+    }
+
+    if (whd_iovar_cache_lookup(ifp, ioctl, NULL, key, buffer, length, &generation) == WHD_TRUE)
+    {
+        return WHD_SUCCESS;
+    }
+
+    CHECK_RETURN(whd_iovar_cache_fetch(ifp, ioctl, NULL, buffer, length) );
+    whd_iovar_cache_store(ifp, cache_class, ioctl, NULL, key, buffer, length, generation);
+
+    return WHD_SUCCESS;
+}
+
+void whd_iovar_cache_flush(whd_driver_t whd_driver, uint8_t cache_classes)
+{
+    whd_iovar_cache_t *cache = &whd_driver->iovar_cache;
+    whd_iovar_cache_entry_t *entry;
+    uint8_t i;
+
+    if (cy_rtos_get_semaphore(&cache->mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
+    {
+        return;
+    }
+    cache->generation++;
+    for (i = 0; i < WHD_IOVAR_CACHE_ENTRIES; i++)
+    {
+        entry = &cache->entries[i];
+        if ( (entry->data != NULL) && ( (entry->cache_class & cache_classes) != 0 ) )
+        {
+            whd_iovar_cache_free_entry(entry);
+        }
+    }
+    (void)cy_rtos_set_semaphore(&cache->mutex, WHD_FALSE);
+}
+
+void whd_iovar_cache_set_iovar(whd_driver_t whd_driver, const char *iovar)
+{
+    static const char bsscfg_prefix[] = "bsscfg:";
+
+    if (iovar == NULL)
+    {
+        return;
+    }
+    if (strncmp(iovar, bsscfg_prefix, sizeof(bsscfg_prefix) - 1) == 0)
+    {
+        iovar += sizeof(bsscfg_prefix) - 1;
+    }
+
+    if (strcmp(iovar, IOVAR_STR_COUNTRY) == 0)
+    {
+        whd_iovar_cache_flush(whd_driver, WHD_IOVAR_CACHE_COUNTRY);
+    }
+    else if (strcmp(iovar, IOVAR_STR_CUR_ETHERADDR) == 0)
+    {
+        whd_iovar_cache_flush(whd_driver, WHD_IOVAR_CACHE_ADDRESS);
+    }
+}
+
+void whd_iovar_cache_event(whd_driver_t whd_driver, const whd_event_header_t *event_header)
+{
+    switch (event_header->event_type)
+    {
+        case WLC_E_COUNTRY_CODE_CHANGED:
+            whd_iovar_cache_flush(whd_driver, WHD_IOVAR_CACHE_COUNTRY);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void whd_iovar_cache_set_event_mask(uint8_t *event_mask)
+{
+    setbit(event_mask, WLC_E_COUNTRY_CODE_CHANGED);
+}
@@ -0,0 +1,196 @@
+/*
+ * (c) 2026, Infineon Technologies AG, or an affiliate of Infineon
+ * Technologies AG.  SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ *  Streaming decoder for packed firmware and CLM resources
+ */
+
+#include <string.h>
+#include "whd_lz.h"
+
+/* LZ4 sequences: token, literal length bytes, literals, offset, match length bytes */
+#define WHD_LZ_MIN_MATCH            (4)
+#define WHD_LZ_LEN_EXTENDED         (15)
+
+enum
+{
+    WHD_LZ_TOKEN = 0,
+    WHD_LZ_LIT_LEN,
+    WHD_LZ_LITERALS,
+    WHD_LZ_OFFSET_LO,
+    WHD_LZ_OFFSET_HI,
+    WHD_LZ_MATCH_LEN,
+    WHD_LZ_MATCH,
+    WHD_LZ_DONE
+};
+
+static uint32_t whd_lz_get_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ( (uint32_t)p[1] << 8 ) | ( (uint32_t)p[2] << 16 ) | ( (uint32_t)p[3] << 24 );
+}
+
+whd_result_t whd_lz_parse_header(const uint8_t *data, uint32_t len, whd_lz_header_t *header)
+{
+    if ( (len < WHD_LZ_HEADER_SIZE) || (memcmp(data, "WHZ1", 4) != 0) || (data[4] != WHD_LZ_VERSION) ||
+         (data[5] < WHD_LZ_WINDOW_LOG_MIN) || (data[5] > WHD_LZ_WINDOW_LOG_MAX) )
+    {
+        return WHD_BADARG;
+    }
+
+    header->window_size = (uint32_t)1 << data[5];
+    header->size = whd_lz_get_le32(&data[8]);
+    header->packed_size = whd_lz_get_le32(&data[12]);
+
+    return WHD_SUCCESS;
+}
+
+void whd_lz_stream_init(whd_lz_stream_t *lz, const whd_lz_header_t *header, uint8_t *ring, uint32_t ring_size)
+{
+    memset(lz, 0, sizeof(*lz) );
+    lz->ring = ring;
+    lz->ring_size = ring_size;
+    lz->window_size = header->window_size;
+    lz->out_size = header->size;
+    lz->state = (header->size == 0) ? WHD_LZ_DONE : WHD_LZ_TOKEN;
+}
+
+static void whd_lz_put(whd_lz_stream_t *lz, uint8_t byte)
+{
+    lz->ring[lz->ring_pos] = byte;
+    if (++lz->ring_pos == lz->ring_size)
+    {
+        lz->ring_pos = 0;
+    }
+    lz->out_pos++;
+}
+
+whd_result_t whd_lz_stream_decode(whd_lz_stream_t *lz, const uint8_t *in, uint32_t in_len, uint32_t *in_used,
+                                  uint32_t out_limit)
+{
+    const uint8_t *in_start = in;
+    const uint8_t *in_end = in + in_len;
+    uint32_t src;
+    uint8_t byte;
+
+    if (out_limit > lz->out_size)
+    {
+        out_limit = lz->out_size;
+    }
+
+    while (lz->out_pos < out_limit)
+    {
+        /* Only the copy states can make progress without input */
+        if ( (in == in_end) && (lz->state != WHD_LZ_MATCH) )
+        {
+            break;
+        }
+
+        switch (lz->state)
+        {
+            case WHD_LZ_TOKEN:
+                byte = *in++;
+                lz->lit_len = byte >> 4;
+                lz->match_nibble = byte & 0x0F;
+                if (lz->lit_len == WHD_LZ_LEN_EXTENDED)
+                {
+                    lz->state = WHD_LZ_LIT_LEN;
+                }
+                else
+                {
+                    lz->state = (lz->lit_len != 0) ? WHD_LZ_LITERALS : WHD_LZ_OFFSET_LO;
+                }
+                break;
+
+            case WHD_LZ_LIT_LEN:
+                byte = *in++;
+                lz->lit_len += byte;
+                if (byte != 255)
+                {
+                    lz->state = WHD_LZ_LITERALS;
+                }
+                break;
+
+            case WHD_LZ_LITERALS:
+                while ( (lz->lit_len != 0) && (in != in_end) && (lz->out_pos < out_limit) )
+                {
+                    whd_lz_put(lz, *in++);
+                    lz->lit_len--;
+                }
+                if (lz->lit_len == 0)
+                {
+                    /* The last sequence has literals only */
+                    lz->state = (lz->out_pos == lz->out_size) ? WHD_LZ_DONE : WHD_LZ_OFFSET_LO;
+                }
+                break;
+
+            case WHD_LZ_OFFSET_LO:
+                lz->offset = *in++;
+                lz->state = WHD_LZ_OFFSET_HI;
+                break;
+
+            case WHD_LZ_OFFSET_HI:
+                lz->offset |= (uint32_t)(*in++) << 8;
+                if ( (lz->offset == 0) || (lz->offset >= lz->window_size) || (lz->offset > lz->out_pos) ||
+                     (lz->offset > lz->ring_size) )
+                {
+                    return WHD_BADARG;
+                }
+                lz->match_len = lz->match_nibble + WHD_LZ_MIN_MATCH;
+                lz->state = (lz->match_nibble == WHD_LZ_LEN_EXTENDED) ? WHD_LZ_MATCH_LEN : WHD_LZ_MATCH;
+                break;
+
+            case WHD_LZ_MATCH_LEN:
+                byte = *in++;
+                lz->match_len += byte;
+                if (byte != 255)
+                {
+                    lz->state = WHD_LZ_MATCH;
+                }
+                break;
+
+            case WHD_LZ_MATCH:
+                if (lz->match_len > lz->out_size - lz->out_pos)
+                {
+                    return WHD_BADARG;
+                }
+                src = (lz->ring_pos >= lz->offset) ? lz->ring_pos - lz->offset :
+                      lz->ring_pos + lz->ring_size - lz->offset;
+                /* Byte by byte, a match may overlap the bytes it produces */
+                while ( (lz->match_len != 0) && (lz->out_pos < out_limit) )
+                {
+                    whd_lz_put(lz, lz->ring[src]);
+                    if (++src == lz->ring_size)
+                    {
+                        src = 0;
+                    }
+                    lz->match_len--;
+                }
+                if (lz->match_len == 0)
+                {
+                    lz->state = WHD_LZ_TOKEN;
+                }
+                break;
+
+            default:
+                return WHD_BADARG;
+        }
+    }
+
+    *in_used = (uint32_t)(in - in_start);
+
+    return WHD_SUCCESS;
+}
@@ -21,6 +21,7 @@
  */
 
 #include <string.h>
+#include "cybsp.h"
 #include "bus_protocols/whd_bus_common.h"
 #include "bus_protocols/whd_bus_protocol_interface.h"
 #include "whd_debug.h"
@@ -37,6 +38,7 @@
 #include "whd_types_int.h"
 #include "whd_chip_constants.h"
 #include "whd_proto.h"
+#include "whd_resource_if.h"
 #if defined(COMPONENT_WLANSENSE)
 #include "whd_wlansense_core.h"
 #endif /* defined(COMPONENT_WLANSENSE) */
@@ -209,6 +211,7 @@ whd_wifi_set_country_code(whd_interface_t ifp, whd_country_code_t country_code)
         country_struct->rev = (int32_t)htod32(-1);
     }
     ret = whd_proto_set_iovar(ifp, buffer, 0);
+    whd_iovar_cache_flush(whd_driver, WHD_IOVAR_CACHE_COUNTRY);
 
     return ret;
 }
@@ -217,6 +220,9 @@ whd_result_t whd_init(whd_driver_t *whd_driver_ptr, whd_init_config_t *whd_init_
                   whd_netif_funcs_t *network_ops)
 {
     whd_driver_t whd_drv;
+#ifndef PROTO_MSGBUF
+    uint8_t i;
+#endif /* PROTO_MSGBUF */
 
     if (!whd_driver_ptr || !buffer_ops || !network_ops || !resource_ops || !whd_init_config)
     {
@@ -251,6 +257,14 @@ whd_result_t whd_init(whd_driver_t *whd_driver_ptr, whd_init_config_t *whd_init_
 #endif
 
         whd_drv->bus_gspi_32bit = WHD_FALSE;
+#ifndef PROTO_MSGBUF
+        whd_drv->sdpcm_info.tx_glom_max_frames = whd_init_config->tx_glom_max_frames;
+        whd_drv->sdpcm_info.tx_sched_mode = whd_init_config->tx_sched_mode;
+        for (i = 0; i < WHD_TX_SCHED_NUM_AC; i++)
+        {
+            whd_drv->sdpcm_info.tx_sched_quantum[i] = whd_init_config->tx_sched_weight[i];
+        }
+#endif /* PROTO_MSGBUF */
 
         if (whd_init_config->country == 0)
             whd_drv->country = WHD_COUNTRY_UNITED_STATES;
@@ -308,11 +322,25 @@ whd_result_t whd_deinit(whd_interface_t ifp)
 
     whd_internal_info_deinit(whd_driver);
     whd_bus_common_info_deinit(whd_driver);
+    whd_resource_deinit(whd_driver);
     whd_mem_free(whd_driver);
 
     return WHD_SUCCESS;
 }
 
+/* Milliseconds since *start, which moves on to now for the next phase */
+static uint32_t whd_management_phase_time(cy_time_t *start)
+{
+    cy_time_t now;
+    uint32_t elapsed;
+
+    (void)cy_rtos_get_time(&now);
+    elapsed = (uint32_t)(now - *start);
+    *start = now;
+
+    return elapsed;
+}
+
 /**
  * Initialize Wi-Fi platform
  *
@@ -340,6 +368,9 @@ whd_result_t whd_management_wifi_platform_init(whd_driver_t whd_driver, whd_coun
 
     whd_driver->internal_info.whd_wlan_status.country_code = country;
 
+    /* Nothing read from the firmware before is known to be valid for the firmware brought up now */
+    whd_iovar_cache_flush(whd_driver, WHD_IOVAR_CACHE_ALL);
+
     if (resume_after_deep_sleep == WHD_TRUE)
     {
         retval = ( whd_result_t )whd_bus_resume_after_deep_sleep(whd_driver);
@@ -395,10 +426,15 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
     whd_result_t retval;
     whd_buffer_t buffer;
     uint8_t *event_mask;
+#ifndef PROTO_MSGBUF
     uint32_t *data;
+#endif
     uint32_t counter;
     whd_interface_t ifp;
     uint16_t wlan_chip_id = 0;
+    whd_iovar_batch_t batch;
+    uint8_t apsta_entry;
+    cy_time_t phase_start;
 
 #if defined(COMPONENT_CAT5) && !defined(WHD_DISABLE_PDS)
     /* For H1CP, the BTSS sleep is enabled by default, so acquire the lock before doing the initialization process,
@@ -420,6 +456,7 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
     }
 
     whd_init_stats(whd_driver);
+    (void)cy_rtos_get_time(&phase_start);
 
     retval = whd_management_wifi_platform_init(whd_driver, whd_driver->country, WHD_FALSE);
     if (retval != WHD_SUCCESS)
@@ -427,6 +464,7 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
         WPRINT_WHD_INFO( ("Could not initialize wifi platform\n") );
         return retval;
     }
+    whd_driver->whd_stats.on_platform_time = whd_management_phase_time(&phase_start);
 
     whd_add_primary_interface(whd_driver, ifpp);
     ifp = *ifpp;
@@ -441,6 +479,7 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
                        "****************************************************\n") );
         return retval;
     }
+    whd_driver->whd_stats.on_clm_time = whd_management_phase_time(&phase_start);
 
 #ifndef PROTO_MSGBUF
     retval = whd_bus_share_bt_init(whd_driver);
@@ -458,7 +497,7 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
     }
 
 #ifndef PROTO_MSGBUF    /* This is needed for cdc/bcd - sdpcm protocol */
-    /* Turn off SDPCM TX Glomming */
+    /* Turn SDPCM TX Glomming off, unless it was requested at whd_init() time */
     /* Note: This is only required for later chips.
      * The 4319 has glomming off by default however the 43362 has it on by default.
      */
@@ -468,26 +507,56 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
         whd_assert("Could not get buffer for IOVAR", 0 != 0);
         return WHD_BUFFER_ALLOC_FAIL;
     }
+#if (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SDIO_INTERFACE) && !defined(COMPONENT_WIFI_INTERFACE_OCI)
+    *data = htod32( (whd_driver->sdpcm_info.tx_glom_max_frames > 1) ? (uint32_t)1 : (uint32_t)0 );
+#else
     *data = 0;
+#endif
     retval = whd_proto_set_iovar(ifp, buffer, 0);
     if ( (retval != WHD_SUCCESS) && (retval != WHD_WLAN_UNSUPPORTED) )
     {
         /* Note: System may time out here if bus interrupts are not working properly */
-        WPRINT_WHD_ERROR( ("Could not turn off TX glomming\n") );
+        WPRINT_WHD_ERROR( ("Could not set TX glomming\n") );
         return retval;
     }
+#if (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SDIO_INTERFACE) && !defined(COMPONENT_WIFI_INTERFACE_OCI)
+    if ( (retval == WHD_SUCCESS) && (whd_driver->sdpcm_info.tx_glom_max_frames > 1) )
+    {
+        /* Firmware now expects the hardware extension header on every F2 frame */
+        retval = whd_sdpcm_tx_glom_enable(whd_driver);
+        if (retval != WHD_SUCCESS)
+        {
+            WPRINT_WHD_ERROR( ("Could not enable TX glomming\n") );
+            return retval;
+        }
+    }
+    else if (whd_driver->sdpcm_info.tx_glom_max_frames > 1)
+    {
+        WPRINT_WHD_INFO( ("Firmware does not support TX glomming\n") );
+    }
+#endif
+#endif
+
+    /* TX glomming changes the framing of everything sent after it, the IOVARs which follow can be batched */
+    whd_iovar_batch_init(&batch, ifp);
+
+#if !defined(PROTO_MSGBUF) && (CYBSP_WIFI_INTERFACE_TYPE == CYBSP_SDIO_INTERFACE) && \
+    !defined(COMPONENT_WIFI_INTERFACE_OCI)
+    /* Turn SDPCM RX Glomming on, the SDIO bus splits received superframes */
+    CHECK_RETURN(whd_iovar_batch_add_value(&batch, IOVAR_STR_RX_GLOM, 1) );
 #endif
 
     /* Turn APSTA on */
-    data = (uint32_t *)whd_proto_get_iovar_buffer(whd_driver, &buffer, (uint16_t)sizeof(*data), IOVAR_STR_APSTA);
-    if (data == NULL)
+    apsta_entry = batch.count;
+    CHECK_RETURN(whd_iovar_batch_add_value(&batch, IOVAR_STR_APSTA, 1) );
+
+    (void)whd_iovar_batch_execute(&batch);
+    if ( (apsta_entry != 0) && (batch.entries[0].result != WHD_SUCCESS) )
     {
-        whd_assert("Could not get buffer for IOVAR", 0 != 0);
-        return WHD_BUFFER_ALLOC_FAIL;
+        WPRINT_WHD_DEBUG( ("Firmware does not support RX glomming\n") );
     }
-    *data = htod32( (uint32_t)1 );
     /* This will fail on manufacturing test build since it does not have APSTA available */
-    retval = whd_proto_set_iovar(ifp, buffer, 0);
+    retval = batch.entries[apsta_entry].result;
     if (retval == WHD_WLAN_UNSUPPORTED)
     {
         WPRINT_WHD_DEBUG( ("Firmware does not support APSTA\n") );
@@ -509,7 +578,7 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
     /* NOTE: The set country command requires time to process on the WLAN firmware and
     * the following IOCTL may fail on initial attempts therefore we try a few times */
 
-    /* Set the event mask, indicating initially we do not want any asynchronous events */
+    /* Set the event mask, indicating initially we want only the events the IOVAR cache is flushed on */
     for (counter = 0, retval = WHD_PENDING; retval != WHD_SUCCESS && counter < (uint32_t)MAX_POST_SET_COUNTRY_RETRY;
          ++counter)
     {
@@ -521,6 +590,7 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
             return WHD_BUFFER_ALLOC_FAIL;
         }
         whd_mem_memset(event_mask, 0, (size_t)WL_EVENTING_MASK_LEN);
+        whd_iovar_cache_set_event_mask(event_mask);
         retval = whd_proto_set_iovar(ifp, buffer, 0);
     }
     if (retval != WHD_SUCCESS)
@@ -544,6 +614,8 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
     }
 
     wlan_chip_id = whd_chip_get_chip_id(whd_driver);
+    whd_iovar_batch_init(&batch, ifp);
+
     /* WAR: Disable WLAN PM/mpc for 43907 low power issue */
     if ( (wlan_chip_id == 43909) || (wlan_chip_id == 43907) || (wlan_chip_id == 54907) )
     {
@@ -553,19 +625,14 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
             WPRINT_WHD_ERROR( ("Failed to disable PM for 43907\n") );
             return retval;
         }
-        retval = whd_wifi_set_iovar_value(ifp, IOVAR_STR_MPC, 0);
-        if (retval != WHD_SUCCESS)
-        {
-            WPRINT_WHD_ERROR( ("Failed to disable mpc for 43907\n") );
-            return retval;
-        }
+        CHECK_RETURN(whd_iovar_batch_add_value(&batch, IOVAR_STR_MPC, 0) );
     }
     else
     {
         CHECK_RETURN(whd_wifi_enable_powersave_with_throughput(ifp, DEFAULT_PM2_SLEEP_RET_TIME));
         if(wlan_chip_id == 55900)
         {
-            CHECK_RETURN(whd_wifi_set_iovar_value(ifp, IOVAR_STR_MPC, 1));
+            CHECK_RETURN(whd_iovar_batch_add_value(&batch, IOVAR_STR_MPC, 1) );
         }
     }
 
@@ -579,21 +646,23 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
 
 #ifndef PROTO_MSGBUF
     /* Set the GMode */
-    data = (uint32_t *)whd_proto_get_ioctl_buffer(whd_driver, &buffer, (uint16_t)4);
-    if (data == NULL)
+    CHECK_RETURN(whd_iovar_batch_add_ioctl_value(&batch, (uint32_t)WLC_SET_GMODE, (uint32_t)GMODE_AUTO) );
+#endif
+
+    /* Disabling ampdu hostreorder */
+    if ( (wlan_chip_id == 55500) || (wlan_chip_id == 55530) || (wlan_chip_id == 55572) ||
+         (wlan_chip_id == 55900) )
     {
-        whd_assert("Could not get buffer for IOCTL", 0 != 0);
-        return WHD_BUFFER_ALLOC_FAIL;
+        CHECK_RETURN(whd_iovar_batch_add_value(&batch, IOVAR_STR_AMPDU_HOST_REORDER, WHD_FALSE) );
     }
-    *data = htod32( (uint32_t)GMODE_AUTO );
-    retval = whd_proto_set_ioctl(ifp, WLC_SET_GMODE, buffer, 0);
+
+    retval = whd_iovar_batch_execute(&batch);
     if (retval != WHD_SUCCESS)
     {
         /* Note: System may time out here if bus interrupts are not working properly */
-        WPRINT_WHD_ERROR( ("Error setting gmode\n") );
+        WPRINT_WHD_ERROR( ("Error setting mpc, gmode or ampdu hostreorder\n") );
         return retval;
     }
-#endif
 
     /* Disabling scanmac randomisation for H1Combo
      * Scanmac randomisation leads to probe requests with random mac address
@@ -611,17 +680,15 @@ whd_result_t whd_wifi_on(whd_driver_t whd_driver, whd_interface_t *ifpp)
         }
     }
 
-    /* Disabling ampdu hostreorder */
-    if ( (wlan_chip_id == 55500) || (wlan_chip_id == 55530) || (wlan_chip_id == 55572) ||
-         (wlan_chip_id == 55900) )
-    {
-        CHECK_RETURN(whd_wifi_set_iovar_value(ifp, IOVAR_STR_AMPDU_HOST_REORDER, WHD_FALSE) );
-    }
-
 #if defined(COMPONENT_WLANSENSE)
     CHECK_RETURN(whd_wlansense_create_interface(whd_driver));
 #endif /* defined(COMPONENT_WLANSENSE) */
 
+    whd_driver->whd_stats.on_config_time = whd_management_phase_time(&phase_start);
+    WPRINT_WHD_INFO( ("WLAN on: platform %" PRIu32 " ms, CLM %" PRIu32 " ms, config %" PRIu32 " ms\n",
+                      whd_driver->whd_stats.on_platform_time, whd_driver->whd_stats.on_clm_time,
+                      whd_driver->whd_stats.on_config_time) );
+
 #if defined(COMPONENT_CAT5) && !defined(WHD_DISABLE_PDS)
     /* Unlocking the syspm sleep lock, as WHD initialization part is done */
     whd_pds_unlock_sleep(whd_driver);
@@ -663,6 +730,7 @@ whd_result_t whd_wifi_off(whd_interface_t ifp)
     whd_thread_quit(whd_driver);
 
     whd_proto_detach(whd_driver);
+    whd_iovar_cache_flush(whd_driver, WHD_IOVAR_CACHE_ALL);
 
     retval = whd_bus_deinit(whd_driver);
     if (retval != WHD_SUCCESS)
@@ -387,17 +387,10 @@ static void whd_msgbuf_ioctl_exit(void)
 }
 #endif /* defined(COMPONENT_CAT5) && !defined(WHD_DISABLE_PDS) */
 
-static int whd_msgbuf_send_ioctl(whd_interface_t ifp, uint32_t cmd, whd_buffer_t send_buffer_hnd,
-                                 whd_buffer_t *response_buffer_hnd)
+/* Hands an IOCTL to the WHD thread for sending, the caller holds ioctl_mutex */
+static void whd_msgbuf_queue_ioctl(whd_interface_t ifp, uint32_t cmd, whd_buffer_t send_buffer_hnd)
 {
-
-    whd_msgbuf_ioctl_entry();
-
-    whd_driver_t whd_driver = ifp->whd_driver;
-    struct whd_msgbuf *msgbuf = (struct whd_msgbuf *)whd_driver->msgbuf;
-    whd_msgbuf_info_t *msgbuf_info = whd_driver->proto->pd;
-    int retval;
-    uint32_t retry = 0;
+    struct whd_msgbuf *msgbuf = (struct whd_msgbuf *)ifp->whd_driver->msgbuf;
 
     /* Set send IOCTL buffer to ioctl_queue.
        Because we have ioctl_mutex, only one IOCTL buffer at one time. */
@@ -410,6 +403,21 @@ static int whd_msgbuf_send_ioctl(whd_interface_t ifp, uint32_t cmd, whd_buffer_t
     {
         whd_msgbuf_rxbuf_ioctlresp_post(msgbuf);
     }
+}
+
+static int whd_msgbuf_send_ioctl(whd_interface_t ifp, uint32_t cmd, whd_buffer_t send_buffer_hnd,
+                                 whd_buffer_t *response_buffer_hnd)
+{
+
+    whd_msgbuf_ioctl_entry();
+
+    whd_driver_t whd_driver = ifp->whd_driver;
+    struct whd_msgbuf *msgbuf = (struct whd_msgbuf *)whd_driver->msgbuf;
+    whd_msgbuf_info_t *msgbuf_info = whd_driver->proto->pd;
+    int retval;
+    uint32_t retry = 0;
+
+    whd_msgbuf_queue_ioctl(ifp, cmd, send_buffer_hnd);
 
     do
     {
@@ -575,6 +583,172 @@ static whd_result_t whd_msgbuf_get_iovar(whd_interface_t ifp,
     return retval;
 }
 
+/** Sends an IOCTL without waiting for the response
+ *
+ *  The response goes to callback from the WHD thread, see whd_proto_set_ioctl_async. The message
+ *  rings carry one IOCTL at a time, so this fails rather than waits while another is outstanding.
+ *
+ *  @return    WHD_SUCCESS once queued, WHD_WLAN_BUSY if another IOCTL is outstanding
+ */
+static whd_result_t whd_msgbuf_send_ioctl_async(whd_interface_t ifp, uint32_t command, whd_buffer_t send_buffer_hnd,
+                                                uint32_t timeout_ms, whd_ioctl_async_callback_t callback,
+                                                void *user_data, uint16_t *request)
+{
+    whd_driver_t whd_driver = ifp->whd_driver;
+    whd_msgbuf_info_t *msgbuf_info = whd_driver->proto->pd;
+    whd_msgbuf_ioctl_async_t *async = &msgbuf_info->ioctl_async;
+    uint16_t id;
+
+    if (callback == NULL)
+    {
+        CHECK_RETURN(whd_buffer_release(whd_driver, send_buffer_hnd, WHD_NETWORK_TX) );
+        return WHD_BADARG;
+    }
+
+    /* Held until the response arrives, the request times out or it is cancelled */
+    if (cy_rtos_get_semaphore(&msgbuf_info->ioctl_mutex, 0, WHD_FALSE) != WHD_SUCCESS)
+    {
+        CHECK_RETURN(whd_buffer_release(whd_driver, send_buffer_hnd, WHD_NETWORK_TX) );
+        return WHD_WLAN_BUSY;
+    }
+
+    whd_msgbuf_ioctl_entry();
+
+    (void)cy_rtos_get_semaphore(&msgbuf_info->ioctl_async_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE);
+    do
+    {
+        id = ++msgbuf_info->ioctl_async_last_request;
+    } while (id == 0);
+    async->callback = callback;
+    async->user_data = user_data;
+    async->ifp = ifp;
+    async->timeout_ms = (timeout_ms != 0) ? timeout_ms : WHD_IOCTL_TIMEOUT_MS;
+    async->request = id;
+    (void)cy_rtos_get_time(&async->start_time);
+    (void)cy_rtos_set_semaphore(&msgbuf_info->ioctl_async_mutex, WHD_FALSE);
+
+    if (request != NULL)
+    {
+        *request = id;
+    }
+
+    whd_msgbuf_queue_ioctl(ifp, command, send_buffer_hnd);
+    whd_thread_notify(whd_driver);
+
+    return WHD_SUCCESS;
+}
+
+/** Takes the outstanding asynchronous IOCTL, the caller then owns ioctl_mutex and must run whd_msgbuf_finish_ioctl_async
+ *
+ * @param request : Handle of the IOCTL to take, 0 for any
+ * @param now     : Only take it if its timeout expired by now, NULL to take it regardless
+ * @param taken   : Receives the IOCTL
+ *
+ * @return WHD_TRUE if it was taken
+ */
+static whd_bool_t whd_msgbuf_take_ioctl_async(whd_msgbuf_info_t *msgbuf_info, uint16_t request, const cy_time_t *now,
+                                              whd_msgbuf_ioctl_async_t *taken)
+{
+    whd_msgbuf_ioctl_async_t *async = &msgbuf_info->ioctl_async;
+    whd_bool_t found = WHD_FALSE;
+
+    if (cy_rtos_get_semaphore(&msgbuf_info->ioctl_async_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
+    {
+        return WHD_FALSE;
+    }
+    if ( (async->callback != NULL) && ( (request == 0) || (async->request == request) ) &&
+         ( (now == NULL) || ( (uint32_t)(*now - async->start_time) >= async->timeout_ms ) ) )
+    {
+        *taken = *async;
+        whd_mem_memset(async, 0, sizeof(*async) );
+        found = WHD_TRUE;
+    }
+    (void)cy_rtos_set_semaphore(&msgbuf_info->ioctl_async_mutex, WHD_FALSE);
+
+    return found;
+}
+
+/* Lets the next IOCTL go, then runs the callback of one taken with whd_msgbuf_take_ioctl_async */
+static void whd_msgbuf_finish_ioctl_async(whd_driver_t whd_driver, const whd_msgbuf_ioctl_async_t *async,
+                                          whd_result_t result, whd_buffer_t response, uint32_t response_length)
+{
+    whd_msgbuf_info_t *msgbuf_info = whd_driver->proto->pd;
+
+    (void)cy_rtos_set_semaphore(&msgbuf_info->ioctl_mutex, WHD_FALSE);
+    whd_msgbuf_ioctl_exit();
+
+    if ( (result == WHD_SUCCESS) && (response != NULL) )
+    {
+        async->callback(async->ifp, WHD_SUCCESS, whd_buffer_get_current_piece_data_pointer(whd_driver, response),
+                        MIN_OF(response_length, whd_buffer_get_current_piece_size(whd_driver, response) ),
+                        async->user_data);
+    }
+    else
+    {
+        async->callback(async->ifp, result, NULL, 0, async->user_data);
+    }
+
+    if (response != NULL)
+    {
+        (void)whd_buffer_release(whd_driver, response, WHD_NETWORK_RX);
+    }
+}
+
+/** Cancels an asynchronous IOCTL, its callback will not run and a late response is dropped
+ *
+ *  @return    WHD_SUCCESS, or WHD_DOES_NOT_EXIST if the callback already ran or is running
+ */
+static whd_result_t whd_msgbuf_cancel_ioctl_async(whd_driver_t whd_driver, uint16_t request)
+{
+    whd_msgbuf_info_t *msgbuf_info = whd_driver->proto->pd;
+    whd_msgbuf_ioctl_async_t async;
+
+    if (request == 0)
+    {
+        return WHD_BADARG;
+    }
+    if (!whd_msgbuf_take_ioctl_async(msgbuf_info, request, NULL, &async) )
+    {
+        return WHD_DOES_NOT_EXIST;
+    }
+
+    /* A late response finds ioctl_mutex free and is dropped */
+    (void)cy_rtos_set_semaphore(&msgbuf_info->ioctl_mutex, WHD_FALSE);
+    whd_msgbuf_ioctl_exit();
+
+    return WHD_SUCCESS;
+}
+
+/** Reports WHD_TIMEOUT for an asynchronous IOCTL not answered in time, called by the WHD thread
+ *
+ * @return Milliseconds until it times out, 0 if none is outstanding
+ */
+static uint32_t whd_msgbuf_poll_ioctl_async(whd_driver_t whd_driver)
+{
+    whd_msgbuf_info_t *msgbuf_info = whd_driver->proto->pd;
+    whd_msgbuf_ioctl_async_t async;
+    cy_time_t now;
+    uint32_t elapsed;
+
+    /* Unlocked check first, the thread polls this on every pass */
+    if (msgbuf_info->ioctl_async.callback == NULL)
+    {
+        return 0;
+    }
+
+    (void)cy_rtos_get_time(&now);
+    if (whd_msgbuf_take_ioctl_async(msgbuf_info, 0, &now, &async) )
+    {
+        WPRINT_WHD_DEBUG( ("Async IOCTL %d not answered in %" PRIu32 " ms\n", async.request, async.timeout_ms) );
+        whd_msgbuf_finish_ioctl_async(whd_driver, &async, WHD_TIMEOUT, NULL, 0);
+        return 0;
+    }
+
+    /* Still outstanding, or completed meanwhile in which case the wake up is spurious */
+    elapsed = (uint32_t)(now - msgbuf_info->ioctl_async.start_time);
+    return (elapsed < msgbuf_info->ioctl_async.timeout_ms) ? msgbuf_info->ioctl_async.timeout_ms - elapsed : 1;
+}
+
 static whd_result_t
 whd_msgbuf_remove_flowring(struct whd_msgbuf *msgbuf, uint16_t flowid)
 {
@@ -673,6 +847,8 @@ whd_msgbuf_process_ioctl_complete(whd_driver_t whd_driver, struct whd_msgbuf *ms
     whd_result_t result;
     whd_result_t ioctl_mutex_res;
     whd_msgbuf_info_t *msgbuf_info = whd_driver->proto->pd;
+    whd_msgbuf_ioctl_async_t async;
+    whd_buffer_t response;
 
     CHECK_PACKET_WITH_NULL_RETURN(buf);
 
@@ -689,7 +865,25 @@ whd_msgbuf_process_ioctl_complete(whd_driver_t whd_driver, struct whd_msgbuf *ms
         WPRINT_WHD_DATA_LOG( ("Wcd:< Procd pkt 0x%08lX: IOCTL Response\n",
                               (unsigned long)ioctl_resp) );
 
-        if(msgbuf->reqid == ioctl_resp->trans_id)
+        if( (msgbuf->reqid == ioctl_resp->trans_id) && whd_msgbuf_take_ioctl_async(msgbuf_info, 0, NULL, &async) )
+        {
+            /* Nobody waits for an asynchronous IOCTL, run its callback from here */
+            response = whd_msgbuf_get_pktid(whd_driver, msgbuf->rx_pktids, msgbuf_info->ioctl_response_pktid);
+            if (msgbuf_info->ioctl_response_status != WHD_SUCCESS)
+            {
+                result = WHD_RESULT_CREATE( (WLAN_ENUM_OFFSET - msgbuf_info->ioctl_response_status) );
+            }
+            else if ( (msgbuf_info->ioctl_response_length != 0) && (response == NULL) )
+            {
+                result = WHD_BADARG;
+            }
+            else
+            {
+                result = WHD_SUCCESS;
+            }
+            whd_msgbuf_finish_ioctl_async(whd_driver, &async, result, response, msgbuf_info->ioctl_response_length);
+        }
+        else if(msgbuf->reqid == ioctl_resp->trans_id)
         {
             /* Wake the thread which sent the IOCTL/IOVAR so that it will resume */
             result = cy_rtos_set_semaphore(&msgbuf_info->ioctl_sleep, WHD_FALSE);
@@ -838,6 +1032,7 @@ static void whd_msgbuf_process_event_buffer(whd_driver_t whd_driver, whd_buffer_
     /* do any needed debug logging of event */
     WHD_IOCTL_LOG_ADD_EVENT(whd_driver, whd_event->event_type, whd_event->status,
                             whd_event->reason);
+    whd_iovar_cache_event(whd_driver, whd_event);
 
     if (cy_rtos_get_semaphore(&msgbuf_info->event_list_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
     {
@@ -957,6 +1152,8 @@ whd_msgbuf_process_txstatus(struct whd_msgbuf *msgbuf, void *buf)
     whd_buffer_t skb = NULL;
     struct whd_driver *drvr = msgbuf->drvr;
     whd_result_t result;
+    uint32_t size;
+    uint16_t i;
 
     tx_status = (struct msgbuf_tx_status *)buf;
     flowid = dtoh16(tx_status->compl_hdr.flow_ring_id);
@@ -966,11 +1163,28 @@ whd_msgbuf_process_txstatus(struct whd_msgbuf *msgbuf, void *buf)
     WPRINT_WHD_DEBUG( ("%s - tx_status - %d for FlowID is %d, skb:0x%lu\n", __func__, tx_status->compl_hdr.status,
                        flowid, (uint32_t)skb) );
 
+    size = whd_buffer_get_current_piece_size(drvr, skb);
     result = whd_buffer_release(drvr, skb, WHD_NETWORK_TX);
     if (result != WHD_SUCCESS)
         WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
 
     msgbuf->tot_txpkt_inqueue--;
+    whd_bql_completed(&msgbuf->tx_bql, size);
+
+    /* Flow controlled packets were queued without scheduling, resume them once under the limits */
+    if ( (msgbuf->tx_held == WHD_TRUE) && (msgbuf->tot_txpkt_inqueue < WHD_TXPOOL_BUFFER_THRESH) &&
+         (whd_bql_over_limit(&msgbuf->tx_bql) == WHD_FALSE) )
+    {
+        msgbuf->tx_held = WHD_FALSE;
+        for (i = 0; i < msgbuf->max_flowrings; i++)
+        {
+            if (whd_flowring_qlen(msgbuf->flow, i) != 0)
+            {
+                whd_msgbuf_schedule_txdata(msgbuf, i);
+            }
+        }
+        whd_network_tx_resume(drvr);
+    }
     return;
 }
 
@@ -1344,6 +1558,7 @@ whd_result_t whd_msgbuf_txflow(struct whd_driver *drvr, uint16_t flowid)
         WHD_STATS_INCREMENT_VARIABLE(drvr, tx_total);
         count++;
         msgbuf->tot_txpkt_inqueue++;
+        (void)whd_bql_queued(&msgbuf->tx_bql, whd_buffer_get_current_piece_size(drvr, skb) );
 
         tx_msghdr = (struct msgbuf_tx_msghdr *)ret_ptr;
 
@@ -1544,8 +1759,11 @@ static whd_result_t whd_msgbuf_txflow_enqueue(whd_driver_t whd_driver, whd_buffe
     if (result != WHD_SUCCESS)
         WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
 
-    if (msgbuf->tot_txpkt_inqueue >= WHD_TXPOOL_BUFFER_THRESH)
+    if ( (msgbuf->tot_txpkt_inqueue >= WHD_TXPOOL_BUFFER_THRESH) ||
+         (whd_bql_over_limit(&msgbuf->tx_bql) == WHD_TRUE) )
     {
+        msgbuf->tx_held = WHD_TRUE;
+        WHD_STATS_INCREMENT_VARIABLE(whd_driver, tx_flow_controlled);
         return WHD_FLOW_CONTROLLED;
     }
 
@@ -1631,6 +1849,7 @@ static uint32_t whd_msgbuf_flowring_create(struct whd_msgbuf *msgbuf, int ifidx,
     struct whd_msgbuf_work_item *create;
     ether_header_t *eh = (ether_header_t *)whd_buffer_get_current_piece_data_pointer(msgbuf->drvr, skb);
     uint32_t flowid;
+    whd_result_t result;
 
     create = whd_mem_malloc(sizeof(*create) );
     if (create == NULL)
@@ -1646,7 +1865,9 @@ static uint32_t whd_msgbuf_flowring_create(struct whd_msgbuf *msgbuf, int ifidx,
         return flowid;
     }
 
-    CY_ASSERT(whd_msgbuf_txflow_enqueue(msgbuf->drvr, (whd_buffer_t)skb, prio, flowid) == WHD_SUCCESS);
+    result = whd_msgbuf_txflow_enqueue(msgbuf->drvr, (whd_buffer_t)skb, prio, flowid);
+    CY_ASSERT( (result == WHD_SUCCESS) || (result == WHD_FLOW_CONTROLLED) );
+    (void)result;
     create->flowid = flowid;
     create->ifidx = ifidx;
     whd_mem_memcpy(create->sa, eh->source_address, ETHER_ADDR_LEN);
@@ -1661,7 +1882,8 @@ static uint32_t whd_msgbuf_flowring_create(struct whd_msgbuf *msgbuf, int ifidx,
     return flowid;
 }
 
-whd_result_t whd_msgbuf_tx_queue_data(whd_interface_t ifp, whd_buffer_t buffer)
+/* Queues a data packet on its flowring, marks the flowring to be scheduled but does not wake the WHD thread */
+static whd_result_t whd_msgbuf_tx_enqueue_data(whd_interface_t ifp, whd_buffer_t buffer, whd_bool_t *notify)
 {
     uint8_t *dscp = NULL;
     uint8_t priority = 0;
@@ -1716,17 +1938,63 @@ whd_result_t whd_msgbuf_tx_queue_data(whd_interface_t ifp, whd_buffer_t buffer)
     }
 
     result = whd_msgbuf_txflow_enqueue(whd_driver, buffer, priority, flowid);
-    /* If WHD TX buffer threshold exceeds, then just queue the packet,
-       don't schedule it, will be send in the next further slots */
+    /* If the TX packet or byte limit is exceeded, then just queue the packet, it is scheduled again
+       once TX completions bring the queue under the limits. The stack holds off meanwhile through
+       whd_network_tx_flow_controlled() */
     if ((result == WHD_FLOW_CONTROLLED) && (ether_type != WHD_ETHERTYPE_ARP))
     {
         return WHD_SUCCESS;
     }
 
-    whd_msgbuf_schedule_txdata(msgbuf, flowid);
+    setbit(msgbuf->flow_map, flowid);
+    *notify = WHD_TRUE;
     return WHD_SUCCESS;
 }
 
+whd_result_t whd_msgbuf_tx_queue_data(whd_interface_t ifp, whd_buffer_t buffer)
+{
+    whd_bool_t notify = WHD_FALSE;
+    whd_result_t result;
+
+    result = whd_msgbuf_tx_enqueue_data(ifp, buffer, &notify);
+    if (notify == WHD_TRUE)
+    {
+        whd_thread_notify(ifp->whd_driver);
+    }
+
+    return result;
+}
+
+whd_result_t whd_msgbuf_tx_queue_data_batch(whd_interface_t ifp, const whd_buffer_t *buffers, uint32_t count)
+{
+    whd_bool_t notify = WHD_FALSE;
+    whd_result_t batch_result = WHD_SUCCESS;
+    whd_result_t result;
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        result = whd_msgbuf_tx_enqueue_data(ifp, buffers[i], &notify);
+        if ( (result != WHD_SUCCESS) && (batch_result == WHD_SUCCESS) )
+        {
+            batch_result = result;
+        }
+    }
+
+    /* Wake the WHD thread once for the whole batch */
+    if (notify == WHD_TRUE)
+    {
+        whd_thread_notify(ifp->whd_driver);
+    }
+
+    return batch_result;
+}
+
+static whd_bool_t whd_msgbuf_tx_flow_controlled(whd_driver_t whd_driver)
+{
+    return whd_driver->msgbuf->tx_held;
+}
+
 static whd_result_t whd_msgbuf_rxbuf_data_post(struct whd_msgbuf *msgbuf, uint32_t count)
 {
     struct whd_driver *drvr = msgbuf->drvr;
@@ -2037,6 +2305,7 @@ static whd_result_t whd_msgbuf_attach(struct whd_driver *whd_driver)
         return WHD_MALLOC_FAILURE;
     }
     whd_mem_memset(msgbuf, 0, sizeof(struct whd_msgbuf) );
+    whd_bql_init(&msgbuf->tx_bql, WHD_MSGBUF_TX_BQL_MIN_LIMIT, WHD_MSGBUF_TX_BQL_MAX_LIMIT, WHD_BQL_HOLD_TIME_MS);
 
     count = CEIL(whd_driver->ram_shared->max_flowrings, NBBY);
     count = count * sizeof(uint8_t);
@@ -2181,6 +2450,9 @@ void whd_msgbuf_info_deinit(whd_driver_t whd_driver)
     /* Delete the queue mutex.  */
     (void)cy_rtos_deinit_semaphore(&msgbuf_info->ioctl_mutex);
 
+    /* Delete the asynchronous IOCTL mutex */
+    (void)cy_rtos_deinit_semaphore(&msgbuf_info->ioctl_async_mutex);
+
     /* Delete the event list management mutex */
     (void)cy_rtos_deinit_semaphore(&msgbuf_info->event_list_mutex);
 
@@ -2222,9 +2494,25 @@ whd_result_t whd_msgbuf_info_init(whd_driver_t whd_driver)
         return WHD_SEMAPHORE_ERROR;
     }
 
+    /* Create the mutex protecting the asynchronous IOCTL */
+    if (cy_rtos_init_semaphore(&msgbuf_info->ioctl_async_mutex, 1, 0) != WHD_SUCCESS)
+    {
+        cy_rtos_deinit_semaphore(&msgbuf_info->ioctl_sleep);
+        cy_rtos_deinit_semaphore(&msgbuf_info->ioctl_mutex);
+        return WHD_SEMAPHORE_ERROR;
+    }
+    if (cy_rtos_set_semaphore(&msgbuf_info->ioctl_async_mutex, WHD_FALSE) != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
+        return WHD_SEMAPHORE_ERROR;
+    }
+    whd_mem_memset(&msgbuf_info->ioctl_async, 0, sizeof(msgbuf_info->ioctl_async) );
+    msgbuf_info->ioctl_async_last_request = 0;
+
     /* Create semaphore to protect event list management */
     if (cy_rtos_init_semaphore(&msgbuf_info->event_list_mutex, 1, 0) != WHD_SUCCESS)
     {
+        cy_rtos_deinit_semaphore(&msgbuf_info->ioctl_async_mutex);
         cy_rtos_deinit_semaphore(&msgbuf_info->ioctl_sleep);
         cy_rtos_deinit_semaphore(&msgbuf_info->ioctl_mutex);
         return WHD_SEMAPHORE_ERROR;
@@ -2260,6 +2548,12 @@ whd_result_t whd_msgbuf_info_init(whd_driver_t whd_driver)
     whd_driver->proto->set_iovar = whd_msgbuf_set_iovar;
     whd_driver->proto->get_iovar = whd_msgbuf_get_iovar;
     whd_driver->proto->tx_queue_data = whd_msgbuf_tx_queue_data;
+    whd_driver->proto->tx_queue_data_batch = whd_msgbuf_tx_queue_data_batch;
+    whd_driver->proto->tx_flow_controlled = whd_msgbuf_tx_flow_controlled;
+    whd_driver->proto->set_ioctl_async = whd_msgbuf_send_ioctl_async;
+    whd_driver->proto->get_ioctl_async = whd_msgbuf_send_ioctl_async;
+    whd_driver->proto->cancel_ioctl_async = whd_msgbuf_cancel_ioctl_async;
+    whd_driver->proto->poll_ioctl_async = whd_msgbuf_poll_ioctl_async;
     whd_driver->proto->pd = msgbuf_info;
 
     CHECK_RETURN(whd_msgbuf_attach(whd_driver) );
@@ -84,6 +84,39 @@ whd_result_t whd_network_process_ethernet_data(whd_interface_t ifp, whd_buffer_t
     return WHD_WLAN_NOFUNCTION;
 }
 
+/** Tells the network stack of every interface that it may resume sending
+ *
+ * @param whd_driver : WHD driver instance
+ */
+void whd_network_tx_resume(whd_driver_t whd_driver)
+{
+    uint32_t i;
+
+    if (whd_driver->network_if->whd_network_tx_resume == NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < WHD_INTERFACE_MAX; i++)
+    {
+        if (whd_driver->iflist[i] != NULL)
+        {
+            whd_driver->network_if->whd_network_tx_resume(whd_driver->iflist[i]);
+        }
+    }
+}
+
+/** Checks whether a TX queue is at or over its byte limit
+ *
+ * @param interface : the interface over which the stack sends
+ *
+ * @return    WHD_TRUE if the stack should hold off sending
+ */
+whd_bool_t whd_network_tx_flow_controlled(whd_interface_t ifp)
+{
+    return whd_proto_tx_flow_controlled(ifp->whd_driver);
+}
+
 /** Sends a data packet.
  *
  * @param buffer  : The ethernet packet buffer to be sent
@@ -103,3 +136,29 @@ whd_result_t whd_network_send_ethernet_data(whd_interface_t ifp, whd_buffer_t bu
     return whd_proto_tx_queue_data(ifp, buffer);
 #endif
 }
+
+/** Sends a batch of data packets.
+ *
+ * @param interface : the interface over which to send the packets (AP or STA)
+ * @param buffers   : The ethernet packet buffers to be sent
+ * @param count     : Number of packets
+ *
+ * @return    WHD result code
+ */
+whd_result_t whd_network_send_ethernet_data_batch(whd_interface_t ifp, const whd_buffer_t *buffers, uint32_t count)
+{
+    if ( (buffers == NULL) || (count == 0) )
+    {
+        return WHD_BADARG;
+    }
+
+#ifdef COMPONENT_SDIO_HM
+    whd_result_t status;
+    cy_rtos_get_mutex(&ifp->whd_driver->whd_hm_tx_lock, CY_RTOS_NEVER_TIMEOUT);
+    status = whd_proto_tx_queue_data_batch(ifp, buffers, count);
+    cy_rtos_set_mutex(&ifp->whd_driver->whd_hm_tx_lock);
+    return status;
+#else
+    return whd_proto_tx_queue_data_batch(ifp, buffers, count);
+#endif
+}
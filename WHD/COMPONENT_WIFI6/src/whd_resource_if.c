@@ -22,6 +22,10 @@
 #include "whd_debug.h"
 #include "whd_int.h"
 #include "whd_resource_if.h"
+#ifdef WHD_COMPRESSED_RESOURCES
+#include "whd_lz.h"
+#include "whd_utils.h"
+#endif
 
 /******************************************************
  *  * @cond               Constants
@@ -39,11 +43,242 @@
  *        Variables Definitions
  *****************************************************/
 
+#ifdef WHD_COMPRESSED_RESOURCES
+/* Firmware and CLM may be packed by tools/whd_pack_resource.py. The wrappers below then hand
+ * out the unpacked resource in WHD_RESOURCE_LZ_BLOCK_SIZE blocks, decoded from the source
+ * blocks as they are requested, so callers never see the packed form.
+ */
+struct whd_resource_stream
+{
+    whd_bool_t packed;
+    whd_lz_header_t header;
+    whd_lz_stream_t lz;
+    uint8_t *ring;              /* Decoded blocks, NULL until the resource is read */
+    uint32_t ring_size;
+    uint32_t next_block;        /* Next block to decode */
+    uint32_t in_block;          /* Source block the input comes from */
+    uint32_t in_offset;         /* Offset of the next input byte in that block */
+    const uint8_t *in_data;
+    uint32_t in_left;
+    uint32_t in_reads;          /* resource_source_reads when in_data was fetched */
+};
+#endif /* WHD_COMPRESSED_RESOURCES */
+
 /******************************************************
 *               Function Definitions
 ******************************************************/
+#ifdef WHD_COMPRESSED_RESOURCES
+static uint32_t whd_resource_source_block(whd_driver_t whd_driver, whd_resource_type_t type, uint32_t blockno,
+                                          const uint8_t **data, uint32_t *size_out)
+{
+    if (whd_driver->resource_if->whd_get_resource_block == NULL)
+    {
+        WPRINT_WHD_ERROR( ("Function pointers not provided .\n") );
+        return WHD_WLAN_NOFUNCTION;
+    }
+
+    /* Sources may hand out every block in the same buffer */
+    whd_driver->resource_source_reads++;
+
+    return whd_driver->resource_if->whd_get_resource_block(whd_driver, type, blockno, data, size_out);
+}
+
+/* Returns the stream of a packed resource, or NULL if the resource is not packed */
+static struct whd_resource_stream *whd_resource_get_stream(whd_driver_t whd_driver, whd_resource_type_t type)
+{
+    struct whd_resource_stream *stream;
+    const uint8_t *data;
+    uint32_t size = 0;
+
+    /* NVRAM is text the driver edits, it is never packed */
+    if ( (type != WHD_RESOURCE_WLAN_FIRMWARE) && (type != WHD_RESOURCE_WLAN_CLM) )
+    {
+        return NULL;
+    }
+
+    stream = whd_driver->resource_stream[type];
+    if (stream == NULL)
+    {
+        if (whd_resource_source_block(whd_driver, type, 0, &data, &size) != WHD_SUCCESS)
+        {
+            return NULL;
+        }
+
+        stream = (struct whd_resource_stream *)whd_mem_calloc(1, sizeof(*stream) );
+        if (stream == NULL)
+        {
+            return NULL;
+        }
+
+        if (whd_lz_parse_header(data, size, &stream->header) == WHD_SUCCESS)
+        {
+            stream->packed = WHD_TRUE;
+            stream->ring_size = ROUND_UP(stream->header.window_size, WHD_RESOURCE_LZ_BLOCK_SIZE) +
+                                WHD_RESOURCE_LZ_BLOCK_SIZE;
+            WPRINT_WHD_INFO( ("Resource %d packed, %" PRIu32 " -> %" PRIu32 " bytes, %" PRIu32 " byte window\n",
+                              (int)type, stream->header.size, stream->header.packed_size,
+                              stream->header.window_size) );
+        }
+        whd_driver->resource_stream[type] = stream;
+    }
+
+    return (stream->packed == WHD_TRUE) ? stream : NULL;
+}
+
+static uint32_t whd_resource_stream_restart(whd_driver_t whd_driver, whd_resource_type_t type,
+                                            struct whd_resource_stream *stream)
+{
+    uint32_t i;
+
+    if (stream->ring == NULL)
+    {
+        /* Only one resource is downloaded at a time */
+        for (i = 0; i <= WHD_RESOURCE_WLAN_CLM; i++)
+        {
+            if (i != (uint32_t)type)
+            {
+                whd_resource_release(whd_driver, (whd_resource_type_t)i);
+            }
+        }
+
+        stream->ring = (uint8_t *)whd_mem_malloc(stream->ring_size);
+        if (stream->ring == NULL)
+        {
+            WPRINT_WHD_ERROR( ("Unable to allocate %" PRIu32 " bytes to unpack resource %d\n", stream->ring_size,
+                               (int)type) );
+            return WHD_BUFFER_ALLOC_FAIL;
+        }
+    }
+
+    whd_lz_stream_init(&stream->lz, &stream->header, stream->ring, stream->ring_size);
+    stream->next_block = 0;
+    stream->in_block = 0;
+    stream->in_offset = WHD_LZ_HEADER_SIZE;
+    stream->in_data = NULL;
+    stream->in_left = 0;
+
+    return WHD_SUCCESS;
+}
+
+static uint32_t whd_resource_stream_fill(whd_driver_t whd_driver, whd_resource_type_t type,
+                                         struct whd_resource_stream *stream)
+{
+    const uint8_t *data;
+    uint32_t size = 0;
+    uint32_t result;
+
+    if ( (stream->in_data != NULL) && (stream->in_left == 0) )
+    {
+        stream->in_block++;
+        stream->in_offset = 0;
+    }
+
+    result = whd_resource_source_block(whd_driver, type, stream->in_block, &data, &size);
+    if ( (result != WHD_SUCCESS) || (size <= stream->in_offset) )
+    {
+        WPRINT_WHD_ERROR( ("Packed resource %d truncated at block %" PRIu32 "\n", (int)type, stream->in_block) );
+        return (result != WHD_SUCCESS) ? result : WHD_BADARG;
+    }
+
+    stream->in_data = data + stream->in_offset;
+    stream->in_left = size - stream->in_offset;
+    stream->in_reads = whd_driver->resource_source_reads;
+
+    return WHD_SUCCESS;
+}
+
+static uint32_t whd_resource_stream_block(whd_driver_t whd_driver, whd_resource_type_t type,
+                                          struct whd_resource_stream *stream, uint32_t blockno,
+                                          const uint8_t **data, uint32_t *size_out)
+{
+    uint32_t block_start = blockno * WHD_RESOURCE_LZ_BLOCK_SIZE;
+    uint32_t target;
+    uint32_t used;
+    uint32_t result;
+
+    if (block_start >= stream->header.size)
+    {
+        return WHD_BADARG;
+    }
+
+    /* Blocks are decoded in order, going back starts over */
+    if ( (stream->ring == NULL) || (blockno + 1 < stream->next_block) )
+    {
+        CHECK_RETURN(whd_resource_stream_restart(whd_driver, type, stream) );
+    }
+
+    while (stream->next_block <= blockno)
+    {
+        target = MIN_OF(stream->header.size, (stream->next_block + 1) * WHD_RESOURCE_LZ_BLOCK_SIZE);
+        while (stream->lz.out_pos < target)
+        {
+            if ( (stream->in_left == 0) || (stream->in_reads != whd_driver->resource_source_reads) )
+            {
+                CHECK_RETURN(whd_resource_stream_fill(whd_driver, type, stream) );
+            }
+
+            result = whd_lz_stream_decode(&stream->lz, stream->in_data, stream->in_left, &used, target);
+            if (result != WHD_SUCCESS)
+            {
+                WPRINT_WHD_ERROR( ("Packed resource %d corrupt at %" PRIu32 "\n", (int)type, stream->lz.out_pos) );
+                stream->next_block = 0;
+                stream->in_left = 0;
+                whd_resource_release(whd_driver, type);
+                return result;
+            }
+            stream->in_data += used;
+            stream->in_left -= used;
+            stream->in_offset += used;
+        }
+        stream->next_block++;
+    }
+
+    /* The ring is a whole number of blocks, so a block never wraps */
+    *data = stream->ring + (block_start % stream->ring_size);
+    *size_out = MIN_OF(WHD_RESOURCE_LZ_BLOCK_SIZE, stream->header.size - block_start);
+
+    return WHD_SUCCESS;
+}
+
+static uint32_t whd_resource_stream_read(whd_driver_t whd_driver, whd_resource_type_t type,
+                                         struct whd_resource_stream *stream, uint32_t offset, uint32_t size,
+                                         uint32_t *size_out, void *buffer)
+{
+    const uint8_t *data;
+    uint32_t block_size;
+    uint32_t skip;
+    uint32_t len;
+
+    *size_out = 0;
+    while ( (size != 0) && (offset < stream->header.size) )
+    {
+        CHECK_RETURN(whd_resource_stream_block(whd_driver, type, stream, offset / WHD_RESOURCE_LZ_BLOCK_SIZE,
+                                               &data, &block_size) );
+        skip = offset % WHD_RESOURCE_LZ_BLOCK_SIZE;
+        len = MIN_OF(size, block_size - skip);
+        whd_mem_memcpy( (uint8_t *)buffer + *size_out, data + skip, len );
+        *size_out += len;
+        offset += len;
+        size -= len;
+    }
+
+    return WHD_SUCCESS;
+}
+
+#endif /* WHD_COMPRESSED_RESOURCES */
+
 uint32_t whd_resource_size(whd_driver_t whd_driver, whd_resource_type_t resource, uint32_t *size_out)
 {
+#ifdef WHD_COMPRESSED_RESOURCES
+    struct whd_resource_stream *stream = whd_resource_get_stream(whd_driver, resource);
+
+    if (stream != NULL)
+    {
+        *size_out = stream->header.size;
+        return WHD_SUCCESS;
+    }
+#endif
+
     if (whd_driver->resource_if->whd_resource_size)
     {
         return whd_driver->resource_if->whd_resource_size(whd_driver, resource, size_out);
@@ -58,6 +293,13 @@ uint32_t whd_resource_size(whd_driver_t whd_driver, whd_resource_type_t resource
 
 uint32_t whd_get_resource_block_size(whd_driver_t whd_driver, whd_resource_type_t type, uint32_t *size_out)
 {
+#ifdef WHD_COMPRESSED_RESOURCES
+    if (whd_resource_get_stream(whd_driver, type) != NULL)
+    {
+        *size_out = WHD_RESOURCE_LZ_BLOCK_SIZE;
+        return WHD_SUCCESS;
+    }
+#endif
 
     if (whd_driver->resource_if->whd_get_resource_block_size)
     {
@@ -73,6 +315,16 @@ uint32_t whd_get_resource_block_size(whd_driver_t whd_driver, whd_resource_type_
 
 uint32_t whd_get_resource_no_of_blocks(whd_driver_t whd_driver, whd_resource_type_t type, uint32_t *block_count)
 {
+#ifdef WHD_COMPRESSED_RESOURCES
+    struct whd_resource_stream *stream = whd_resource_get_stream(whd_driver, type);
+
+    if (stream != NULL)
+    {
+        *block_count = (stream->header.size + WHD_RESOURCE_LZ_BLOCK_SIZE - 1) / WHD_RESOURCE_LZ_BLOCK_SIZE;
+        return WHD_SUCCESS;
+    }
+#endif
+
     if (whd_driver->resource_if->whd_get_resource_no_of_blocks)
     {
         return whd_driver->resource_if->whd_get_resource_no_of_blocks(whd_driver, type, block_count);
@@ -88,7 +340,16 @@ uint32_t whd_get_resource_no_of_blocks(whd_driver_t whd_driver, whd_resource_typ
 uint32_t whd_get_resource_block(whd_driver_t whd_driver, whd_resource_type_t type,
                                 uint32_t blockno, const uint8_t **data, uint32_t *size_out)
 {
+#ifdef WHD_COMPRESSED_RESOURCES
+    struct whd_resource_stream *stream = whd_resource_get_stream(whd_driver, type);
 
+    if (stream != NULL)
+    {
+        return whd_resource_stream_block(whd_driver, type, stream, blockno, data, size_out);
+    }
+
+    return whd_resource_source_block(whd_driver, type, blockno, data, size_out);
+#else
     if (whd_driver->resource_if->whd_get_resource_block)
     {
         return whd_driver->resource_if->whd_get_resource_block(whd_driver, type, blockno, data, size_out);
@@ -99,11 +360,22 @@ uint32_t whd_get_resource_block(whd_driver_t whd_driver, whd_resource_type_t typ
     }
 
     return WHD_WLAN_NOFUNCTION;
+#endif /* WHD_COMPRESSED_RESOURCES */
 }
 
 uint32_t whd_resource_read(whd_driver_t whd_driver, whd_resource_type_t type, uint32_t offset,
                            uint32_t size, uint32_t *size_out, void *buffer)
 {
+#ifdef WHD_COMPRESSED_RESOURCES
+    struct whd_resource_stream *stream = whd_resource_get_stream(whd_driver, type);
+
+    if (stream != NULL)
+    {
+        return whd_resource_stream_read(whd_driver, type, stream, offset, size, size_out, buffer);
+    }
+    whd_driver->resource_source_reads++;
+#endif
+
     if (whd_driver->resource_if->whd_resource_read)
     {
         return whd_driver->resource_if->whd_resource_read(whd_driver, type, offset, size, size_out, buffer);
@@ -115,3 +387,69 @@ uint32_t whd_resource_read(whd_driver_t whd_driver, whd_resource_type_t type, ui
 
     return WHD_WLAN_NOFUNCTION;
 }
+
+uint32_t whd_get_resource_direct(whd_driver_t whd_driver, whd_resource_type_t type, const uint8_t **data,
+                                 uint32_t *size_out)
+{
+    /* NVRAM is converted while it is read, it is never written from the source's memory */
+    if (type != WHD_RESOURCE_WLAN_FIRMWARE)
+    {
+        return WHD_UNSUPPORTED;
+    }
+
+#ifdef WHD_COMPRESSED_RESOURCES
+    if (whd_resource_get_stream(whd_driver, type) != NULL)
+    {
+        return WHD_UNSUPPORTED;
+    }
+#endif
+
+    /* Optional, the resource is read block by block without it */
+    if (whd_driver->resource_if->whd_get_resource_direct)
+    {
+        return whd_driver->resource_if->whd_get_resource_direct(whd_driver, type, data, size_out);
+    }
+
+    return WHD_UNSUPPORTED;
+}
+
+void whd_resource_release(whd_driver_t whd_driver, whd_resource_type_t type)
+{
+#ifdef WHD_COMPRESSED_RESOURCES
+    struct whd_resource_stream *stream;
+
+    if ( (uint32_t)type > WHD_RESOURCE_WLAN_CLM )
+    {
+        return;
+    }
+
+    stream = whd_driver->resource_stream[type];
+    if ( (stream != NULL) && (stream->ring != NULL) )
+    {
+        whd_mem_free(stream->ring);
+        stream->ring = NULL;
+    }
+#else
+    UNUSED_PARAMETER(whd_driver);
+    UNUSED_PARAMETER(type);
+#endif
+}
+
+void whd_resource_deinit(whd_driver_t whd_driver)
+{
+#ifdef WHD_COMPRESSED_RESOURCES
+    uint32_t i;
+
+    for (i = 0; i <= WHD_RESOURCE_WLAN_CLM; i++)
+    {
+        whd_resource_release(whd_driver, (whd_resource_type_t)i);
+        if (whd_driver->resource_stream[i] != NULL)
+        {
+            whd_mem_free(whd_driver->resource_stream[i]);
+            whd_driver->resource_stream[i] = NULL;
+        }
+    }
+#else
+    UNUSED_PARAMETER(whd_driver);
+#endif
+}
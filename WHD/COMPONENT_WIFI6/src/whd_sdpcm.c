@@ -50,6 +50,19 @@
 
 #define SDPCM_HEADER_LEN              (12)
 
+/* Byte offsets of the SDPCM header fields, the header is read and written in place through these */
+#define SDPCM_FRAMETAG_LEN             (4)
+#define SDPCM_SEQUENCE_OFFSET          (SDPCM_FRAMETAG_LEN + 0)
+#define SDPCM_CHANNEL_OFFSET           (SDPCM_FRAMETAG_LEN + 1)
+#define SDPCM_DOFFSET_OFFSET           (SDPCM_FRAMETAG_LEN + 3)
+#define SDPCM_HWEXT_HEADER_LEN         (8)
+#define SDPCM_HWEXT_LASTFRM           (1 << 24)
+#define SDPCM_HWEXT_TAIL_PAD_SHIFT    (16)
+
+/* TX glom constants */
+#define SDPCM_TX_GLOM_ALIGN           (4)         /** Alignment of each subframe within a superframe */
+#define SDPCM_TX_GLOM_MAX_SIZE        (16 * 1024) /** Upper bound of a superframe, must fit one CMD53 */
+
 /* Event flags */
 #define WLC_EVENT_MSG_LINK      (0x01)    /** link is up */
 #define WLC_EVENT_MSG_FLUSHTXQ  (0x02)    /** flush tx queue on MIC error */
@@ -62,6 +75,10 @@
 #define MAX_WMM_AC     4
 #define AC_QUEUE_SIZE  64
 
+/* Byte queue limits of the AC queues. AC_QUEUE_SIZE remains the hard packet bound */
+#define SDPCM_TX_BQL_MIN_LIMIT  (WHD_LINK_MTU)
+#define SDPCM_TX_BQL_MAX_LIMIT  (AC_QUEUE_SIZE * WHD_LINK_MTU)
+
 /******************************************************
 *             Macros
 ******************************************************/
@@ -143,6 +160,15 @@ typedef struct bcm_event
 
 #pragma pack()
 
+/** TX scheduler: picks the data AC queue to serve next */
+typedef struct whd_sdpcm_tx_sched
+{
+    /* Returns the AC whose head packet should be sent next, or -1 if no data AC may send */
+    int (*select)(whd_driver_t whd_driver);
+    /* Accounts for a packet of the given size sent from the selected AC, may be NULL */
+    void (*charge)(whd_driver_t whd_driver, int ac, uint32_t size);
+} whd_sdpcm_tx_sched_t;
+
 /******************************************************
 *             Static Variables
 ******************************************************/
@@ -214,6 +240,40 @@ static void add_sdpcm_log_entry(sdpcm_log_direction_t dir, sdpcm_log_type_t type
 static whd_buffer_t  whd_sdpcm_get_next_buffer_in_queue(whd_driver_t whd_driver, whd_buffer_t buffer);
 static void            whd_sdpcm_set_next_buffer_in_queue(whd_driver_t whd_driver, whd_buffer_t buffer,
                                                           whd_buffer_t prev_buffer);
+static whd_result_t    whd_sdpcm_check_tx_allowed(whd_driver_t whd_driver);
+static whd_result_t    whd_sdpcm_dequeue_packet(whd_driver_t whd_driver, uint16_t max_size, whd_buffer_t *buffer);
+/* The SDPCM header follows the buffer header at no particular alignment, so the 16 bit
+ * frametag fields are accessed bytewise in device (little endian) order */
+static inline uint16_t whd_sdpcm_read16(const uint8_t *field)
+{
+    return (uint16_t)(field[0] | (field[1] << 8) );
+}
+
+static inline void whd_sdpcm_write_frametag(uint8_t *frametag, uint16_t size)
+{
+    frametag[0] = (uint8_t)size;
+    frametag[1] = (uint8_t)(size >> 8);
+    frametag[2] = (uint8_t)~size;
+    frametag[3] = (uint8_t)(~size >> 8);
+}
+
+static whd_bool_t      whd_sdpcm_tx_packet_ac(whd_driver_t whd_driver, whd_buffer_t buffer, int *ac,
+                                              uint32_t *size);
+static whd_result_t    whd_sdpcm_prepare_to_queue(whd_driver_t whd_driver, whd_buffer_t buffer,
+                                                  sdpcm_header_type_t header_type, uint8_t prio, int *ac);
+static whd_result_t    whd_sdpcm_push_to_queue(whd_driver_t whd_driver, int ac, sdpcm_header_type_t header_type,
+                                               whd_buffer_t newest, whd_buffer_t oldest, uint32_t count);
+static whd_buffer_t    whd_sdpcm_peek_queue(whd_driver_t whd_driver, int ac);
+static int             whd_sdpcm_tx_sched_strict_select(whd_driver_t whd_driver);
+static int             whd_sdpcm_tx_sched_drr_select(whd_driver_t whd_driver);
+static void            whd_sdpcm_tx_sched_drr_charge(whd_driver_t whd_driver, int ac, uint32_t size);
+
+/* Indexed by whd_tx_sched_mode_t */
+static const whd_sdpcm_tx_sched_t whd_sdpcm_tx_scheds[] =
+{
+    { whd_sdpcm_tx_sched_strict_select, NULL },
+    { whd_sdpcm_tx_sched_drr_select, whd_sdpcm_tx_sched_drr_charge },
+};
 extern void whd_wifi_log_event(whd_driver_t whd_driver, const whd_event_header_t *event_header,
                                const uint8_t *event_data);
 /******************************************************
@@ -222,7 +282,7 @@ extern void whd_wifi_log_event(whd_driver_t whd_driver, const whd_event_header_t
 
 /** Initialises the SDPCM protocol handler
  *
- *  Initialises mutex and semaphore flags needed by the SDPCM handler.
+ *  Initialises the packet send queues and their mutex needed by the SDPCM handler.
  *  Also initialises the list of event handlers. This function is called
  *  from the @ref whd_thread_init function.
  *
@@ -248,11 +308,43 @@ whd_result_t whd_sdpcm_init(whd_driver_t whd_driver)
     /* Packet send queue variables */
     for (ac = 0; ac <= MAX_WMM_AC; ac++)
     {
+        sdpcm_info->send_queue_in[ac] = (whd_buffer_t)NULL;
         sdpcm_info->send_queue_head[ac] = (whd_buffer_t)NULL;
-        sdpcm_info->send_queue_tail[ac] = (whd_buffer_t)NULL;
-        sdpcm_info->npkt_in_q[ac] = 0;
+        sdpcm_info->npkt_pushed[ac] = 0;
+        sdpcm_info->npkt_sent[ac] = 0;
+    }
+    sdpcm_info->totpkt_pushed = 0;
+    sdpcm_info->totpkt_sent = 0;
+
+    /* TX glomming is turned on by whd_sdpcm_tx_glom_enable() once the firmware agreed to it */
+    sdpcm_info->tx_glom_enabled = WHD_FALSE;
+
+    /* TX scheduler variables */
+    if ( (uint32_t)sdpcm_info->tx_sched_mode >= sizeof(whd_sdpcm_tx_scheds) / sizeof(whd_sdpcm_tx_scheds[0]) )
+    {
+        WPRINT_WHD_ERROR( ("Unknown TX scheduler %d, using strict priority\n", (int)sdpcm_info->tx_sched_mode) );
+        sdpcm_info->tx_sched_mode = WHD_TX_SCHED_STRICT_PRIORITY;
+    }
+    sdpcm_info->tx_sched = &whd_sdpcm_tx_scheds[sdpcm_info->tx_sched_mode];
+    for (ac = 0; ac < MAX_WMM_AC; ac++)
+    {
+        if (sdpcm_info->tx_sched_quantum[ac] == 0)
+        {
+            sdpcm_info->tx_sched_quantum[ac] = WHD_LINK_MTU;
+        }
+        sdpcm_info->tx_sched_deficit[ac] = 0;
+    }
+    sdpcm_info->tx_sched_ac = 0;
+    sdpcm_info->tx_sched_deficit[0] = sdpcm_info->tx_sched_quantum[0];
+
+    for (ac = 0; ac < MAX_WMM_AC; ac++)
+    {
+        whd_bql_init(&sdpcm_info->tx_bql[ac], SDPCM_TX_BQL_MIN_LIMIT, SDPCM_TX_BQL_MAX_LIMIT, WHD_BQL_HOLD_TIME_MS);
+        sdpcm_info->tx_done_bytes[ac] = 0;
     }
-    sdpcm_info->totpkt_in_q = 0;
+    sdpcm_info->tx_held_acs = 0;
+    sdpcm_info->tx_done_frames = 0;
+    sdpcm_info->tx_failed_frames = 0;
 
     whd_sdpcm_bus_vars_init(whd_driver);
 
@@ -271,7 +363,7 @@ void whd_sdpcm_bus_vars_init(whd_driver_t whd_driver)
 
 /** Initialises the SDPCM protocol handler
  *
- *  De-initialises mutex and semaphore flags needed by the SDPCM handler.
+ *  Releases any packets left in the send queues and the TX glom buffer.
  *  This function is called from the @ref whd_thread_func function when it is exiting.
  */
 void whd_sdpcm_quit(whd_driver_t whd_driver)
@@ -280,13 +372,10 @@ void whd_sdpcm_quit(whd_driver_t whd_driver)
     whd_result_t result;
     int ac;
 
-    /* Delete the SDPCM queue mutex */
-    (void)cy_rtos_deinit_semaphore(&sdpcm_info->send_queue_mutex);    /* Ignore return - not much can be done about failure */
-
     /* Free any left over packets in the queue */
     for (ac = 0; ac <= MAX_WMM_AC; ac++)
     {
-        while (sdpcm_info->send_queue_head[ac] != NULL)
+        while (whd_sdpcm_peek_queue(whd_driver, ac) != NULL)
         {
             whd_buffer_t buf = whd_sdpcm_get_next_buffer_in_queue(whd_driver, sdpcm_info->send_queue_head[ac]);
             result = whd_buffer_release(whd_driver, sdpcm_info->send_queue_head[ac], WHD_NETWORK_TX);
@@ -294,9 +383,28 @@ void whd_sdpcm_quit(whd_driver_t whd_driver)
                 WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
             sdpcm_info->send_queue_head[ac] = buf;
         }
-        sdpcm_info->npkt_in_q[ac] = 0;
+        sdpcm_info->npkt_sent[ac] = sdpcm_info->npkt_pushed[ac];
+        if (ac < MAX_WMM_AC)
+        {
+            whd_bql_reset(&sdpcm_info->tx_bql[ac]);
+            sdpcm_info->tx_done_bytes[ac] = 0;
+        }
+    }
+    sdpcm_info->totpkt_sent = sdpcm_info->totpkt_pushed;
+    sdpcm_info->tx_held_acs = 0;
+    sdpcm_info->tx_done_frames = 0;
+    sdpcm_info->tx_failed_frames = 0;
+
+    /* Delete the SDPCM queue mutex */
+    (void)cy_rtos_deinit_semaphore(&sdpcm_info->send_queue_mutex);    /* Ignore return - not much can be done about failure */
+
+    sdpcm_info->tx_glom_enabled = WHD_FALSE;
+    if (sdpcm_info->tx_glom_buffer != NULL)
+    {
+        whd_mem_free(sdpcm_info->tx_glom_buffer);
+        sdpcm_info->tx_glom_buffer = NULL;
+        sdpcm_info->tx_glom_buffer_size = 0;
     }
-    sdpcm_info->totpkt_in_q = 0;
 }
 
 void whd_sdpcm_update_credit(whd_driver_t whd_driver, uint8_t *data)
@@ -334,24 +442,22 @@ void whd_sdpcm_update_credit(whd_driver_t whd_driver, uint8_t *data)
 void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
 {
     bus_common_header_t *packet;
+    uint8_t *header;
     uint16_t size;
     uint16_t size_inv;
-    sdpcm_header_t sdpcm_header;
+    uint8_t doffset;
     whd_result_t result;
 
     packet = (bus_common_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, buffer);
     CHECK_PACKET_WITH_NULL_RETURN(packet);
-    whd_mem_memcpy(&sdpcm_header, packet->bus_header, BUS_HEADER_LEN);
-
-    sdpcm_header.frametag[0] = dtoh16(sdpcm_header.frametag[0]);
-    sdpcm_header.frametag[1] = dtoh16(sdpcm_header.frametag[1]);
+    header = packet->bus_header;
 
     /* Extract the total SDPCM packet size from the first two frametag bytes */
-    size = sdpcm_header.frametag[0];
+    size = whd_sdpcm_read16(&header[0]);
 
     /* Check that the second two frametag bytes are the binary inverse of the size */
     size_inv = (uint16_t) ~size;  /* Separate variable due to GCC Bug 38341 */
-    if (sdpcm_header.frametag[1] != size_inv)
+    if (whd_sdpcm_read16(&header[2]) != size_inv)
     {
         WPRINT_WHD_DEBUG( ("Received a packet with a frametag which is wrong\n") );
         result = whd_buffer_release(whd_driver, buffer, WHD_NETWORK_RX);
@@ -373,9 +479,8 @@ void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
         return;
     }
 
-    /* Get address of packet->sdpcm_header.frametag indirectly to avoid IAR's unaligned address warning */
-    whd_sdpcm_update_credit(whd_driver,
-                            (uint8_t *)&sdpcm_header.sw_header - sizeof(sdpcm_header.frametag) );
+    whd_sdpcm_update_credit(whd_driver, header);
+    doffset = header[SDPCM_DOFFSET_OFFSET];
 
     if (size == (uint16_t)SDPCM_HEADER_LEN)
     {
@@ -388,7 +493,7 @@ void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
     }
 
     /* Check the SDPCM channel to decide what to do with packet. */
-    switch (sdpcm_header.sw_header.channel_and_flags & 0x0f)
+    switch (header[SDPCM_CHANNEL_OFFSET] & 0x0f)
     {
         case CONTROL_HEADER:  /* IOCTL/IOVAR reply packet */
         {
@@ -396,8 +501,7 @@ void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
                                 (char *)whd_buffer_get_current_piece_data_pointer(whd_driver, buffer) );
 
             /* Check that packet size is big enough to contain the CDC header as well as the SDPCM header */
-            if (sdpcm_header.frametag[0] <
-                (sizeof(sdpcm_header.frametag) + sizeof(sdpcm_sw_header_t) + sizeof(cdc_header_t) ) )
+            if (size < (SDPCM_HEADER_LEN + sizeof(cdc_header_t) ) )
             {
                 /* Received a too-short SDPCM packet! */
                 WPRINT_WHD_DEBUG( ("Received a too-short SDPCM packet!\n") );
@@ -410,8 +514,7 @@ void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
 
             /* Move SDPCM header and Buffer header to pass onto next layer */
             whd_buffer_add_remove_at_front(whd_driver, &buffer,
-                                           (int32_t)(sizeof(whd_buffer_header_t) +
-                                                     sdpcm_header.sw_header.header_length) );
+                                           (int32_t)(sizeof(whd_buffer_header_t) + doffset) );
 
             whd_process_cdc(whd_driver, buffer);
         }
@@ -421,8 +524,7 @@ void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
         case DATA_HEADER:
         {
             /* Check that the packet is big enough to contain SDPCM & BDC headers */
-            if (sdpcm_header.frametag[0] <=
-                (sizeof(sdpcm_header.frametag) + sizeof(sdpcm_sw_header_t) + sizeof(bdc_header_t) ) )
+            if (size <= (SDPCM_HEADER_LEN + sizeof(bdc_header_t) ) )
             {
                 WPRINT_WHD_ERROR( ("Packet too small to contain SDPCM + BDC headers\n") );
                 result = whd_buffer_release(whd_driver, buffer, WHD_NETWORK_RX);
@@ -434,8 +536,7 @@ void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
 
             /* Move SDPCM header and Buffer header to pass onto next layer */
             whd_buffer_add_remove_at_front(whd_driver, &buffer,
-                                           (int32_t)(sizeof(whd_buffer_header_t) +
-                                                     sdpcm_header.sw_header.header_length) );
+                                           (int32_t)(sizeof(whd_buffer_header_t) + doffset) );
 
             whd_process_bdc(whd_driver, buffer);
 
@@ -447,8 +548,7 @@ void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
 
             /* Move SDPCM header and Buffer header to pass onto next layer */
             whd_buffer_add_remove_at_front(whd_driver, &buffer,
-                                           (int32_t)(sizeof(whd_buffer_header_t) +
-                                                     sdpcm_header.sw_header.header_length) );
+                                           (int32_t)(sizeof(whd_buffer_header_t) + doffset) );
 
             whd_process_bdc_event(whd_driver, buffer, size);
         }
@@ -465,7 +565,7 @@ void whd_sdpcm_process_rx_packet(whd_driver_t whd_driver, whd_buffer_t buffer)
 
 whd_bool_t whd_sdpcm_has_tx_packet(whd_driver_t whd_driver)
 {
-    if (whd_driver->sdpcm_info.totpkt_in_q > 0)
+    if (whd_driver->sdpcm_info.totpkt_pushed != whd_driver->sdpcm_info.totpkt_sent)
     {
         return WHD_TRUE;
     }
@@ -476,75 +576,360 @@ whd_bool_t whd_sdpcm_has_tx_packet(whd_driver_t whd_driver)
 whd_result_t whd_sdpcm_get_packet_to_send(whd_driver_t whd_driver, whd_buffer_t *buffer)
 {
     bus_common_header_t *packet;
-    sdpcm_header_t sdpcm_header;
     whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
     whd_result_t result;
+
+    result = whd_sdpcm_check_tx_allowed(whd_driver);
+    if (result != WHD_SUCCESS)
+    {
+        return result;
+    }
+
+    result = whd_sdpcm_dequeue_packet(whd_driver, 0xFFFF, buffer);
+    if (result != WHD_SUCCESS)
+    {
+        return result;
+    }
+
+    /* Set the sequence number */
+    packet = (bus_common_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer);
+    CHECK_PACKET_NULL(packet, WHD_NO_REGISTER_FUNCTION_POINTER);
+    packet->bus_header[SDPCM_SEQUENCE_OFFSET] = sdpcm_info->tx_seq;
+    sdpcm_info->tx_seq++;
+
+    return WHD_SUCCESS;
+}
+
+/** Allocates the superframe staging buffer and switches the TX path to glom mode
+ *
+ *  Must only be called once the firmware accepted the bus:txglom iovar, since from then on
+ *  every frame sent over F2 has to carry the hardware extension header.
+ *
+ * @return WHD result code
+ */
+whd_result_t whd_sdpcm_tx_glom_enable(whd_driver_t whd_driver)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    uint32_t size;
+
+    if (sdpcm_info->tx_glom_max_frames <= 1)
+    {
+        return WHD_UNSUPPORTED;
+    }
+
+    if (sdpcm_info->tx_glom_buffer == NULL)
+    {
+        size = (uint32_t)sdpcm_info->tx_glom_max_frames *
+               ROUND_UP(WHD_LINK_MTU + SDPCM_HWEXT_HEADER_LEN, SDPCM_TX_GLOM_ALIGN);
+        size = ROUND_UP(size, whd_bus_get_block_size(whd_driver) );
+        if (size > SDPCM_TX_GLOM_MAX_SIZE)
+        {
+            size = SDPCM_TX_GLOM_MAX_SIZE;
+        }
+
+        sdpcm_info->tx_glom_buffer = (uint8_t *)whd_mem_malloc(MAX_BUS_HEADER_SIZE + size);
+        if (sdpcm_info->tx_glom_buffer == NULL)
+        {
+            WPRINT_WHD_ERROR( ("Could not allocate TX glom buffer of %lu bytes\n", (unsigned long)size) );
+            return WHD_MALLOC_FAILURE;
+        }
+        sdpcm_info->tx_glom_buffer_size = (uint16_t)size;
+    }
+
+    sdpcm_info->tx_glom_enabled = WHD_TRUE;
+
+    return WHD_SUCCESS;
+}
+
+/** Builds a superframe out of the queued packets
+ *
+ *  Drains up to tx_glom_max_frames packets, bounded by the available bus credits and the
+ *  superframe buffer size, into the TX glom buffer. Each subframe gets its own frametag,
+ *  hardware extension header and sequence number. The last subframe is flagged and padded
+ *  so that the whole superframe is a multiple of the negotiated F2 block size.
+ *
+ *  The queued packets are released once they have been copied, their bytes are credited to
+ *  the byte queue limits by @ref whd_sdpcm_tx_glom_done once the superframe has been sent.
+ *
+ * @param glom        : Receives the superframe, laid out as a whd_transfer_bytes_packet_t
+ * @param glom_size   : Receives the superframe size, excluding the bus header
+ * @param frame_count : Receives the number of packets in the superframe
+ *
+ * @return WHD result code
+ */
+whd_result_t whd_sdpcm_get_glom_to_send(whd_driver_t whd_driver, uint8_t **glom, uint16_t *glom_size,
+                                        uint8_t *frame_count)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    whd_buffer_t buffer;
+    uint8_t *superframe;
+    uint8_t *subframe = NULL;
+    uint8_t *packet;
+    uint32_t hwext_header[2];
+    uint16_t offset = 0;
+    uint16_t frame_size;
+    uint16_t subframe_size = 0;
+    uint16_t tail_pad = 0;
+    uint16_t block_size;
+    uint16_t glom_limit;
+    uint8_t max_frames;
+    uint8_t count = 0;
+    uint32_t size;
     int ac;
+    whd_result_t result;
+
+    result = whd_sdpcm_check_tx_allowed(whd_driver);
+    if (result != WHD_SUCCESS)
+    {
+        return result;
+    }
 
-    if (sdpcm_info->totpkt_in_q <= 0)
+    whd_mem_memset(sdpcm_info->tx_glom_bytes, 0, sizeof(sdpcm_info->tx_glom_bytes) );
+    max_frames = whd_sdpcm_get_available_credits(whd_driver);
+    if (max_frames > sdpcm_info->tx_glom_max_frames)
+    {
+        max_frames = sdpcm_info->tx_glom_max_frames;
+    }
+
+    superframe = sdpcm_info->tx_glom_buffer + MAX_BUS_HEADER_SIZE;
+
+    /* The block size may have been renegotiated since the buffer was allocated, only fill
+     * whole blocks of it so that the padding of the last one always fits */
+    block_size = whd_bus_get_block_size(whd_driver);
+    glom_limit = (uint16_t)(sdpcm_info->tx_glom_buffer_size - (sdpcm_info->tx_glom_buffer_size % block_size) );
+
+    while (count < max_frames)
+    {
+        /* Leave room for the hardware extension header and the subframe alignment */
+        if (offset + SDPCM_HWEXT_HEADER_LEN + SDPCM_TX_GLOM_ALIGN >= glom_limit)
+        {
+            break;
+        }
+        if (whd_sdpcm_dequeue_packet(whd_driver,
+                                     (uint16_t)(glom_limit - offset - SDPCM_HWEXT_HEADER_LEN -
+                                                SDPCM_TX_GLOM_ALIGN), &buffer) != WHD_SUCCESS)
+        {
+            break;
+        }
+
+        packet = whd_buffer_get_current_piece_data_pointer(whd_driver, buffer);
+        CHECK_PACKET_NULL(packet, WHD_NO_REGISTER_FUNCTION_POINTER);
+        frame_size = (uint16_t)(whd_buffer_get_current_piece_size(whd_driver, buffer) -
+                                sizeof(whd_buffer_header_t) );
+        packet += sizeof(whd_buffer_header_t);
+
+        /* Previous subframe is not the last one, pad it to the subframe alignment */
+        if (subframe != NULL)
+        {
+            offset = (uint16_t)(offset + tail_pad);
+        }
+        subframe = superframe + offset;
+        subframe_size = (uint16_t)(frame_size + SDPCM_HWEXT_HEADER_LEN);
+        tail_pad = (uint16_t)(ROUND_UP(subframe_size, SDPCM_TX_GLOM_ALIGN) - subframe_size);
+
+        hwext_header[0] = htod32( (uint32_t)(subframe_size - SDPCM_FRAMETAG_LEN) );
+        hwext_header[1] = htod32( (uint32_t)tail_pad << SDPCM_HWEXT_TAIL_PAD_SHIFT );
+
+        /* The software header and payload are copied in one go, then the header is patched in the subframe */
+        whd_sdpcm_write_frametag(subframe, subframe_size);
+        whd_mem_memcpy(subframe + SDPCM_FRAMETAG_LEN, hwext_header, SDPCM_HWEXT_HEADER_LEN);
+        whd_mem_memcpy(subframe + SDPCM_FRAMETAG_LEN + SDPCM_HWEXT_HEADER_LEN, packet + SDPCM_FRAMETAG_LEN,
+                       (uint32_t)(frame_size - SDPCM_FRAMETAG_LEN) );
+        subframe[SDPCM_HWEXT_HEADER_LEN + SDPCM_SEQUENCE_OFFSET] = sdpcm_info->tx_seq;
+        subframe[SDPCM_HWEXT_HEADER_LEN + SDPCM_DOFFSET_OFFSET] =
+            (uint8_t)(subframe[SDPCM_HWEXT_HEADER_LEN + SDPCM_DOFFSET_OFFSET] + SDPCM_HWEXT_HEADER_LEN);
+
+        if (whd_sdpcm_tx_packet_ac(whd_driver, buffer, &ac, &size) == WHD_TRUE)
+        {
+            sdpcm_info->tx_glom_bytes[ac] += size;
+        }
+        result = whd_buffer_release(whd_driver, buffer, WHD_NETWORK_TX);
+        if (result != WHD_SUCCESS)
+            WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
+
+        offset = (uint16_t)(offset + subframe_size);
+        sdpcm_info->tx_seq++;
+        count++;
+    }
+
+    if (count == 0)
     {
         return WHD_NO_PACKET_TO_SEND;
     }
 
-    /* Check if we're being flow controlled for Data packet only. */
-    if ( (whd_bus_is_flow_controlled(whd_driver) == WHD_TRUE) && (sdpcm_info->npkt_in_q[MAX_WMM_AC] == 0) )
+    /* Flag the last subframe and pad the superframe up to a whole number of blocks.
+     * The fill limit is a multiple of the block size, so the padding always fits. */
+    tail_pad = (uint16_t)(ROUND_UP(offset, block_size) - offset);
+    hwext_header[0] = htod32( (uint32_t)(subframe_size - SDPCM_FRAMETAG_LEN) | SDPCM_HWEXT_LASTFRM );
+    hwext_header[1] = htod32( (uint32_t)tail_pad << SDPCM_HWEXT_TAIL_PAD_SHIFT );
+    whd_mem_memcpy(subframe + SDPCM_FRAMETAG_LEN, hwext_header, SDPCM_HWEXT_HEADER_LEN);
+    whd_mem_memset(superframe + offset, 0, tail_pad);
+
+    *glom = sdpcm_info->tx_glom_buffer;
+    *glom_size = (uint16_t)(offset + tail_pad);
+    *frame_count = count;
+
+    return WHD_SUCCESS;
+}
+
+/** Records a packet the bus finished sending, or dropped
+ *
+ *  Called from the bus send-done path, in any thread, before the buffer is released. Only the
+ *  counters are touched here: the WHD thread credits the bytes to the byte queue limit of the AC,
+ *  updates the TX stats and schedules the delayed bus release in @ref whd_sdpcm_tx_complete.
+ *
+ * @param buffer : The packet returned by @ref whd_sdpcm_get_packet_to_send
+ * @param result : WHD_SUCCESS if the packet went out on the bus
+ */
+void whd_sdpcm_tx_buffer_done(whd_driver_t whd_driver, whd_buffer_t buffer, whd_result_t result)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    whd_bool_t is_data;
+    uint32_t size = 0;
+    uint8_t held = 0;
+    int ac = 0;
+
+    is_data = whd_sdpcm_tx_packet_ac(whd_driver, buffer, &ac, &size);
+
+    if (cy_rtos_get_semaphore(&sdpcm_info->send_queue_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
     {
-        WHD_STATS_INCREMENT_VARIABLE(whd_driver, flow_control);
-        return WHD_FLOW_CONTROLLED;
+        WPRINT_WHD_ERROR( ("Error manipulating a semaphore, %s failed at %d \n", __func__, __LINE__) );
+        return;
+    }
+    if (result == WHD_SUCCESS)
+    {
+        sdpcm_info->tx_done_frames++;
+    }
+    else
+    {
+        sdpcm_info->tx_failed_frames++;
+    }
+    if (is_data == WHD_TRUE)
+    {
+        sdpcm_info->tx_done_bytes[ac] += size;
+        held = sdpcm_info->tx_held_acs & (uint8_t)(1 << ac);
+    }
+    if (cy_rtos_set_semaphore(&sdpcm_info->send_queue_mutex, WHD_FALSE) != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
     }
 
-    /* Check if we have enough bus data credits spare */
-    if ( ( (uint8_t)(sdpcm_info->tx_max - sdpcm_info->tx_seq) == 0 ) ||
-         ( ( (uint8_t)(sdpcm_info->tx_max - sdpcm_info->tx_seq) & 0x80 ) != 0 ) )
+    if (held != 0)
     {
-        WHD_STATS_INCREMENT_VARIABLE(whd_driver, no_credit);
-        return WHD_NO_CREDITS;
+        /* Senders are held off, the WHD thread has to look at the limit */
+        whd_thread_notify(whd_driver);
     }
+}
+
+/** Credits the packets of the superframe from @ref whd_sdpcm_get_glom_to_send once it was sent
+ */
+void whd_sdpcm_tx_glom_done(whd_driver_t whd_driver)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    int ac;
 
-    /* There is a packet waiting to be sent - send it then fix up queue and release packet */
     if (cy_rtos_get_semaphore(&sdpcm_info->send_queue_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
     {
-        /* Could not obtain mutex, push back the flow control semaphore */
         WPRINT_WHD_ERROR( ("Error manipulating a semaphore, %s failed at %d \n", __func__, __LINE__) );
-        return WHD_SEMAPHORE_ERROR;
+        return;
+    }
+    for (ac = 0; ac < MAX_WMM_AC; ac++)
+    {
+        sdpcm_info->tx_done_bytes[ac] += sdpcm_info->tx_glom_bytes[ac];
+        sdpcm_info->tx_glom_bytes[ac] = 0;
+    }
+    if (cy_rtos_set_semaphore(&sdpcm_info->send_queue_mutex, WHD_FALSE) != WHD_SUCCESS)
+    {
+        WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
     }
+}
+
+/** Folds the packets the bus finished with into the byte queue limits and the TX stats
+ *
+ *  Tells the network stack it may resume sending once every AC queue that went over its
+ *  byte limit has drained below it. Must only be called from the WHD thread.
+ */
+void whd_sdpcm_tx_complete(whd_driver_t whd_driver)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    whd_bool_t resume = WHD_FALSE;
+    uint32_t done_frames;
+    uint32_t failed_frames;
+    uint8_t mask;
+    int ac;
 
-    for (ac = MAX_WMM_AC; ac >= 0; ac--)
+    /* Read unlocked as a hint, packets finished meanwhile are picked up on the next pass */
+    if ( (sdpcm_info->tx_done_frames == 0) && (sdpcm_info->tx_failed_frames == 0) )
     {
-        if (sdpcm_info->send_queue_head[ac] != NULL)
+        for (ac = 0; ac < MAX_WMM_AC; ac++)
         {
-            break;
+            if (sdpcm_info->tx_done_bytes[ac] != 0)
+            {
+                break;
+            }
+        }
+        if (ac == MAX_WMM_AC)
+        {
+            return;
         }
     }
-    if (ac < 0)
+
+    if (cy_rtos_get_semaphore(&sdpcm_info->send_queue_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
     {
-        WPRINT_WHD_ERROR( ("NO pkt available in queue, %s failed at %d\n", __func__, __LINE__) );
-        return WHD_NO_PACKET_TO_SEND;
+        WPRINT_WHD_ERROR( ("Error manipulating a semaphore, %s failed at %d \n", __func__, __LINE__) );
+        return;
     }
-    /* Pop the head off and set the new send_queue head */
-    *buffer = sdpcm_info->send_queue_head[ac];
-    sdpcm_info->send_queue_head[ac] = whd_sdpcm_get_next_buffer_in_queue(whd_driver, *buffer);
-    if (sdpcm_info->send_queue_head[ac] == NULL)
+    for (ac = 0; ac < MAX_WMM_AC; ac++)
     {
-        sdpcm_info->send_queue_tail[ac] = NULL;
+        if (sdpcm_info->tx_done_bytes[ac] == 0)
+        {
+            continue;
+        }
+        whd_bql_completed(&sdpcm_info->tx_bql[ac], sdpcm_info->tx_done_bytes[ac]);
+        sdpcm_info->tx_done_bytes[ac] = 0;
+
+        mask = (uint8_t)(1 << ac);
+        if ( ( (sdpcm_info->tx_held_acs & mask) != 0 ) &&
+             (whd_bql_over_limit(&sdpcm_info->tx_bql[ac]) == WHD_FALSE) )
+        {
+            sdpcm_info->tx_held_acs &= (uint8_t)~mask;
+            if (sdpcm_info->tx_held_acs == 0)
+            {
+                resume = WHD_TRUE;
+            }
+        }
     }
-    sdpcm_info->npkt_in_q[ac]--;
-    sdpcm_info->totpkt_in_q--;
-    result = cy_rtos_set_semaphore(&sdpcm_info->send_queue_mutex, WHD_FALSE);
-    if (result != WHD_SUCCESS)
+    done_frames = sdpcm_info->tx_done_frames;
+    failed_frames = sdpcm_info->tx_failed_frames;
+    sdpcm_info->tx_done_frames = 0;
+    sdpcm_info->tx_failed_frames = 0;
+    if (cy_rtos_set_semaphore(&sdpcm_info->send_queue_mutex, WHD_FALSE) != WHD_SUCCESS)
     {
         WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
     }
 
-    /* Set the sequence number */
-    packet = (bus_common_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer);
-    CHECK_PACKET_NULL(packet, WHD_NO_REGISTER_FUNCTION_POINTER);
-    whd_mem_memcpy(&sdpcm_header, packet->bus_header, BUS_HEADER_LEN);
-    sdpcm_header.sw_header.sequence = sdpcm_info->tx_seq;
-    whd_mem_memcpy(packet->bus_header, &sdpcm_header, BUS_HEADER_LEN);
-    sdpcm_info->tx_seq++;
+    WHD_STATS_ADD_VARIABLE(whd_driver, tx_total, done_frames);
+    WHD_STATS_ADD_VARIABLE(whd_driver, tx_fail, failed_frames);
+    if (done_frames != 0)
+    {
+        DELAYED_BUS_RELEASE_SCHEDULE(whd_driver, WHD_TRUE);
+    }
 
-    return WHD_SUCCESS;
+    if (resume == WHD_TRUE)
+    {
+        whd_network_tx_resume(whd_driver);
+    }
+}
+
+/** Checks whether an AC queue went over its byte limit and has not drained yet
+ *
+ *  Read without the queue mutex, a stale answer only delays the network stack by one packet.
+ *
+ * @return WHD_TRUE if the network stack should hold off sending
+ */
+whd_bool_t whd_sdpcm_tx_flow_controlled(whd_driver_t whd_driver)
+{
+    return (whd_driver->sdpcm_info.tx_held_acs != 0) ? WHD_TRUE : WHD_FALSE;
 }
 
 /** Returns the number of bus credits available
@@ -562,6 +947,24 @@ uint8_t whd_sdpcm_get_available_credits(whd_driver_t whd_driver)
     return (uint8_t)(tx_max - tx_seq);
 }
 
+/** Sets the padding between the SDPCM and CDC headers of a newly allocated control packet
+ *
+ *  Kept in the SDPCM data offset field until the header is written, the firmware skips the padding.
+ *
+ *  @param packet : The control packet, before it is passed to whd_send_to_bus()
+ *  @param pad    : Bytes of padding before the CDC header
+ */
+void whd_sdpcm_set_control_pad(bus_common_header_t *packet, uint8_t pad)
+{
+    packet->bus_header[SDPCM_DOFFSET_OFFSET] = (uint8_t)(sizeof(sdpcm_header_t) + pad);
+}
+
+/** Gets the padding set with whd_sdpcm_set_control_pad() */
+uint8_t whd_sdpcm_get_control_pad(const bus_common_header_t *packet)
+{
+    return (uint8_t)(packet->bus_header[SDPCM_DOFFSET_OFFSET] - sizeof(sdpcm_header_t) );
+}
+
 /** Writes SDPCM headers and sends packet to WHD Thread
  *
  *  Prepends the given packet with a new SDPCM header,
@@ -576,15 +979,149 @@ uint8_t whd_sdpcm_get_available_credits(whd_driver_t whd_driver)
  */
 whd_result_t whd_send_to_bus(whd_driver_t whd_driver, whd_buffer_t buffer,
                              sdpcm_header_type_t header_type, uint8_t prio)
+{
+    whd_result_t result;
+    int ac;
+
+    result = whd_sdpcm_prepare_to_queue(whd_driver, buffer, header_type, prio, &ac);
+    if (result != WHD_SUCCESS)
+    {
+        return result;
+    }
+
+    result = whd_sdpcm_push_to_queue(whd_driver, ac, header_type, buffer, buffer, 1);
+
+    /* A full queue also needs the WHD thread to drain it */
+    whd_thread_notify(whd_driver);
+
+    return result;
+}
+
+/** Writes SDPCM headers and sends a batch of packets to WHD Thread
+ *
+ *  Same as @ref whd_send_to_bus for every packet, but the packets of each AC are pushed onto
+ *  the send queue at once and the WHD thread is woken up once for the whole batch.
+ *
+ *  @param buffers      : The handles of the packet buffers to send
+ *  @param prios        : The 802.1p priority of each packet
+ *  @param count        : Number of packets
+ *  @param header_type  : DATA_HEADER, ASYNCEVENT_HEADER or CONTROL_HEADER - indicating what type of SDPCM packet this is.
+ *
+ *  @return WHD_SUCCESS or the first error, packets that could not be queued are released
+ */
+whd_result_t whd_send_to_bus_batch(whd_driver_t whd_driver, const whd_buffer_t *buffers, const uint8_t *prios,
+                                   uint32_t count, sdpcm_header_type_t header_type)
+{
+    whd_buffer_t chain_head[MAX_WMM_AC + 1] = { NULL };
+    whd_buffer_t chain_tail[MAX_WMM_AC + 1] = { NULL };
+    uint32_t chain_count[MAX_WMM_AC + 1] = { 0 };
+    whd_result_t first_error = WHD_SUCCESS;
+    whd_result_t result;
+    uint32_t i;
+    int ac;
+
+    for (i = 0; i < count; i++)
+    {
+        result = whd_sdpcm_prepare_to_queue(whd_driver, buffers[i], header_type, prios[i], &ac);
+        if (result != WHD_SUCCESS)
+        {
+            /* The caller cannot tell which packets were taken, so every packet is consumed */
+            if (whd_buffer_release(whd_driver, buffers[i], WHD_NETWORK_TX) != WHD_SUCCESS)
+            {
+                WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
+            }
+            if (first_error == WHD_SUCCESS)
+            {
+                first_error = result;
+            }
+            continue;
+        }
+
+        /* Chain newest first, the order in which the send queue takes pushed packets */
+        if (chain_head[ac] == NULL)
+        {
+            chain_tail[ac] = buffers[i];
+        }
+        else
+        {
+            whd_sdpcm_set_next_buffer_in_queue(whd_driver, chain_head[ac], buffers[i]);
+        }
+        chain_head[ac] = buffers[i];
+        chain_count[ac]++;
+    }
+
+    for (ac = 0; ac <= MAX_WMM_AC; ac++)
+    {
+        if (chain_head[ac] != NULL)
+        {
+            result = whd_sdpcm_push_to_queue(whd_driver, ac, header_type, chain_head[ac], chain_tail[ac],
+                                             chain_count[ac]);
+            if ( (result != WHD_SUCCESS) && (first_error == WHD_SUCCESS) )
+            {
+                first_error = result;
+            }
+        }
+    }
+
+    whd_thread_notify(whd_driver);
+
+    return first_error;
+}
+
+/******************************************************
+*             Static Functions
+******************************************************/
+
+/** Finds the AC queue whose byte queue limit a packet was accounted to
+ *
+ *  @param buffer       : A packet queued by @ref whd_sdpcm_prepare_to_queue, with its SDPCM and BDC headers
+ *  @param ac           : Receives the AC queue
+ *  @param size         : Receives the bytes accounted
+ *
+ *  @return WHD_TRUE for a data packet, WHD_FALSE for control and event packets which have no byte limit
+ */
+static whd_bool_t whd_sdpcm_tx_packet_ac(whd_driver_t whd_driver, whd_buffer_t buffer, int *ac, uint32_t *size)
+{
+    data_header_t *packet = (data_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, buffer);
+    uint8_t prio;
+
+    if ( (packet == NULL) || ( (packet->common.bus_header[SDPCM_CHANNEL_OFFSET] & 0x0f) != DATA_HEADER ) )
+    {
+        return WHD_FALSE;
+    }
+
+    /* whd_send_to_bus() is given the BDC priority */
+    prio = packet->bdc_header.priority;
+    if (prio > MAX_8021P_PRIO)
+    {
+        prio = MAX_8021P_PRIO;
+    }
+    *ac = prio_to_ac[prio];
+    *size = whd_sdpcm_read16(packet->common.bus_header);
+
+    return (*ac < MAX_WMM_AC) ? WHD_TRUE : WHD_FALSE;
+}
+
+/** Writes the SDPCM header of a packet and admits it to its AC queue
+ *
+ *  @param buffer       : The handle of the packet buffer to send
+ *  @param header_type  : DATA_HEADER, ASYNCEVENT_HEADER or CONTROL_HEADER
+ *  @param prio         : 802.1p priority of the packet
+ *  @param ac           : Receives the AC queue to push the packet onto
+ *
+ *  @return WHD result code
+ */
+static whd_result_t whd_sdpcm_prepare_to_queue(whd_driver_t whd_driver, whd_buffer_t buffer,
+                                               sdpcm_header_type_t header_type, uint8_t prio, int *ac)
 {
     uint16_t size;
     uint8_t *data = NULL;
     bus_common_header_t *packet =
         (bus_common_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, buffer);
-    sdpcm_header_t sdpcm_header;
-    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
-    whd_result_t result;
-    int ac;
+    uint8_t *header;
+    cy_time_t now;
+    uint32_t enqueue_time;
+    uint8_t doffset;
 
 #ifdef CYCFG_ULP_SUPPORT_ENABLED
     if(!(whd_ensure_wlan_bus_not_in_deep_sleep(whd_driver)))
@@ -599,80 +1136,337 @@ whd_result_t whd_send_to_bus(whd_driver_t whd_driver, whd_buffer_t buffer,
 
     size = (uint16_t)(size - (uint16_t)sizeof(whd_buffer_header_t) );
 
-    /* Prepare the SDPCM header */
-    whd_mem_memset( (uint8_t *)&sdpcm_header, 0, sizeof(sdpcm_header_t) );
-    sdpcm_header.sw_header.channel_and_flags = (uint8_t)header_type;
-    sdpcm_header.sw_header.header_length =
-        (header_type == DATA_HEADER) ? sizeof(sdpcm_header_t) + 2 : sizeof(sdpcm_header_t);
-    sdpcm_header.sw_header.sequence = 0; /* Note: The real sequence will be written later */
-    sdpcm_header.frametag[0] = size;
-    sdpcm_header.frametag[1] = (uint16_t) ~size;
-
-    whd_mem_memcpy(packet->bus_header, &sdpcm_header, BUS_HEADER_LEN);
+    /* Write the SDPCM header in place, a control packet keeps the data offset it was allocated with */
+    header = packet->bus_header;
+    if (header_type == CONTROL_HEADER)
+    {
+        doffset = header[SDPCM_DOFFSET_OFFSET];
+    }
+    else
+    {
+        doffset = (header_type == DATA_HEADER) ? sizeof(sdpcm_header_t) + 2 : sizeof(sdpcm_header_t);
+    }
+    whd_sdpcm_write_frametag(header, size);
+    whd_mem_memset(&header[SDPCM_FRAMETAG_LEN], 0, sizeof(sdpcm_sw_header_t) );
+    header[SDPCM_CHANNEL_OFFSET] = (uint8_t)header_type;
+    header[SDPCM_DOFFSET_OFFSET] = doffset;
+    /* Note: The real sequence will be written later */
     data = whd_buffer_get_current_piece_data_pointer(whd_driver, buffer);
     CHECK_PACKET_NULL(data, WHD_NO_REGISTER_FUNCTION_POINTER);
     add_sdpcm_log_entry(LOG_TX, (header_type == DATA_HEADER) ? DATA : (header_type == CONTROL_HEADER) ? IOCTL : EVENT,
                         whd_buffer_get_current_piece_size(whd_driver, buffer),
                         (char *)data);
 
-    /* Add the length of the SDPCM header and pass "down" */
+    /* The input priority should not higher than MAX_8021P_PRIO(7) */
+    if (prio > MAX_8021P_PRIO)
+    {
+        prio = MAX_8021P_PRIO;
+    }
+    *ac = prio_to_ac[prio];
+
+    /* Stamp the enqueue time for the latency stats. The bus header space is
+     * not used before the bus layer prepends its header at transfer time. */
+    (void)cy_rtos_get_time(&now);
+    enqueue_time = (uint32_t)now;
+    whd_mem_memcpy(packet->buffer_header.bus_header, &enqueue_time, sizeof(enqueue_time) );
+
+    return WHD_SUCCESS;
+}
+
+/** Pushes a chain of packets onto the producer side of an AC queue, the WHD thread restores FIFO order
+ *
+ *  Data packets that do not fit in the AC queue any more are dropped, the newest ones first.
+ *
+ *  @param ac           : AC queue
+ *  @param header_type  : DATA_HEADER, ASYNCEVENT_HEADER or CONTROL_HEADER
+ *  @param newest       : Newest packet of the chain, linked to the older ones
+ *  @param oldest       : Oldest packet of the chain
+ *  @param count        : Number of packets in the chain
+ *
+ *  @return WHD_SUCCESS, or WHD_BUFFER_ALLOC_FAIL if packets were dropped. Dropped packets are released.
+ */
+static whd_result_t whd_sdpcm_push_to_queue(whd_driver_t whd_driver, int ac, sdpcm_header_type_t header_type,
+                                            whd_buffer_t newest, whd_buffer_t oldest, uint32_t count)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    whd_buffer_t dropped = newest;
+    whd_buffer_t buffer;
+    whd_buffer_t next;
+    uint32_t ndropped = 0;
+    uint32_t queued;
+    uint32_t size;
+    uint32_t i;
+    int data_ac;
+    whd_result_t result = WHD_SUCCESS;
+
     if (cy_rtos_get_semaphore(&sdpcm_info->send_queue_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
     {
         /* Could not obtain mutex */
         /* Fatal error */
-        result = whd_buffer_release(whd_driver, buffer, WHD_NETWORK_TX);
-        if (result != WHD_SUCCESS)
-            WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
-        return WHD_SEMAPHORE_ERROR;
+        ndropped = count;
+        result = WHD_SEMAPHORE_ERROR;
     }
-
-    /* The input priority should not higher than MAX_8021P_PRIO(7) */
-    if (prio > MAX_8021P_PRIO)
+    else
     {
-        prio = MAX_8021P_PRIO;
+        queued = sdpcm_info->npkt_pushed[ac] - sdpcm_info->npkt_sent[ac];
+        while ( (header_type == DATA_HEADER) && (count > 0) && (queued + count > AC_QUEUE_SIZE + 1) )
+        {
+            newest = whd_sdpcm_get_next_buffer_in_queue(whd_driver, newest);
+            count--;
+            ndropped++;
+            result = WHD_BUFFER_ALLOC_FAIL;
+        }
+
+        if (count > 0)
+        {
+            /* Account the bytes before the packets become visible to the WHD thread. They are queued
+             * either way, whd_network_tx_flow_controlled() tells the stack to hold off until the AC drains */
+            for (buffer = newest, i = 0; i < count; i++)
+            {
+                if ( (whd_sdpcm_tx_packet_ac(whd_driver, buffer, &data_ac, &size) == WHD_TRUE) &&
+                     (whd_bql_queued(&sdpcm_info->tx_bql[data_ac], size) == WHD_TRUE) )
+                {
+                    sdpcm_info->tx_held_acs |= (uint8_t)(1 << data_ac);
+                    WHD_STATS_INCREMENT_VARIABLE(whd_driver, tx_flow_controlled);
+                }
+                buffer = whd_sdpcm_get_next_buffer_in_queue(whd_driver, buffer);
+            }
+
+            whd_sdpcm_set_next_buffer_in_queue(whd_driver, sdpcm_info->send_queue_in[ac], oldest);
+            sdpcm_info->send_queue_in[ac] = newest;
+            sdpcm_info->npkt_pushed[ac] += count;
+            sdpcm_info->totpkt_pushed += count;
+        }
+
+        if (cy_rtos_set_semaphore(&sdpcm_info->send_queue_mutex, WHD_FALSE) != WHD_SUCCESS)
+        {
+            WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
+        }
     }
-    ac = prio_to_ac[prio];
 
-    if ( (header_type == DATA_HEADER) && (sdpcm_info->npkt_in_q[ac] > AC_QUEUE_SIZE) )
+    while (ndropped-- > 0)
     {
-        result = whd_buffer_release(whd_driver, buffer, WHD_NETWORK_TX);
-        if (result != WHD_SUCCESS)
+        next = whd_sdpcm_get_next_buffer_in_queue(whd_driver, dropped);
+        if (whd_buffer_release(whd_driver, dropped, WHD_NETWORK_TX) != WHD_SUCCESS)
         {
             WPRINT_WHD_ERROR( ("buffer release failed in %s at %d \n", __func__, __LINE__) );
         }
-        result = cy_rtos_set_semaphore(&sdpcm_info->send_queue_mutex, WHD_FALSE);
-        if (result != WHD_SUCCESS)
+        dropped = next;
+    }
+
+    return result;
+}
+
+/** Checks whether the queued packets may be sent now
+ *
+ * @return WHD_SUCCESS if a packet may be sent, otherwise the reason why not
+ */
+static whd_result_t whd_sdpcm_check_tx_allowed(whd_driver_t whd_driver)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+
+    if (sdpcm_info->totpkt_pushed == sdpcm_info->totpkt_sent)
+    {
+        return WHD_NO_PACKET_TO_SEND;
+    }
+
+    /* Check if we're being flow controlled for Data packet only. */
+    if ( (whd_bus_is_flow_controlled(whd_driver) == WHD_TRUE) &&
+         (sdpcm_info->npkt_pushed[MAX_WMM_AC] == sdpcm_info->npkt_sent[MAX_WMM_AC]) )
+    {
+        WHD_STATS_INCREMENT_VARIABLE(whd_driver, flow_control);
+        return WHD_FLOW_CONTROLLED;
+    }
+
+    /* Check if we have enough bus data credits spare */
+    if ( ( (uint8_t)(sdpcm_info->tx_max - sdpcm_info->tx_seq) == 0 ) ||
+         ( ( (uint8_t)(sdpcm_info->tx_max - sdpcm_info->tx_seq) & 0x80 ) != 0 ) )
+    {
+        WHD_STATS_INCREMENT_VARIABLE(whd_driver, no_credit);
+        return WHD_NO_CREDITS;
+    }
+
+    return WHD_SUCCESS;
+}
+
+/** Pops the head of the highest priority non-empty queue
+ *
+ *  While flow controlled only the control queue is served.
+ *
+ * @param max_size : Largest packet (excluding the buffer header) the caller can take
+ * @param buffer   : Receives the dequeued packet
+ *
+ * @return WHD_SUCCESS, or WHD_NO_PACKET_TO_SEND if nothing (that fits) is queued
+ */
+static whd_result_t whd_sdpcm_dequeue_packet(whd_driver_t whd_driver, uint16_t max_size, whd_buffer_t *buffer)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    bus_common_header_t *packet;
+    uint32_t size;
+    uint32_t latency;
+    uint32_t enqueue_time;
+    cy_time_t now;
+    int ac;
+
+    /* The control queue always goes first, data ACs only when not flow controlled */
+    if (whd_sdpcm_peek_queue(whd_driver, MAX_WMM_AC) != NULL)
+    {
+        ac = MAX_WMM_AC;
+    }
+    else if (whd_bus_is_flow_controlled(whd_driver) == WHD_TRUE)
+    {
+        return WHD_NO_PACKET_TO_SEND;
+    }
+    else
+    {
+        ac = sdpcm_info->tx_sched->select(whd_driver);
+        if (ac < 0)
         {
-            WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
+            return WHD_NO_PACKET_TO_SEND;
         }
-        whd_thread_notify(whd_driver);
-        return WHD_BUFFER_ALLOC_FAIL;
     }
 
-    whd_sdpcm_set_next_buffer_in_queue(whd_driver, NULL, buffer);
-    if (sdpcm_info->send_queue_tail[ac] != NULL)
+    size = whd_buffer_get_current_piece_size(whd_driver, sdpcm_info->send_queue_head[ac]) -
+           sizeof(whd_buffer_header_t);
+    if (size > max_size)
     {
-        whd_sdpcm_set_next_buffer_in_queue(whd_driver, buffer, sdpcm_info->send_queue_tail[ac]);
+        return WHD_NO_PACKET_TO_SEND;
     }
-    sdpcm_info->send_queue_tail[ac] = buffer;
-    if (sdpcm_info->send_queue_head[ac] == NULL)
+
+    /* Pop the head off and set the new send_queue head */
+    *buffer = sdpcm_info->send_queue_head[ac];
+    sdpcm_info->send_queue_head[ac] = whd_sdpcm_get_next_buffer_in_queue(whd_driver, *buffer);
+    sdpcm_info->npkt_sent[ac]++;
+    sdpcm_info->totpkt_sent++;
+
+    if ( (ac != MAX_WMM_AC) && (sdpcm_info->tx_sched->charge != NULL) )
     {
-        sdpcm_info->send_queue_head[ac] = buffer;
+        sdpcm_info->tx_sched->charge(whd_driver, ac, size);
     }
-    sdpcm_info->npkt_in_q[ac]++;
-    sdpcm_info->totpkt_in_q++;
-    result = cy_rtos_set_semaphore(&sdpcm_info->send_queue_mutex, WHD_FALSE);
-    if (result != WHD_SUCCESS)
-        WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
 
-    whd_thread_notify(whd_driver);
+    packet = (bus_common_header_t *)whd_buffer_get_current_piece_data_pointer(whd_driver, *buffer);
+    CHECK_PACKET_NULL(packet, WHD_NO_REGISTER_FUNCTION_POINTER);
+    whd_mem_memcpy(&enqueue_time, packet->buffer_header.bus_header, sizeof(enqueue_time) );
+    (void)cy_rtos_get_time(&now);
+    latency = (uint32_t)now - enqueue_time;
+    WHD_STATS_INCREMENT_VARIABLE(whd_driver, tx_ac_dequeue[ac]);
+    WHD_STATS_ADD_VARIABLE(whd_driver, tx_ac_latency_total[ac], latency);
+    if (latency > whd_driver->whd_stats.tx_ac_latency_max[ac])
+    {
+        whd_driver->whd_stats.tx_ac_latency_max[ac] = latency;
+    }
 
     return WHD_SUCCESS;
 }
 
-/******************************************************
-*             Static Functions
-******************************************************/
+/** Strict priority: the highest non-empty data AC is served */
+static int whd_sdpcm_tx_sched_strict_select(whd_driver_t whd_driver)
+{
+    int ac;
+
+    for (ac = MAX_WMM_AC - 1; ac >= 0; ac--)
+    {
+        if (whd_sdpcm_peek_queue(whd_driver, ac) != NULL)
+        {
+            break;
+        }
+    }
+
+    return ac;
+}
+
+/** Deficit round robin by bytes
+ *
+ *  The AC being served keeps sending while its head packet fits in its deficit. Moving on to
+ *  the next AC grants that AC its quantum, and an AC found empty forfeits its deficit.
+ */
+static int whd_sdpcm_tx_sched_drr_select(whd_driver_t whd_driver)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    whd_buffer_t head;
+    whd_bool_t backlogged;
+    uint32_t size;
+    int ac;
+    int i;
+
+    do
+    {
+        backlogged = WHD_FALSE;
+        for (i = 0; i < MAX_WMM_AC; i++)
+        {
+            ac = sdpcm_info->tx_sched_ac;
+            head = whd_sdpcm_peek_queue(whd_driver, ac);
+            if (head != NULL)
+            {
+                backlogged = WHD_TRUE;
+                size = whd_buffer_get_current_piece_size(whd_driver, head) - sizeof(whd_buffer_header_t);
+                if (size <= sdpcm_info->tx_sched_deficit[ac])
+                {
+                    return ac;
+                }
+            }
+            else
+            {
+                sdpcm_info->tx_sched_deficit[ac] = 0;
+            }
+
+            ac = (ac + 1) % MAX_WMM_AC;
+            sdpcm_info->tx_sched_ac = (uint8_t)ac;
+            sdpcm_info->tx_sched_deficit[ac] += sdpcm_info->tx_sched_quantum[ac];
+        }
+    } while (backlogged == WHD_TRUE);
+
+    return -1;
+}
+
+static void whd_sdpcm_tx_sched_drr_charge(whd_driver_t whd_driver, int ac, uint32_t size)
+{
+    whd_driver->sdpcm_info.tx_sched_deficit[ac] -= size;
+}
+
+/** Returns the oldest packet of an AC queue without removing it
+ *
+ *  Only called from the WHD thread. Once the consumer side runs empty, everything pushed
+ *  since is taken over under the queue mutex in one go and reversed back into FIFO order.
+ *
+ * @param ac : The AC queue to look at
+ *
+ * @return The oldest packet in the queue, or NULL if the queue is empty
+ */
+static whd_buffer_t whd_sdpcm_peek_queue(whd_driver_t whd_driver, int ac)
+{
+    whd_sdpcm_info_t *sdpcm_info = &whd_driver->sdpcm_info;
+    whd_buffer_t buffer;
+    whd_buffer_t next;
+    whd_buffer_t head = NULL;
+
+    /* The pushed count is only read here, producers bump it together with send_queue_in under the mutex */
+    if ( (sdpcm_info->send_queue_head[ac] == NULL) && (sdpcm_info->npkt_pushed[ac] != sdpcm_info->npkt_sent[ac]) )
+    {
+        if (cy_rtos_get_semaphore(&sdpcm_info->send_queue_mutex, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE) != WHD_SUCCESS)
+        {
+            WPRINT_WHD_ERROR( ("Error manipulating a semaphore, %s failed at %d \n", __func__, __LINE__) );
+            return NULL;
+        }
+        buffer = sdpcm_info->send_queue_in[ac];
+        sdpcm_info->send_queue_in[ac] = NULL;
+        if (cy_rtos_set_semaphore(&sdpcm_info->send_queue_mutex, WHD_FALSE) != WHD_SUCCESS)
+        {
+            WPRINT_WHD_ERROR( ("Error setting semaphore in %s at %d \n", __func__, __LINE__) );
+        }
+
+        while (buffer != NULL)
+        {
+            next = whd_sdpcm_get_next_buffer_in_queue(whd_driver, buffer);
+            whd_sdpcm_set_next_buffer_in_queue(whd_driver, head, buffer);
+            head = buffer;
+            buffer = next;
+        }
+        sdpcm_info->send_queue_head[ac] = head;
+    }
+
+    return sdpcm_info->send_queue_head[ac];
+}
 
 static whd_buffer_t whd_sdpcm_get_next_buffer_in_queue(whd_driver_t whd_driver, whd_buffer_t buffer)
 {
@@ -39,6 +39,7 @@
 #include "bus_protocols/whd_bus_protocol_interface.h"
 #include "cyabs_rtos.h"
 #include "whd_int.h"
+#include "whd_proto.h"
 #include "whd_chip.h"
 #include "whd_poll.h"
 #ifndef PROTO_MSGBUF
@@ -55,6 +56,10 @@
 *             Static Function Prototypes
 ******************************************************/
 static void whd_thread_func(cy_thread_arg_t thread_input);
+#ifndef PROTO_MSGBUF
+static int8_t whd_thread_send_one_glom(whd_driver_t whd_driver);
+static void whd_thread_rx_budget_update(whd_thread_info_t *thread_info, uint16_t rx_cnt, whd_bool_t exhausted);
+#endif /* PROTO_MSGBUF */
 
 /******************************************************
 *             Global Functions
@@ -65,6 +70,14 @@ void whd_thread_info_init(whd_driver_t whd_driver, whd_init_config_t *whd_init_c
     whd_driver->thread_info.thread_stack_start = whd_init_config->thread_stack_start;
     whd_driver->thread_info.thread_stack_size = whd_init_config->thread_stack_size;
     whd_driver->thread_info.thread_priority = (cy_thread_priority_t)whd_init_config->thread_priority;
+    whd_driver->thread_info.max_sleep_ms = CY_RTOS_NEVER_TIMEOUT;
+#ifndef PROTO_MSGBUF
+    if (whd_init_config->rx_poll_budget != 0)
+    {
+        whd_driver->thread_info.rx_budget_max = MAX_OF(whd_init_config->rx_poll_budget, WHD_THREAD_RX_BUDGET_MIN);
+        whd_driver->thread_info.rx_budget = MIN_OF(WHD_THREAD_RX_BOUND, whd_driver->thread_info.rx_budget_max);
+    }
+#endif /* PROTO_MSGBUF */
 }
 
 /** Initialises the WHD Thread
@@ -119,6 +132,8 @@ whd_result_t whd_thread_init(whd_driver_t whd_driver)
  *
  * Checks the queue to determine if there is any packets waiting
  * to be sent. If there are, then it sends the first one.
+ * When TX glomming is enabled, the waiting packets are sent
+ * together as one superframe instead.
  *
  * This function is normally used by the WHD Thread, but can be
  * called periodically by systems which have no RTOS to ensure
@@ -132,6 +147,11 @@ int8_t whd_thread_send_one_packet(whd_driver_t whd_driver)
     whd_result_t result;
     whd_buffer_t tmp_buf_hnd = NULL;
 
+    if (whd_driver->sdpcm_info.tx_glom_enabled == WHD_TRUE)
+    {
+        return whd_thread_send_one_glom(whd_driver);
+    }
+
     if (whd_sdpcm_get_packet_to_send(whd_driver, &tmp_buf_hnd) != WHD_SUCCESS)
     {
         /* Failed to get a packet */
@@ -143,18 +163,63 @@ int8_t whd_thread_send_one_packet(whd_driver_t whd_driver)
     if (result != WHD_SUCCESS)
     {
         whd_assert("Could not bring bus back up", 0 != 0);
+        whd_sdpcm_tx_buffer_done(whd_driver, tmp_buf_hnd, result);
         CHECK_RETURN(whd_buffer_release(whd_driver, tmp_buf_hnd, WHD_NETWORK_TX) );
         return 0;
     }
 
+    /* The bus reports the outcome through whd_sdpcm_tx_buffer_done(), which also counts it */
     WPRINT_WHD_DATA_LOG( ("Wcd:> Sending pkt 0x%08lX\n", (unsigned long)tmp_buf_hnd) );
     if (whd_bus_send_buffer(whd_driver, tmp_buf_hnd) != WHD_SUCCESS)
     {
-        WHD_STATS_INCREMENT_VARIABLE(whd_driver, tx_fail);
         return 0;
     }
 
-    WHD_STATS_INCREMENT_VARIABLE(whd_driver, tx_total);
+    return (int8_t)1;
+}
+
+/** Sends the queued packets as one SDPCM superframe
+ *
+ * @return    1 : superframe was sent
+ *            0 : nothing sent
+ */
+static int8_t whd_thread_send_one_glom(whd_driver_t whd_driver)
+{
+    whd_result_t result;
+    uint8_t *glom = NULL;
+    uint16_t glom_size = 0;
+    uint8_t frame_count = 0;
+
+    if (whd_sdpcm_get_glom_to_send(whd_driver, &glom, &glom_size, &frame_count) != WHD_SUCCESS)
+    {
+        /* Failed to get a packet */
+        return 0;
+    }
+
+    /* Ensure the wlan backplane bus is up */
+    result = whd_ensure_wlan_bus_is_up(whd_driver);
+    if (result != WHD_SUCCESS)
+    {
+        whd_assert("Could not bring bus back up", 0 != 0);
+        whd_sdpcm_tx_glom_done(whd_driver);
+        WHD_STATS_ADD_VARIABLE(whd_driver, tx_fail, frame_count);
+        return 0;
+    }
+
+    WPRINT_WHD_DATA_LOG( ("Wcd:> Sending glom of %u pkts, %u bytes\n", frame_count, glom_size) );
+    result = whd_bus_transfer_bytes(whd_driver, BUS_WRITE, WLAN_FUNCTION, 0, glom_size,
+                                    (whd_transfer_bytes_packet_t *)glom);
+    whd_sdpcm_tx_glom_done(whd_driver);
+    if (result != WHD_SUCCESS)
+    {
+        WHD_STATS_ADD_VARIABLE(whd_driver, tx_fail, frame_count);
+        return 0;
+    }
+    DELAYED_BUS_RELEASE_SCHEDULE(whd_driver, WHD_TRUE);
+
+    WHD_STATS_ADD_VARIABLE(whd_driver, tx_total, frame_count);
+    WHD_STATS_INCREMENT_VARIABLE(whd_driver, tx_glom);
+    WHD_STATS_ADD_VARIABLE(whd_driver, tx_glom_frames, frame_count);
 
     return (int8_t)1;
 }
@@ -346,14 +411,33 @@ void whd_thread_notify(whd_driver_t whd_driver)
  *
  */
 #ifndef PROTO_MSGBUF
+/** Tunes the RX poll budget to twice the average number of packets received per poll round,
+ *  doubling it straight away when a round used up its budget
+ */
+static void whd_thread_rx_budget_update(whd_thread_info_t *thread_info, uint16_t rx_cnt, whd_bool_t exhausted)
+{
+    uint32_t budget;
+
+    thread_info->rx_rate_avg = thread_info->rx_rate_avg - (thread_info->rx_rate_avg >> WHD_THREAD_RX_RATE_SHIFT) +
+                               rx_cnt;
+    budget = thread_info->rx_rate_avg >> (WHD_THREAD_RX_RATE_SHIFT - 1);
+    if (exhausted == WHD_TRUE)
+    {
+        budget = MAX_OF(budget, (uint32_t)thread_info->rx_budget * 2);
+    }
+    budget = MAX_OF(budget, WHD_THREAD_RX_BUDGET_MIN);
+    thread_info->rx_budget = (uint16_t)MIN_OF(budget, thread_info->rx_budget_max);
+}
+
 static void whd_thread_func(cy_thread_arg_t thread_input)
 {
     uint32_t status;
     int8_t tx_status;
-    uint16_t rx_cnt, rx_over_bound = 0;
+    uint16_t rx_cnt, rx_budget, rx_over_bound = 0;
     uint8_t bus_fail = 0;
     uint8_t error_type;
     int8_t rx_status;
+    uint32_t async_timeout_ms;
 
     whd_driver_t whd_driver = ( whd_driver_t )thread_input;
     whd_thread_info_t *thread_info = &whd_driver->thread_info;
@@ -363,17 +447,41 @@ static void whd_thread_func(cy_thread_arg_t thread_input)
     /* Interrupts may be enabled inside thread. To make sure none lost set flag now. */
     thread_info->whd_inited = WHD_TRUE;
 
+    /* Fill the RX buffer ring before the first read */
+    whd_bus_rx_ring_refill(whd_driver);
+
     while (thread_info->thread_quit_flag != WHD_TRUE)
     {
         rx_cnt = 0;
+        rx_budget = (thread_info->rx_budget_max != 0) ? thread_info->rx_budget : WHD_THREAD_RX_BOUND;
         /* Check if we were woken by interrupt */
         if ( (thread_info->bus_interrupt == WHD_TRUE) ||
              (whd_bus_use_status_report_scheme(whd_driver) ) )
         {
+            /* Counted here, a read-modify-write of the stats is not safe from the interrupt */
+            if ( (thread_info->bus_interrupt == WHD_TRUE) && !rx_over_bound )
+            {
+                WHD_STATS_INCREMENT_VARIABLE(whd_driver, rx_irq);
+            }
             thread_info->bus_interrupt = WHD_FALSE;
 
-            /* Check if the interrupt indicated there is a packet to read */
-            status = whd_bus_packet_available_to_read(whd_driver);
+            /* In polling mode, mask further interrupts until the device has been drained */
+            if ( (thread_info->rx_budget_max != 0) && (thread_info->rx_polling == WHD_FALSE) )
+            {
+                (void)whd_bus_irq_enable(whd_driver, WHD_FALSE);
+                thread_info->rx_polling = WHD_TRUE;
+            }
+
+            /* Check if the interrupt indicated there is a packet to read. A poll round that
+             * continues after using up its budget already knows there is. */
+            if ( (thread_info->rx_polling == WHD_TRUE) && rx_over_bound )
+            {
+                status = 0;
+            }
+            else
+            {
+                status = whd_bus_packet_available_to_read(whd_driver);
+            }
             if ( ( (status != 0) && (status != WHD_BUS_FAIL) ) || rx_over_bound )
             {
                 rx_over_bound = 0;
@@ -382,8 +490,14 @@ static void whd_thread_func(cy_thread_arg_t thread_input)
                 {
                     rx_status = whd_thread_receive_one_packet(whd_driver);
                     rx_cnt++;
-                } while (rx_status != 0 && rx_cnt < WHD_THREAD_RX_BOUND);
+                } while (rx_status != 0 && rx_cnt < rx_budget);
                 bus_fail = 0;
+
+                if (thread_info->rx_polling == WHD_TRUE)
+                {
+                    WHD_STATS_INCREMENT_VARIABLE(whd_driver, rx_poll);
+                    whd_thread_rx_budget_update(thread_info, rx_cnt, (rx_cnt >= rx_budget) ? WHD_TRUE : WHD_FALSE);
+                }
             }
             else
             {
@@ -401,13 +515,41 @@ static void whd_thread_func(cy_thread_arg_t thread_input)
             tx_status = whd_thread_send_one_packet(whd_driver);
         } while (tx_status != 0);
 
-        if (rx_cnt >= WHD_THREAD_RX_BOUND)
+        /* Credit the frames sent to the TX byte queue limits, resuming the network stack once drained.
+         * Done on every pass, sustained RX must not keep the senders held off. */
+        whd_sdpcm_tx_complete(whd_driver);
+
+        /* Time out asynchronous IOCTLs on every pass as well, and wake up again when the next one is due */
+        async_timeout_ms = whd_proto_poll_ioctl_async(whd_driver);
+        thread_info->max_sleep_ms = (async_timeout_ms != 0) ? async_timeout_ms : CY_RTOS_NEVER_TIMEOUT;
+
+        /* Replace the RX buffers consumed above, so the read path does not have to allocate */
+        whd_bus_rx_ring_refill(whd_driver);
+
+        if (rx_cnt >= rx_budget)
         {
+            WHD_STATS_INCREMENT_VARIABLE(whd_driver, rx_budget_exhausted);
             thread_info->bus_interrupt = WHD_TRUE;
             rx_over_bound = 1;
             continue;
         }
 
+        /* Drained, go back to interrupt driven RX */
+        if (thread_info->rx_polling == WHD_TRUE)
+        {
+            thread_info->rx_polling = WHD_FALSE;
+            (void)whd_bus_irq_enable(whd_driver, WHD_TRUE);
+
+            /* An edge triggered (OOB) interrupt raised while masked is lost, look once more before sleeping */
+            status = whd_bus_packet_available_to_read(whd_driver);
+            if ( (status != 0) && (status != WHD_BUS_FAIL) )
+            {
+                thread_info->bus_interrupt = WHD_TRUE;
+                rx_over_bound = 1;
+                continue;
+            }
+        }
+
         if (bus_fail > WHD_MAX_BUS_FAIL)
         {
             WPRINT_WHD_ERROR( ("%s: Error bus_fail over %d times\n", __FUNCTION__, WHD_MAX_BUS_FAIL) );
@@ -415,6 +557,10 @@ static void whd_thread_func(cy_thread_arg_t thread_input)
             whd_set_error_handler_locally(whd_driver, &error_type, NULL, NULL, NULL);
         }
 
+        /* The last frame sent may still be on the bus, release and credit it before sleeping */
+        (void)whd_bus_transfer_wait(whd_driver);
+        whd_sdpcm_tx_complete(whd_driver);
+
         /* Sleep till WLAN do something */
         whd_bus_wait_for_wlan_event(whd_driver, &thread_info->transceive_semaphore);
 
@@ -427,7 +573,14 @@ static void whd_thread_func(cy_thread_arg_t thread_input)
     /* Reset the quit flag */
     thread_info->thread_quit_flag = WHD_FALSE;
 
+    if (thread_info->rx_polling == WHD_TRUE)
+    {
+        thread_info->rx_polling = WHD_FALSE;
+        (void)whd_bus_irq_enable(whd_driver, WHD_TRUE);
+    }
+
     whd_sdpcm_quit(whd_driver);
+    whd_bus_rx_ring_flush(whd_driver);
 
     WPRINT_WHD_DATA_LOG( ("Stopped whd Thread\n") );
 
@@ -441,6 +594,7 @@ static void whd_thread_func (cy_thread_arg_t thread_input)
     int8_t tx_status;
     uint16_t rx_cnt, rx_over_bound = 0;
     uint16_t rx_ring_cnt = 0;
+    uint32_t async_timeout_ms;
 
     whd_driver_t whd_driver = ( whd_driver_t )thread_input;
     whd_thread_info_t *thread_info = &whd_driver->thread_info;
@@ -480,6 +634,10 @@ static void whd_thread_func (cy_thread_arg_t thread_input)
             tx_status = whd_thread_send_packets(whd_driver);
         } while (tx_status != 0);
 
+        /* Time out asynchronous IOCTLs on every pass, and wake up again when the next one is due */
+        async_timeout_ms = whd_proto_poll_ioctl_async(whd_driver);
+        thread_info->max_sleep_ms = (async_timeout_ms != 0) ? async_timeout_ms : CY_RTOS_NEVER_TIMEOUT;
+
         if (rx_cnt >= WHD_THREAD_RX_BOUND)
         {
             thread_info->bus_interrupt = WHD_TRUE;
@@ -1236,6 +1236,25 @@ uint8_t whd_ip4_to_string(const void *ip4addr, char *p)
     return outputPos;
 }
 
+uint32_t whd_crc32(uint32_t crc, const uint8_t *data, uint32_t len)
+{
+    /* One entry per nibble keeps the table small, resources are checked once per download */
+    static const uint32_t crc32_nibble[16] =
+    {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+
+    while (len-- != 0)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0x0F];
+        crc = (crc >> 4) ^ crc32_nibble[crc & 0x0F];
+    }
+
+    return crc;
+}
+
 #ifndef WHD_USE_CUSTOM_MALLOC_IMPL
 
 inline void whd_mem_memcpy (void *dest, const void *src, size_t len)
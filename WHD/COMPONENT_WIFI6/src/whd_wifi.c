@@ -108,6 +108,7 @@ whd_result_t whd_wifi_set_mac_address(whd_interface_t ifp, whd_mac_t mac)
         whd_mem_memcpy(data, &mac, sizeof(whd_mac_t) );
         CHECK_RETURN(whd_proto_set_iovar(ifp, buffer, NULL) );
     }
+    whd_iovar_cache_flush(whd_driver, WHD_IOVAR_CACHE_ADDRESS);
 
     return WHD_SUCCESS;
 }
@@ -1658,6 +1658,8 @@ static whd_result_t whd_wifi_active_join_init(whd_interface_t ifp, whd_security_
                                           uint8_t key_length, cy_semaphore_t *semaphore, whd_bool_t is_reassoc)
 {
     whd_driver_t whd_driver = ifp->whd_driver;
+    cy_time_t start;
+    cy_time_t now;
 
     if (whd_driver->internal_info.active_join_mutex_initted == WHD_FALSE)
     {
@@ -1673,7 +1675,11 @@ static whd_result_t whd_wifi_active_join_init(whd_interface_t ifp, whd_security_
 
     if (!is_reassoc)
     {
+        (void)cy_rtos_get_time(&start);
         CHECK_RETURN(whd_wifi_prepare_join(ifp, auth_type, security_key, key_length, semaphore) );
+        (void)cy_rtos_get_time(&now);
+        whd_driver->whd_stats.join_prepare_time = (uint32_t)(now - start);
+        WPRINT_WHD_DEBUG( ("Join prepared in %" PRIu32 " ms\n", whd_driver->whd_stats.join_prepare_time) );
     }
     return WHD_SUCCESS;
 }
@@ -1722,13 +1728,16 @@ static whd_result_t whd_wifi_prepare_join(whd_interface_t ifp, whd_security_t au
     uint32_t auth_mfp = WL_MFP_NONE;
     whd_result_t retval = WHD_SUCCESS;
     whd_result_t check_result = WHD_SUCCESS;
-    uint32_t *data;
     uint32_t *wpa_auth;
     uint32_t bss_index = 0;
     uint32_t auth;
     whd_driver_t whd_driver = ifp->whd_driver;
     uint16_t event_entry = 0xFF;
     uint32_t algos = 0, mask = 0;
+    whd_iovar_batch_t batch;
+    uint32_t bsscfg_data[2];
+    uint8_t optional_entry;
+    uint8_t entry;
 
     (void)bss_index;
     if ( (auth_type == WHD_SECURITY_WPA2_FBT_ENT) || (auth_type == WHD_SECURITY_IBSS_OPEN) )
@@ -1782,8 +1791,11 @@ static whd_result_t whd_wifi_prepare_join(whd_interface_t ifp, whd_security_t au
         CHECK_RETURN(whd_set_wsec_info_algos(ifp, algos, mask));
        }
     }
+    /* The settings up to the keys are independent of each other, send them without waiting for each one */
+    whd_iovar_batch_init(&batch, ifp);
+
     /* Enable Roaming in FW by default */
-    CHECK_RETURN(whd_wifi_set_iovar_value(ifp, IOVAR_STR_ROAM_OFF, 0) );
+    CHECK_RETURN(whd_iovar_batch_add_value(&batch, IOVAR_STR_ROAM_OFF, 0) );
 
     /* Map the interface to a BSS index */
     bss_index = ifp->bsscfgidx;
@@ -1792,43 +1804,44 @@ static whd_result_t whd_wifi_prepare_join(whd_interface_t ifp, whd_security_t au
     if(whd_driver->chip_info.chip_id == 43022)
     {
         /* Set the wpa auth */
-        data =
-            (uint32_t *)whd_proto_get_iovar_buffer(whd_driver, &buffer, (uint16_t)8, "bsscfg:" IOVAR_STR_WPA_AUTH);
-            CHECK_IOCTL_BUFFER(data);
-
-        data[0] = (int32_t)bss_index;
-        data[1] = ((auth_type == WHD_SECURITY_WPA_TKIP_PSK) ?
+        bsscfg_data[0] = (int32_t)bss_index;
+        bsscfg_data[1] = ((auth_type == WHD_SECURITY_WPA_TKIP_PSK) ?
                                (WPA_AUTH_PSK) : (WPA2_AUTH_PSK) );
-        CHECK_RETURN(whd_proto_set_iovar(ifp, buffer, 0) );
+        CHECK_RETURN(whd_iovar_batch_add(&batch, "bsscfg:" IOVAR_STR_WPA_AUTH, bsscfg_data,
+                                         (uint16_t)sizeof(bsscfg_data) ) );
 
         /* Set the wsec */
-        data =
-            (uint32_t *)whd_proto_get_iovar_buffer(whd_driver, &buffer, (uint16_t)8, "bsscfg:" IOVAR_STR_WSEC);
-            CHECK_IOCTL_BUFFER(data);
-
-        data[0] = (int32_t)bss_index;
-        data[1] = (auth_type & 0xFF);
-        CHECK_RETURN(whd_proto_set_iovar(ifp, buffer, 0) );
+        bsscfg_data[0] = (int32_t)bss_index;
+        bsscfg_data[1] = (auth_type & 0xFF);
+        CHECK_RETURN(whd_iovar_batch_add(&batch, "bsscfg:" IOVAR_STR_WSEC, bsscfg_data,
+                                         (uint16_t)sizeof(bsscfg_data) ) );
+        CHECK_RETURN(whd_iovar_batch_execute(&batch) );
 
         /* Set wowl bit for broadcast key rotation */
         CHECK_RETURN(whd_configure_wowl(ifp, WL_WOWL_KEYROT));
+        whd_iovar_batch_init(&batch, ifp);
     }
+    optional_entry = batch.count;
 
     /* Set supplicant variable - mfg app doesn't support these iovars, so don't care if return fails */
-    data = whd_proto_get_iovar_buffer(whd_driver, &buffer, (uint16_t)8, "bsscfg:" IOVAR_STR_SUP_WPA);
-    CHECK_IOCTL_BUFFER(data);
-    data[0] = htod32(bss_index);
-    data[1] =
+    bsscfg_data[0] = htod32(bss_index);
+    bsscfg_data[1] =
         htod32( ( uint32_t )( ( ( (auth_type & WPA_SECURITY) != 0 ) || ( (auth_type & WPA2_SECURITY) != 0 ) ||
                               ( (auth_type & WPA3_SECURITY) != 0 ) || ( (auth_type & WPA3_OWE) != 0 ) ) ? 1 : 0 ) );
-    (void)whd_proto_set_iovar(ifp, buffer, 0);
+    CHECK_RETURN(whd_iovar_batch_add(&batch, "bsscfg:" IOVAR_STR_SUP_WPA, bsscfg_data,
+                                     (uint16_t)sizeof(bsscfg_data) ) );
 
     /* Set the EAPOL version to whatever the AP is using (-1) */
-    data = whd_proto_get_iovar_buffer(whd_driver, &buffer, (uint16_t)8, "bsscfg:" IOVAR_STR_SUP_WPA2_EAPVER);
-    CHECK_IOCTL_BUFFER(data);
-    data[0] = htod32(bss_index);
-    data[1] = htod32( ( uint32_t )-1 );
-    (void)whd_proto_set_iovar(ifp, buffer, 0);
+    bsscfg_data[0] = htod32(bss_index);
+    bsscfg_data[1] = htod32( ( uint32_t )-1 );
+    CHECK_RETURN(whd_iovar_batch_add(&batch, "bsscfg:" IOVAR_STR_SUP_WPA2_EAPVER, bsscfg_data,
+                                     (uint16_t)sizeof(bsscfg_data) ) );
+
+    (void)whd_iovar_batch_execute(&batch);
+    for (entry = 0; entry < optional_entry; entry++)
+    {
+        CHECK_RETURN(batch.entries[entry].result);
+    }
 
     /* Send WPA Key */
     switch (auth_type)
@@ -3574,25 +3587,15 @@ whd_result_t  whd_wifi_deauth_sta(whd_interface_t ifp, whd_mac_t *mac, whd_dot11
 
 whd_result_t whd_wifi_get_mac_address(whd_interface_t ifp, whd_mac_t *mac)
 {
-    whd_buffer_t buffer;
-    whd_buffer_t response;
-    whd_driver_t whd_driver;
-
     CHECK_IFP_NULL(ifp);
 
     if (mac == NULL)
         return WHD_BADARG;
 
-    whd_driver = ifp->whd_driver;
-
-    CHECK_DRIVER_NULL(whd_driver);
-
-    CHECK_IOCTL_BUFFER(whd_proto_get_iovar_buffer(whd_driver, &buffer, sizeof(whd_mac_t), IOVAR_STR_CUR_ETHERADDR) );
-
-    CHECK_RETURN(whd_proto_get_iovar(ifp, buffer, &response) );
+    CHECK_DRIVER_NULL(ifp->whd_driver);
 
-    whd_mem_memcpy(mac, whd_buffer_get_current_piece_data_pointer(whd_driver, response), sizeof(whd_mac_t) );
-    CHECK_RETURN(whd_buffer_release(whd_driver, response, WHD_NETWORK_RX) );
+    CHECK_RETURN(whd_iovar_cache_get_iovar(ifp, WHD_IOVAR_CACHE_ADDRESS, IOVAR_STR_CUR_ETHERADDR, mac->octet,
+                                           sizeof(whd_mac_t) ) );
 
     return WHD_SUCCESS;
 }
@@ -5145,21 +5148,30 @@ whd_result_t whd_wifi_set_iovar_void(whd_interface_t ifp, const char *iovar)
     whd_buffer_t buffer;
     whd_driver_t whd_driver = ifp->whd_driver;
 
+    whd_result_t result;
+
     whd_proto_get_iovar_buffer(whd_driver, &buffer, (uint16_t)0, iovar);
 
-    return whd_proto_set_iovar(ifp, buffer, NULL);
+    result = whd_proto_set_iovar(ifp, buffer, NULL);
+    whd_iovar_cache_set_iovar(whd_driver, iovar);
+
+    return result;
 }
 
 whd_result_t whd_wifi_set_iovar_value(whd_interface_t ifp, const char *iovar, uint32_t value)
 {
     whd_buffer_t buffer;
     uint32_t *data;
+    whd_result_t result;
     whd_driver_t whd_driver = ifp->whd_driver;
 
     data = (uint32_t *)whd_proto_get_iovar_buffer(whd_driver, &buffer, (uint16_t)sizeof(value), iovar);
     CHECK_IOCTL_BUFFER(data);
     *data = htod32(value);
-    return whd_proto_set_iovar(ifp, buffer, NULL);
+    result = whd_proto_set_iovar(ifp, buffer, NULL);
+    whd_iovar_cache_set_iovar(whd_driver, iovar);
+
+    return result;
 }
 
 whd_result_t whd_wifi_get_iovar_value(whd_interface_t ifp, const char *iovar, uint32_t *value)
@@ -5281,6 +5293,244 @@ whd_result_t whd_wifi_get_iovar_buffer_with_param(whd_interface_t ifp, const cha
     return result;
 }
 
+whd_result_t whd_wifi_set_iovar_buffer_async(whd_interface_t ifp, const char *iovar_name, const void *in_buffer,
+                                             uint16_t in_buffer_length, uint32_t timeout_ms,
+                                             whd_ioctl_async_callback_t callback, void *user_data,
+                                             uint16_t *request)
+{
+    whd_buffer_t buffer;
+    uint8_t *data;
+    whd_result_t result;
+    whd_driver_t whd_driver;
+
+    CHECK_IFP_NULL(ifp);
+
+    if (!iovar_name || (!in_buffer && (in_buffer_length != 0) ) || !callback)
+    {
+        return WHD_BADARG;
+    }
+
+    whd_driver = ifp->whd_driver;
+
+    data = (uint8_t *)whd_proto_get_iovar_buffer(whd_driver, &buffer, in_buffer_length, iovar_name);
+    CHECK_IOCTL_BUFFER(data);
+    if (in_buffer_length != 0)
+    {
+        whd_mem_memcpy(data, in_buffer, in_buffer_length);
+    }
+
+    result = whd_proto_set_ioctl_async(ifp, (uint32_t)WLC_SET_VAR, buffer, timeout_ms, callback, user_data, request);
+    /* Once the SET is queued, a GET sent after it reads the new value */
+    whd_iovar_cache_set_iovar(whd_driver, iovar_name);
+
+    return result;
+}
+
+whd_result_t whd_wifi_get_iovar_buffer_async(whd_interface_t ifp, const char *iovar_name, const void *param,
+                                             uint16_t paramlen, uint16_t out_length, uint32_t timeout_ms,
+                                             whd_ioctl_async_callback_t callback, void *user_data,
+                                             uint16_t *request)
+{
+    whd_buffer_t buffer;
+    uint8_t *data;
+    whd_driver_t whd_driver;
+
+    CHECK_IFP_NULL(ifp);
+
+    if (!iovar_name || (!param && (paramlen != 0) ) || !callback)
+    {
+        return WHD_BADARG;
+    }
+
+    whd_driver = ifp->whd_driver;
+
+    /* The response is written over the request, make room for the larger of the two */
+    data = (uint8_t *)whd_proto_get_iovar_buffer(whd_driver, &buffer, (uint16_t)MAX_OF(paramlen, out_length),
+                                                 iovar_name);
+    CHECK_IOCTL_BUFFER(data);
+    if (paramlen != 0)
+    {
+        whd_mem_memcpy(data, param, paramlen);
+    }
+
+    return whd_proto_get_ioctl_async(ifp, (uint32_t)WLC_GET_VAR, buffer, timeout_ms, callback, user_data, request);
+}
+
+whd_result_t whd_wifi_cancel_iovar_async(whd_interface_t ifp, uint16_t request)
+{
+    CHECK_IFP_NULL(ifp);
+
+    return whd_proto_cancel_ioctl_async(ifp->whd_driver, request);
+}
+
+void whd_iovar_batch_init(whd_iovar_batch_t *batch, whd_interface_t ifp)
+{
+    batch->ifp = ifp;
+    batch->count = 0;
+}
+
+static whd_result_t whd_iovar_batch_add_entry(whd_iovar_batch_t *batch, uint32_t command, const char *iovar,
+                                              const void *data, uint16_t length)
+{
+    whd_iovar_batch_entry_t *entry;
+
+    if (batch->count >= WHD_IOVAR_BATCH_MAX_ENTRIES)
+    {
+        WPRINT_WHD_ERROR( ("%s: IOVAR batch is full\n", __FUNCTION__) );
+        return WHD_BADARG;
+    }
+    if ( (length > sizeof(entry->data) ) || ( (data == NULL) && (length != 0) ) )
+    {
+        return WHD_BADARG;
+    }
+
+    entry = &batch->entries[batch->count++];
+    entry->command = command;
+    entry->name = iovar;
+    entry->length = length;
+    entry->result = WHD_PENDING;
+    entry->done = NULL;
+    if (length != 0)
+    {
+        whd_mem_memcpy(entry->data, data, length);
+    }
+
+    return WHD_SUCCESS;
+}
+
+whd_result_t whd_iovar_batch_add(whd_iovar_batch_t *batch, const char *iovar, const void *data, uint16_t length)
+{
+    return whd_iovar_batch_add_entry(batch, (uint32_t)WLC_SET_VAR, iovar, data, length);
+}
+
+whd_result_t whd_iovar_batch_add_value(whd_iovar_batch_t *batch, const char *iovar, uint32_t value)
+{
+    value = htod32(value);
+    return whd_iovar_batch_add_entry(batch, (uint32_t)WLC_SET_VAR, iovar, &value, (uint16_t)sizeof(value) );
+}
+
+whd_result_t whd_iovar_batch_add_ioctl_value(whd_iovar_batch_t *batch, uint32_t ioctl, uint32_t value)
+{
+    value = htod32(value);
+    return whd_iovar_batch_add_entry(batch, ioctl, NULL, &value, (uint16_t)sizeof(value) );
+}
+
+static whd_result_t whd_iovar_batch_pack(whd_driver_t whd_driver, const whd_iovar_batch_entry_t *entry,
+                                         whd_buffer_t *buffer)
+{
+    void *data;
+
+    if (entry->name != NULL)
+    {
+        data = whd_proto_get_iovar_buffer(whd_driver, buffer, entry->length, entry->name);
+    }
+    else
+    {
+        data = whd_proto_get_ioctl_buffer(whd_driver, buffer, entry->length);
+    }
+    CHECK_IOCTL_BUFFER(data);
+    if (entry->length != 0)
+    {
+        whd_mem_memcpy(data, entry->data, entry->length);
+    }
+
+    return WHD_SUCCESS;
+}
+
+/* Called from the WHD thread with the response to a batch entry */
+static void whd_iovar_batch_response(whd_interface_t ifp, whd_result_t result, const uint8_t *data,
+                                     uint32_t data_length, void *user_data)
+{
+    whd_iovar_batch_entry_t *entry = (whd_iovar_batch_entry_t *)user_data;
+
+    UNUSED_PARAMETER(ifp);
+    UNUSED_PARAMETER(data);
+    UNUSED_PARAMETER(data_length);
+
+    entry->result = result;
+    (void)cy_rtos_set_semaphore(entry->done, WHD_FALSE);
+}
+
+whd_result_t whd_iovar_batch_execute(whd_iovar_batch_t *batch)
+{
+    whd_driver_t whd_driver = batch->ifp->whd_driver;
+    whd_iovar_batch_entry_t *entry;
+    whd_buffer_t buffer;
+    whd_result_t result = WHD_SUCCESS;
+    uint8_t outstanding = 0;
+    uint8_t i;
+    cy_time_t start;
+    cy_time_t now;
+
+    if (batch->count == 0)
+    {
+        return WHD_SUCCESS;
+    }
+
+    if (cy_rtos_init_semaphore(&batch->done, WHD_IOVAR_BATCH_MAX_ENTRIES, 0) != WHD_SUCCESS)
+    {
+        return WHD_SEMAPHORE_ERROR;
+    }
+
+    (void)cy_rtos_get_time(&start);
+
+    for (i = 0; i < batch->count; i++)
+    {
+        entry = &batch->entries[i];
+        entry->done = &batch->done;
+        entry->result = WHD_BUFFER_ALLOC_FAIL;
+
+        while (whd_iovar_batch_pack(whd_driver, entry, &buffer) == WHD_SUCCESS)
+        {
+            /* Once sent the response sets the result, it may do so before this returns */
+            result = whd_proto_set_ioctl_async(batch->ifp, entry->command, buffer, 0, whd_iovar_batch_response,
+                                               entry, NULL);
+            if (result == WHD_SUCCESS)
+            {
+                outstanding++;
+                break;
+            }
+            if (result != WHD_WLAN_BUSY)
+            {
+                entry->result = result;
+                break;
+            }
+            if (outstanding == 0)
+            {
+                /* Other callers hold every request slot, wait for one like any other IOCTL */
+                if (whd_iovar_batch_pack(whd_driver, entry, &buffer) == WHD_SUCCESS)
+                {
+                    entry->result = whd_proto_set_ioctl(batch->ifp, entry->command, buffer, NULL);
+                }
+                break;
+            }
+            /* The send buffer was released, send it again once an earlier entry has its response */
+            (void)cy_rtos_get_semaphore(&batch->done, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE);
+            outstanding--;
+        }
+    }
+
+    /* Every outstanding entry completes, with WHD_TIMEOUT at the latest */
+    for (; outstanding != 0; outstanding--)
+    {
+        (void)cy_rtos_get_semaphore(&batch->done, CY_RTOS_NEVER_TIMEOUT, WHD_FALSE);
+    }
+    (void)cy_rtos_deinit_semaphore(&batch->done);
+
+    (void)cy_rtos_get_time(&now);
+    WHD_STATS_INCREMENT_VARIABLE(whd_driver, iovar_batch);
+    WHD_STATS_ADD_VARIABLE(whd_driver, iovar_batch_entries, batch->count);
+    WPRINT_WHD_DEBUG( ("Sent %u IOVARs in %" PRIu32 " ms\n", (unsigned int)batch->count, (uint32_t)(now - start) ) );
+
+    result = WHD_SUCCESS;
+    for (i = 0; (i < batch->count) && (result == WHD_SUCCESS); i++)
+    {
+        result = batch->entries[i].result;
+    }
+
+    return result;
+}
+
 whd_result_t whd_wifi_set_iovar_buffers(whd_interface_t ifp, const char *iovar, const void **in_buffers,
                                     const uint16_t *lengths, const uint8_t num_buffers)
 {
@@ -5288,6 +5538,7 @@ whd_result_t whd_wifi_set_iovar_buffers(whd_interface_t ifp, const char *iovar,
     uint32_t *data;
     int tot_in_buffer_length = 0;
     uint8_t buffer_num = 0;
+    whd_result_t result;
     whd_driver_t whd_driver = ifp->whd_driver;
 
     /* get total length of all buffers: they will be copied into memory one after the other. */
@@ -5308,7 +5559,10 @@ whd_result_t whd_wifi_set_iovar_buffers(whd_interface_t ifp, const char *iovar,
     }
 
     /* send iovar */
-    return whd_proto_set_iovar(ifp, buffer, NULL);
+    result = whd_proto_set_iovar(ifp, buffer, NULL);
+    whd_iovar_cache_set_iovar(whd_driver, iovar);
+
+    return result;
 }
 
 whd_result_t whd_wifi_get_clm_version(whd_interface_t ifp, char *version, uint8_t length)
@@ -5322,7 +5576,7 @@ whd_result_t whd_wifi_get_clm_version(whd_interface_t ifp, char *version, uint8_
 
     version[0] = '\0';
 
-    result = whd_wifi_get_iovar_buffer(ifp, IOVAR_STR_CLMVER, (uint8_t *)version, length);
+    result = whd_iovar_cache_get_iovar(ifp, WHD_IOVAR_CACHE_FIRMWARE, IOVAR_STR_CLMVER, (uint8_t *)version, length);
     if ( (result == WHD_SUCCESS) && version[0] )
     {
         uint8_t version_length;
@@ -5357,7 +5611,7 @@ whd_result_t whd_wifi_get_wifi_version(whd_interface_t ifp, char *buf, uint8_t l
     if (buf == NULL)
         return WHD_BADARG;
 
-    result = whd_wifi_get_iovar_buffer(ifp, IOVAR_STR_VERSION, (uint8_t *)buf, length);
+    result = whd_iovar_cache_get_iovar(ifp, WHD_IOVAR_CACHE_FIRMWARE, IOVAR_STR_VERSION, (uint8_t *)buf, length);
 
     ver_len = strlen(buf);
 
@@ -7229,7 +7483,8 @@ whd_result_t whd_wifi_get_country_code(whd_interface_t ifp, char* country_abbrev
 
     memset(&cspec, 0, sizeof(wl_country_t));
 
-    CHECK_RETURN(whd_wifi_get_iovar_buffer(ifp, IOVAR_STR_COUNTRY, (uint8_t*)&cspec, sizeof(cspec)));
+    CHECK_RETURN(whd_iovar_cache_get_iovar(ifp, WHD_IOVAR_CACHE_COUNTRY, IOVAR_STR_COUNTRY, (uint8_t*)&cspec,
+                                           sizeof(cspec)));
 
     memcpy(country_abbrev, cspec.country_abbrev, sizeof(cspec.country_abbrev));
 
@@ -7267,7 +7522,9 @@ whd_result_t whd_wifi_get_country_list(whd_interface_t ifp, uint32_t band, uint3
     cl->band = htod32(cl->band);
     cl->count = htod32(cl->count);
 
-    CHECK_RETURN(whd_wifi_get_ioctl_buffer(ifp, WLC_GET_COUNTRY_LIST, buf, WLC_IOCTL_SMLEN));
+    /* The list comes from the CLM blob, only the band selects a different one */
+    CHECK_RETURN(whd_iovar_cache_get_ioctl(ifp, WHD_IOVAR_CACHE_FIRMWARE, WLC_GET_COUNTRY_LIST, band, buf,
+                                           WLC_IOCTL_SMLEN));
 
     memcpy((void*)country_list, (void*)&cl->country_abbrev[0], WLC_CNTRY_BUF_SZ * dtoh32(cl->count));
     *count = dtoh32(cl->count);
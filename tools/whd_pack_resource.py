@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+#
+# (c) 2026, Infineon Technologies AG, or an affiliate of Infineon
+# Technologies AG.  SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+"""Packs WLAN firmware and CLM images for WHD builds with WHD_COMPRESSED_RESOURCES.
+
+The packed image is the header described in src/include/whd_lz.h followed by
+LZ4 block format sequences. Match offsets are limited to the window, so the
+driver decodes with a window sized ring buffer instead of a full image copy.
+
+    whd_pack_resource.py pack 55572A1.clm_blob 55572A1.clm_blob.whz
+    whd_pack_resource.py unpack 55572A1.clm_blob.whz 55572A1.clm_blob
+
+Encrypted firmware (.trxse, .trxcse) does not compress and is better left unpacked.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"WHZ1"
+VERSION = 1
+HEADER = struct.Struct("<4sBBHII")
+WINDOW_LOG_MIN = 8
+WINDOW_LOG_MAX = 16
+MIN_MATCH = 4
+# As in LZ4, the last match starts at least 12 bytes before the end and the last 5 bytes are literals
+MFLIMIT = 12
+LAST_LITERALS = 5
+MAX_CHAIN = 64
+
+
+def _put_length(out, length):
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def _put_sequence(out, literals, match_len, offset):
+    lit_len = len(literals)
+    token = min(lit_len, 15) << 4
+    if match_len:
+        token |= min(match_len - MIN_MATCH, 15)
+    out.append(token)
+    if lit_len >= 15:
+        _put_length(out, lit_len - 15)
+    out += literals
+    if match_len:
+        out += struct.pack("<H", offset)
+        if match_len - MIN_MATCH >= 15:
+            _put_length(out, match_len - MIN_MATCH - 15)
+
+
+def compress(data, window):
+    """Greedy LZ4 block compression with hash chains, offsets kept below window."""
+    out = bytearray()
+    size = len(data)
+    head = {}
+    prev = [0] * size
+    anchor = 0
+    pos = 0
+    match_limit = size - MFLIMIT
+
+    def insert(i):
+        key = data[i:i + MIN_MATCH]
+        prev[i] = head.get(key, -1)
+        head[key] = i
+
+    while pos < match_limit:
+        key = data[pos:pos + MIN_MATCH]
+        best_len = 0
+        best_off = 0
+        cand = head.get(key, -1)
+        chain = 0
+        while cand >= 0 and pos - cand < window and chain < MAX_CHAIN:
+            length = MIN_MATCH
+            end = size - LAST_LITERALS
+            while pos + length < end and data[cand + length] == data[pos + length]:
+                length += 1
+            if length > best_len:
+                best_len = length
+                best_off = pos - cand
+            cand = prev[cand]
+            chain += 1
+        if best_len < MIN_MATCH:
+            insert(pos)
+            pos += 1
+            continue
+        _put_sequence(out, data[anchor:pos], best_len, best_off)
+        for i in range(pos, min(pos + best_len, match_limit)):
+            insert(i)
+        pos += best_len
+        anchor = pos
+
+    _put_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
+def decompress(packed, size, window):
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        token = packed[i]
+        i += 1
+        lit_len = token >> 4
+        if lit_len == 15:
+            while True:
+                byte = packed[i]
+                i += 1
+                lit_len += byte
+                if byte != 255:
+                    break
+        out += packed[i:i + lit_len]
+        i += lit_len
+        if len(out) >= size:
+            break
+        offset = packed[i] | (packed[i + 1] << 8)
+        i += 2
+        if offset == 0 or offset >= window or offset > len(out):
+            raise ValueError("bad match offset %d at %d" % (offset, len(out)))
+        match_len = (token & 0x0F) + MIN_MATCH
+        if token & 0x0F == 15:
+            while True:
+                byte = packed[i]
+                i += 1
+                match_len += byte
+                if byte != 255:
+                    break
+        for _ in range(match_len):
+            out.append(out[-offset])
+    if len(out) != size:
+        raise ValueError("unpacked %d bytes, expected %d" % (len(out), size))
+    return bytes(out)
+
+
+def pack(data, window_log):
+    window = 1 << window_log
+    packed = compress(data, window)
+    if decompress(packed, len(data), window) != data:
+        raise RuntimeError("round trip failed")
+    return HEADER.pack(MAGIC, VERSION, window_log, 0, len(data), len(packed)) + packed
+
+
+def unpack(image):
+    magic, version, window_log, _, size, packed_size = HEADER.unpack_from(image)
+    if magic != MAGIC or version != VERSION or not WINDOW_LOG_MIN <= window_log <= WINDOW_LOG_MAX:
+        raise ValueError("not a packed WHD resource")
+    return decompress(image[HEADER.size:HEADER.size + packed_size], size, 1 << window_log)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("command", choices=("pack", "unpack"))
+    parser.add_argument("input")
+    parser.add_argument("output")
+    parser.add_argument("--window-log", type=int, default=12,
+                        help="log2 of the decoder window, %d..%d (default 12, a 4 KB window)" %
+                        (WINDOW_LOG_MIN, WINDOW_LOG_MAX))
+    args = parser.parse_args()
+
+    if not WINDOW_LOG_MIN <= args.window_log <= WINDOW_LOG_MAX:
+        parser.error("--window-log must be in %d..%d" % (WINDOW_LOG_MIN, WINDOW_LOG_MAX))
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    result = pack(data, args.window_log) if args.command == "pack" else unpack(data)
+    if args.command == "pack" and len(result) >= len(data):
+        # Encrypted images (.trxse, .trxcse) do not compress
+        print("warning: %s does not compress, use it unpacked" % args.input, file=sys.stderr)
+    with open(args.output, "wb") as f:
+        f.write(result)
+    print("%s: %d -> %d bytes" % (args.output, len(data), len(result)), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())